@@ -69,7 +69,7 @@ _psim_autocode = rule(
 )
 
 
-def psim_autocoded_cc_library(name, deps = None, local_defines = None, visibility = None):
+def psim_autocoded_cc_library(name, deps = None, linkopts = None, local_defines = None, visibility = None):
     """Defines a PSim library with autocoded header files for models.
     """
     _include_dir = "include/psim/" + name
@@ -85,12 +85,13 @@ def psim_autocoded_cc_library(name, deps = None, local_defines = None, visibilit
     psim_cc_library(
         name,
         deps = deps + ["psim_" + name + "_autocoded"],
+        linkopts = linkopts,
         local_defines = local_defines,
         visibility = visibility
     )
 
 
-def psim_cc_library(name, deps = None, local_defines = None, visibility = None):
+def psim_cc_library(name, deps = None, linkopts = None, local_defines = None, visibility = None):
     """Defines a PSim library without autocoded header files for models.
     """
     _include_dir = "include/psim/" + name
@@ -105,6 +106,7 @@ def psim_cc_library(name, deps = None, local_defines = None, visibility = None):
         hdrs = native.glob([_include_dir + "/**/*.hpp"]),
         includes = ["include"],
         copts = ["-Isrc", "-fvisibility=hidden"],
+        linkopts = linkopts,
         linkstatic = True,
         deps = deps,
         local_defines = local_defines,
@@ -130,6 +132,26 @@ def psim_cc_test(name, deps = None, tags = None):
     )
 
 
+def psim_cc_benchmark(name, data = None, deps = None, linkopts = None, local_defines = None, tags = None):
+    """Defines a PSim CC benchmark.
+    """
+    _bench_dir = name
+
+    _cc_binary(
+        name = name,
+        srcs = native.glob([
+            _bench_dir + "/**/*.hpp", _bench_dir + "/**/*.inl",
+            _bench_dir + "/**/*.cpp",
+        ]),
+        data = native.glob([_bench_dir + "/**/*.txt"]) + (data or []),
+        deps = deps + ["@benchmark//:benchmark_main"],
+        linkopts = linkopts,
+        local_defines = local_defines,
+        tags = tags,
+        visibility = ["//visibility:public"],
+    )
+
+
 def psim_py_extension(name, srcs = None, hdrs = None, data = None, deps = None, local_defines = None, visibility = None):
     """Compiles a PSim Python extension written in C++.
 
@@ -0,0 +1,85 @@
+/** @file bench/core/model_list_benchmark.cpp
+ *  @author Kyle Krol
+ *
+ *  Compares stepping two independent models in series against stepping them
+ *  concurrently on a thread pool. The argument is the number of floating point
+ *  operations performed by each model per step.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <psim/core/model.hpp>
+#include <psim/core/model_list.hpp>
+#include <psim/core/state.hpp>
+#include <psim/core/state_field_valued.hpp>
+#include <psim/core/thread_pool.hpp>
+#include <psim/core/types.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <string>
+
+namespace {
+
+class Workload : public psim::Model {
+ private:
+  std::size_t const _n;
+  psim::StateFieldValued<psim::Real> _x;
+
+ public:
+  Workload(psim::RandomsGenerator &randoms, std::string const &name,
+      std::size_t n)
+    : Model(randoms), _n(n), _x(name, 0.0) {}
+
+  virtual void add_fields(psim::State &state) override {
+    state.add(&_x);
+  }
+
+  virtual void step() override {
+    this->psim::Model::step();
+
+    auto x = _x.get();
+    for (std::size_t i = 0; i < _n; i++)
+      x = std::sin(x) + 1.0;
+    _x.get() = x;
+  }
+};
+
+class Workloads : public psim::ModelList {
+ public:
+  Workloads(psim::RandomsGenerator &randoms, std::size_t n)
+    : ModelList(randoms) {
+    add<Workload>(randoms, "leader", n);
+    add<Workload>(randoms, "follower", n);
+  }
+};
+
+} // namespace
+
+static void BM_ModelListSeries(benchmark::State &state) {
+  psim::RandomsGenerator randoms;
+  psim::State fields;
+  Workloads model(randoms, state.range(0));
+  model.add_fields(fields);
+  model.get_fields(fields);
+
+  for (auto _ : state)
+    model.step();
+}
+
+static void BM_ModelListParallel(benchmark::State &state) {
+  psim::RandomsGenerator randoms;
+  psim::State fields;
+  Workloads model(randoms, state.range(0));
+  model.add_fields(fields);
+  model.get_fields(fields);
+
+  psim::ThreadPool pool(1);
+  model.parallelize(pool);
+
+  for (auto _ : state)
+    model.step();
+}
+
+BENCHMARK(BM_ModelListSeries)->RangeMultiplier(8)->Range(64, 32768);
+BENCHMARK(BM_ModelListParallel)->RangeMultiplier(8)->Range(64, 32768);
@@ -0,0 +1,99 @@
+/** @file bench/core/simulation_fork_benchmark.cpp
+ *  @author Kyle Krol
+ *
+ *  Compares forking a simulation into a newly constructed simulation against
+ *  forking into one that has already been built, and both against copying the
+ *  checkpointed state with a single memcpy. The argument is the number of
+ *  models in the simulation, each of which adds a single real field.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <psim/core/configuration.hpp>
+#include <psim/core/model.hpp>
+#include <psim/core/model_list.hpp>
+#include <psim/core/simulation.hpp>
+#include <psim/core/state.hpp>
+#include <psim/core/state_field_valued.hpp>
+#include <psim/core/types.hpp>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+class Integrator : public psim::Model {
+ private:
+  psim::StateFieldValued<psim::Real> _x;
+
+ public:
+  Integrator(psim::RandomsGenerator &randoms, std::string const &name)
+    : Model(randoms), _x(name, 0.0) {}
+
+  virtual void add_fields(psim::State &state) override {
+    state.add(&_x);
+  }
+
+  virtual void step() override {
+    this->psim::Model::step();
+    _x.get() += 1.0;
+  }
+};
+
+class Integrators : public psim::ModelList {
+ public:
+  Integrators(psim::RandomsGenerator &randoms,
+      psim::Configuration const &config)
+    : ModelList(randoms) {
+    auto const n = config["models"].get<psim::Integer>();
+    for (psim::Integer i = 0; i < n; i++)
+      add<Integrator>(randoms, "x" + std::to_string(i));
+  }
+};
+
+psim::Configuration config(benchmark::State const &state) {
+  psim::Configuration config;
+  config.set<psim::Integer>("seed", 0);
+  config.set<psim::Integer>("models", state.range(0));
+  return config;
+}
+
+} // namespace
+
+static void BM_SimulationForkConfiguration(benchmark::State &state) {
+  auto const config = ::config(state);
+  psim::Simulation<Integrators> simulation(config);
+  simulation.step(10);
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(simulation.fork(config));
+}
+
+static void BM_SimulationForkTwin(benchmark::State &state) {
+  auto const config = ::config(state);
+  psim::Simulation<Integrators> simulation(config);
+  psim::Simulation<Integrators> twin(config);
+  simulation.step(10);
+
+  for (auto _ : state)
+    simulation.fork(twin);
+}
+
+static void BM_SimulationForkMemcpy(benchmark::State &state) {
+  auto const config = ::config(state);
+  psim::Simulation<Integrators> simulation(config);
+  simulation.step(10);
+
+  auto const size = simulation.checkpoint().size();
+  std::vector<char> source(size), destination(size);
+
+  for (auto _ : state) {
+    std::memcpy(destination.data(), source.data(), size);
+    benchmark::ClobberMemory();
+  }
+}
+
+BENCHMARK(BM_SimulationForkConfiguration)->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK(BM_SimulationForkTwin)->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK(BM_SimulationForkMemcpy)->RangeMultiplier(8)->Range(8, 4096);
@@ -0,0 +1,76 @@
+/** @file bench/core/state_field_lazy_benchmark.cpp
+ *  @author Kyle Krol
+ *
+ *  Compares evaluating lazy fields through a `std::function` against the
+ *  autocoded member function evaluator. The epoch is advanced on every
+ *  iteration so each read requires an evaluation.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <psim/core/state_field.hpp>
+#include <psim/core/state_field_lazy.hpp>
+#include <psim/core/state_field_lazy_member.hpp>
+#include <psim/core/types.hpp>
+
+#include <cstddef>
+#include <functional>
+
+namespace {
+
+struct Model {
+  psim::Real value = 1.0;
+
+  psim::Real doubled() const {
+    return 2.0 * value;
+  }
+};
+
+struct ModelEvaluator {
+  psim::Real operator()(Model const &model) const {
+    return model.doubled();
+  }
+};
+
+} // namespace
+
+static void BM_StateFieldLazy(benchmark::State &state) {
+  std::size_t epoch = 0;
+  Model model;
+  psim::StateFieldLazy<psim::Real> field(
+      "field", std::bind(&Model::doubled, &model), &epoch);
+
+  for (auto _ : state) {
+    epoch++;
+    benchmark::DoNotOptimize(field.get());
+  }
+}
+
+static void BM_StateFieldLazyMember(benchmark::State &state) {
+  std::size_t epoch = 0;
+  Model model;
+  psim::StateFieldLazyMember<psim::Real, Model, ModelEvaluator> field(
+      "field", model, epoch);
+
+  for (auto _ : state) {
+    epoch++;
+    benchmark::DoNotOptimize(field.get());
+  }
+}
+
+static void BM_StateFieldLazyMemberVirtual(benchmark::State &state) {
+  std::size_t epoch = 0;
+  Model model;
+  psim::StateFieldLazyMember<psim::Real, Model, ModelEvaluator> field(
+      "field", model, epoch);
+  psim::StateField<psim::Real> const &base = field;
+
+  for (auto _ : state) {
+    epoch++;
+    benchmark::DoNotOptimize(base.get());
+  }
+}
+
+BENCHMARK(BM_StateFieldLazy);
+BENCHMARK(BM_StateFieldLazyMember);
+BENCHMARK(BM_StateFieldLazyMemberVirtual);
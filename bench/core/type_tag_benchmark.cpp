@@ -0,0 +1,103 @@
+/** @file bench/core/type_tag_benchmark.cpp
+ *  @author Kyle Krol
+ *
+ *  Compares looking up the underlying type of state fields and parameters with
+ *  a chain of dynamic casts, as the Python bindings used to, against a single
+ *  switch over the type tag.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <psim/core/parameter.hpp>
+#include <psim/core/state_field.hpp>
+#include <psim/core/state_field_valued.hpp>
+#include <psim/core/types.hpp>
+
+template <template <typename> class D, class B>
+static void const *lookup_dynamic_cast(B const &base) {
+  {
+    auto const *ptr = dynamic_cast<D<psim::Vector3> const *>(&base);
+    if (ptr) return &ptr->get();
+  }
+  {
+    auto const *ptr = dynamic_cast<D<psim::Vector4> const *>(&base);
+    if (ptr) return &ptr->get();
+  }
+  {
+    auto const *ptr = dynamic_cast<D<psim::Real> const *>(&base);
+    if (ptr) return &ptr->get();
+  }
+  {
+    auto const *ptr = dynamic_cast<D<psim::Boolean> const *>(&base);
+    if (ptr) return &ptr->get();
+  }
+  {
+    auto const *ptr = dynamic_cast<D<psim::Integer> const *>(&base);
+    if (ptr) return &ptr->get();
+  }
+  {
+    auto const *ptr = dynamic_cast<D<psim::Vector2> const *>(&base);
+    if (ptr) return &ptr->get();
+  }
+  return nullptr;
+}
+
+template <class B>
+static void const *lookup_type_tag(B const &base) {
+  switch (base.tag()) {
+    case psim::TypeTag::Boolean: return &base.template get<psim::Boolean>();
+    case psim::TypeTag::Integer: return &base.template get<psim::Integer>();
+    case psim::TypeTag::Real:    return &base.template get<psim::Real>();
+    case psim::TypeTag::Vector2: return &base.template get<psim::Vector2>();
+    case psim::TypeTag::Vector3: return &base.template get<psim::Vector3>();
+    case psim::TypeTag::Vector4: return &base.template get<psim::Vector4>();
+    default:                     return nullptr;
+  }
+}
+
+template <typename T>
+static void BM_StateFieldDynamicCast(benchmark::State &state) {
+  psim::StateFieldValued<T> field("field");
+  psim::StateFieldBase const &base = field;
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(lookup_dynamic_cast<psim::StateField>(base));
+}
+
+template <typename T>
+static void BM_StateFieldTypeTag(benchmark::State &state) {
+  psim::StateFieldValued<T> field("field");
+  psim::StateFieldBase const &base = field;
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(lookup_type_tag(base));
+}
+
+template <typename T>
+static void BM_ParameterDynamicCast(benchmark::State &state) {
+  psim::Parameter<T> param("param");
+  psim::ParameterBase const &base = param;
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(lookup_dynamic_cast<psim::Parameter>(base));
+}
+
+template <typename T>
+static void BM_ParameterTypeTag(benchmark::State &state) {
+  psim::Parameter<T> param("param");
+  psim::ParameterBase const &base = param;
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(lookup_type_tag(base));
+}
+
+// Vector3 is the first type tried by the dynamic cast chain and Vector2 is the
+// last; together they bound the old per-access cost.
+BENCHMARK_TEMPLATE(BM_StateFieldDynamicCast, psim::Vector3);
+BENCHMARK_TEMPLATE(BM_StateFieldDynamicCast, psim::Vector2);
+BENCHMARK_TEMPLATE(BM_StateFieldTypeTag, psim::Vector3);
+BENCHMARK_TEMPLATE(BM_StateFieldTypeTag, psim::Vector2);
+BENCHMARK_TEMPLATE(BM_ParameterDynamicCast, psim::Vector3);
+BENCHMARK_TEMPLATE(BM_ParameterDynamicCast, psim::Vector2);
+BENCHMARK_TEMPLATE(BM_ParameterTypeTag, psim::Vector3);
+BENCHMARK_TEMPLATE(BM_ParameterTypeTag, psim::Vector2);
@@ -0,0 +1,276 @@
+/** @file bench/gnc/gnc_benchmark.cpp
+ *  @author Kyle Krol
+ *
+ *  Measures the cost of the GNC kernels PSim spends most of its step time in.
+ *  Each iteration is a single call so the reported time is per call. Float and
+ *  double variants are benchmarked where both exist. On Linux, the number of
+ *  libm transcendental calls made per call is reported as counters as well.
+ */
+
+#include "transcendentals.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <gnc/attitude_estimator.hpp>
+#include <gnc/constants.hpp>
+#include <gnc/environment.hpp>
+#include <gnc/orbit_controller.hpp>
+#include <gnc/relative_orbit_estimate.hpp>
+#include <gnc/utilities.hpp>
+#include <orb/GroundPropagator.h>
+#include <orb/Orbit.h>
+
+#include <lin/core.hpp>
+#include <lin/generators.hpp>
+#include <lin/math.hpp>
+#include <lin/references.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+/** @brief Earth's angular rate in ECEF (rad/s).
+ */
+lin::Vector3d const earth_w = {0.0, 0.0, 7.2921150e-5};
+
+/** @brief Timestep used by iterative kernels (ns).
+ */
+constexpr std::int32_t dt_ns = 100'000'000;
+
+/** @brief Radius of the circular reference orbit (m).
+ */
+constexpr double radius = 6.8538e6;
+
+/** @brief Number of distinct inputs cycled through by the environment kernels.
+ */
+constexpr std::size_t samples = 256;
+
+/** @brief Time since the PAN epoch the kernels are evaluated at (s).
+ */
+constexpr double t0 = 0.0;
+
+/** @return GPS time of the PAN epoch (ns).
+ */
+std::int64_t gps_epoch_ns() {
+  return std::int64_t(gnc::constant::init_gps_week_number) *
+         gnc::constant::NANOSECONDS_IN_WEEK;
+}
+
+/** @return Position in ECEF along an inclined circular orbit.
+ */
+lin::Vector3d position(double theta) {
+  return {radius * std::cos(theta), radius * std::sin(theta) / std::sqrt(2.0),
+      radius * std::sin(theta) / std::sqrt(2.0)};
+}
+
+/** @return Velocity in ECEF along the inclined circular orbit.
+ */
+lin::Vector3d velocity(double theta) {
+  double const v = std::sqrt(3.986004418e14 / radius);
+  lin::Vector3d const r = position(theta);
+  lin::Vector3d const v_eci = {-v * std::sin(theta),
+      v * std::cos(theta) / std::sqrt(2.0),
+      v * std::cos(theta) / std::sqrt(2.0)};
+  return (v_eci - lin::cross(earth_w, r)).eval();
+}
+
+/** @return Positions evenly spaced around the reference orbit.
+ */
+std::vector<lin::Vector3d> positions() {
+  std::vector<lin::Vector3d> r(samples);
+  for (std::size_t i = 0; i < samples; i++)
+    r[i] = position(6.283185307179586 * i / samples);
+  return r;
+}
+
+/** @return Orbit at the PAN epoch on the reference orbit.
+ */
+orb::Orbit reference_orbit() {
+  return orb::Orbit(gps_epoch_ns(), position(0.0), velocity(0.0));
+}
+
+/** @return Relative orbit estimate of a satellite ten meters away.
+ */
+gnc::RelativeOrbitEstimate relative_orbit_estimate() {
+  lin::Matrixd<6, 6> S = lin::zeros<lin::Matrixd<6, 6>>();
+  for (lin::size_t i = 0; i < 3; i++) {
+    S(i, i) = 1.0e-2;
+    S(i + 3, i + 3) = 1.0e-1;
+  }
+  return gnc::RelativeOrbitEstimate(earth_w, position(0.0), velocity(0.0),
+      {10.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, S);
+}
+
+} // namespace
+
+template <typename T>
+static void BM_Gravity(benchmark::State &state) {
+  auto const r = positions();
+  lin::Vector<T, 3> g;
+  T U;
+
+  std::size_t i = 0;
+  transcendentals::reset();
+  for (auto _ : state) {
+    gnc::env::gravity(r[i++ % samples], g, U);
+    benchmark::DoNotOptimize(g);
+    benchmark::DoNotOptimize(U);
+  }
+  transcendentals::report(state);
+}
+BENCHMARK_TEMPLATE(BM_Gravity, float);
+BENCHMARK_TEMPLATE(BM_Gravity, double);
+
+template <typename T>
+static void BM_MagneticField(benchmark::State &state) {
+  auto const r = positions();
+  lin::Vector<T, 3> b;
+
+  std::size_t i = 0;
+  transcendentals::reset();
+  for (auto _ : state) {
+    gnc::env::magnetic_field(t0 + 0.1 * (i % samples), r[i % samples], b);
+    benchmark::DoNotOptimize(b);
+    i++;
+  }
+  transcendentals::report(state);
+}
+BENCHMARK_TEMPLATE(BM_MagneticField, float);
+BENCHMARK_TEMPLATE(BM_MagneticField, double);
+
+static void BM_AttitudeEstimatorUpdate(benchmark::State &state) {
+  // Noise free measurements consistent with an identity attitude
+  lin::Vector3d const r_ecef = position(0.0);
+  lin::Vector4d q_ecef_eci, q_eci_ecef;
+  lin::Vector3d b, s;
+  gnc::env::earth_attitude(t0, q_ecef_eci);
+  gnc::utl::quat_conj(q_ecef_eci, q_eci_ecef);
+  gnc::env::magnetic_field(t0, r_ecef, b);
+  gnc::utl::rotate_frame(q_eci_ecef, b);
+  gnc::env::sun_vector(t0, s);
+
+  gnc::AttitudeEstimatorState estimator;
+  gnc::AttitudeEstimatorData data;
+  gnc::AttitudeEstimate estimate;
+  gnc::attitude_estimator_reset(estimator, t0, {0.0f, 0.0f, 0.0f, 1.0f});
+  data.r_ecef = r_ecef;
+  data.b_body = lin::Vector3f(b);
+  data.s_body = lin::Vector3f(s);
+  data.w_body = lin::zeros<lin::Vector3f>();
+  data.t = t0;
+
+  transcendentals::reset();
+  for (auto _ : state) {
+    data.t += 1.0e-9 * dt_ns;
+    gnc::attitude_estimator_update(estimator, data, estimate);
+    benchmark::DoNotOptimize(estimate);
+  }
+  transcendentals::report(state);
+
+  if (!estimator.is_valid)
+    state.SkipWithError("Attitude estimate became invalid");
+}
+BENCHMARK(BM_AttitudeEstimatorUpdate);
+
+static void BM_RelativeOrbitEstimatePredict(benchmark::State &state) {
+  auto const r_ecef = position(0.0);
+  auto const v_ecef = velocity(0.0);
+  auto const sqrtQ = lin::diag(lin::Vectord<6>(
+      {1.0e-8, 1.0e-8, 1.0e-8, 1.0e-4, 1.0e-4, 1.0e-2})).eval();
+  auto estimate = relative_orbit_estimate();
+
+  transcendentals::reset();
+  for (auto _ : state) {
+    estimate.update(dt_ns, earth_w, r_ecef, v_ecef, sqrtQ);
+    benchmark::ClobberMemory();
+  }
+  transcendentals::report(state);
+
+  if (!estimate.valid())
+    state.SkipWithError("Relative orbit estimate became invalid");
+}
+BENCHMARK(BM_RelativeOrbitEstimatePredict);
+
+static void BM_RelativeOrbitEstimateUpdate(benchmark::State &state) {
+  auto const r_ecef = position(0.0);
+  auto const v_ecef = velocity(0.0);
+  lin::Vector3d const dr_ecef = {10.0, 0.0, 0.0};
+  auto const sqrtQ = lin::diag(lin::Vectord<6>(
+      {1.0e-8, 1.0e-8, 1.0e-8, 1.0e-4, 1.0e-4, 1.0e-2})).eval();
+  auto const sqrtR = lin::diag(lin::consts<lin::Vectord<3>>(1.0e-2)).eval();
+  auto estimate = relative_orbit_estimate();
+
+  transcendentals::reset();
+  for (auto _ : state) {
+    estimate.update(dt_ns, earth_w, r_ecef, v_ecef, dr_ecef, sqrtQ, sqrtR);
+    benchmark::ClobberMemory();
+  }
+  transcendentals::report(state);
+
+  if (!estimate.valid())
+    state.SkipWithError("Relative orbit estimate became invalid");
+}
+BENCHMARK(BM_RelativeOrbitEstimateUpdate);
+
+/* Uses the degree 40 `orb::PANGRAVITYMODEL` gravity model.
+ */
+static void BM_OrbitShortUpdate(benchmark::State &state) {
+  auto orbit = reference_orbit();
+  double energy;
+
+  transcendentals::reset();
+  for (auto _ : state) {
+    orbit.shortupdate(dt_ns, earth_w, energy);
+    benchmark::DoNotOptimize(energy);
+  }
+  transcendentals::report(state);
+
+  if (!orbit.valid())
+    state.SkipWithError("Orbit became invalid");
+}
+BENCHMARK(BM_OrbitShortUpdate);
+
+/* The propagator is handed a new orbit ten minutes behind whenever it catches
+ * up. This costs no gravity calls and is amortized over many iterations.
+ */
+static void BM_GroundPropagatorOneGravCall(benchmark::State &state) {
+  auto const orbit = reference_orbit();
+  auto const lag_ns = 600 * std::int64_t(1'000'000'000);
+  orb::GroundPropagator propagator;
+
+  transcendentals::reset();
+  for (auto _ : state) {
+    if (!propagator.total_num_grav_calls_left())
+      propagator.input(orbit, orbit.nsgpstime() + lag_ns, earth_w);
+    propagator.one_grav_call();
+    benchmark::ClobberMemory();
+  }
+  transcendentals::report(state);
+}
+BENCHMARK(BM_GroundPropagatorOneGravCall);
+
+static void BM_ControlOrbit(benchmark::State &state) {
+  gnc::OrbitControllerState controller;
+  gnc::OrbitControllerData data;
+  gnc::OrbitActuation actuation;
+  data.t = 0;
+  data.r_ecef = position(0.0);
+  data.v_ecef = velocity(0.0);
+  data.dr_ecef = {10.0, 0.0, 0.0};
+  data.dv_ecef = {0.0, 0.01, 0.0};
+  data.p = gnc::constant::K_p;
+  data.d = gnc::constant::K_d;
+  data.energy_gain = gnc::constant::K_e;
+  data.h_gain = gnc::constant::K_h;
+
+  transcendentals::reset();
+  for (auto _ : state) {
+    gnc::control_orbit(controller, data, actuation);
+    benchmark::DoNotOptimize(actuation);
+  }
+  transcendentals::report(state);
+}
+BENCHMARK(BM_ControlOrbit);
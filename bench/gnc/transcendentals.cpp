@@ -0,0 +1,85 @@
+/** @file bench/gnc/transcendentals.cpp
+ *  @author Kyle Krol
+ */
+
+#include "transcendentals.hpp"
+
+#include <cstdint>
+
+#define TRANSCENDENTALS(X) \
+  X(sin) X(sinf) X(cos) X(cosf) X(sincos) X(sincosf) X(tan) X(tanf) \
+  X(asin) X(asinf) X(acos) X(acosf) X(atan) X(atanf) X(atan2) X(atan2f) \
+  X(exp) X(expf) X(log) X(logf) X(pow) X(powf)
+
+namespace {
+
+/* Call counts for each wrapped function. Benchmarks are run on a single thread
+ * so plain integers suffice.
+ */
+struct Counts {
+#define X(f) std::uint64_t f = 0;
+  TRANSCENDENTALS(X)
+#undef X
+} counts;
+
+} // namespace
+
+#ifdef PSIM_BENCH_TRANSCENDENTALS
+
+#define WRAP_UNARY(f, T) \
+  T __real_##f(T); \
+  T __wrap_##f(T x) { counts.f++; return __real_##f(x); }
+
+#define WRAP_BINARY(f, T) \
+  T __real_##f(T, T); \
+  T __wrap_##f(T x, T y) { counts.f++; return __real_##f(x, y); }
+
+#define WRAP_SINCOS(f, T) \
+  void __real_##f(T, T *, T *); \
+  void __wrap_##f(T x, T *s, T *c) { counts.f++; __real_##f(x, s, c); }
+
+extern "C" {
+
+WRAP_UNARY(sin, double)
+WRAP_UNARY(sinf, float)
+WRAP_UNARY(cos, double)
+WRAP_UNARY(cosf, float)
+WRAP_SINCOS(sincos, double)
+WRAP_SINCOS(sincosf, float)
+WRAP_UNARY(tan, double)
+WRAP_UNARY(tanf, float)
+WRAP_UNARY(asin, double)
+WRAP_UNARY(asinf, float)
+WRAP_UNARY(acos, double)
+WRAP_UNARY(acosf, float)
+WRAP_UNARY(atan, double)
+WRAP_UNARY(atanf, float)
+WRAP_BINARY(atan2, double)
+WRAP_BINARY(atan2f, float)
+WRAP_UNARY(exp, double)
+WRAP_UNARY(expf, float)
+WRAP_UNARY(log, double)
+WRAP_UNARY(logf, float)
+WRAP_BINARY(pow, double)
+WRAP_BINARY(powf, float)
+
+} // extern "C"
+
+#endif
+
+namespace transcendentals {
+
+void reset() {
+  counts = Counts();
+}
+
+void report(benchmark::State &state) {
+#define X(f) \
+  if (counts.f) \
+    state.counters[#f] = benchmark::Counter( \
+        static_cast<double>(counts.f), benchmark::Counter::kAvgIterations);
+  TRANSCENDENTALS(X)
+#undef X
+}
+
+} // namespace transcendentals
@@ -0,0 +1,34 @@
+/** @file bench/gnc/transcendentals.hpp
+ *  @author Kyle Krol
+ *
+ *  Counts calls into libm's transcendental functions made by the GNC kernels.
+ *  On Linux the benchmark is linked with `-Wl,--wrap=<function>` for every
+ *  function listed in `bench/BUILD.bazel` which routes calls from our object
+ *  files through a counting shim. Calls made from within libm itself and
+ *  functions the compiler lowers to instructions (i.e. `sqrt` and `fabs`) are
+ *  not counted. On other platforms no counters are reported.
+ */
+
+#ifndef BENCH_GNC_TRANSCENDENTALS_HPP_
+#define BENCH_GNC_TRANSCENDENTALS_HPP_
+
+#include <benchmark/benchmark.h>
+
+namespace transcendentals {
+
+/** @brief Zeros all call counts.
+ *
+ *  Should be called immediately before a benchmark's timed loop.
+ */
+void reset();
+
+/** @brief Reports the number of calls made per iteration to each function
+ *         that was called at least once since the last reset.
+ *
+ *  @param[inout] state Benchmark state the counters are added to.
+ */
+void report(benchmark::State &state);
+
+} // namespace transcendentals
+
+#endif
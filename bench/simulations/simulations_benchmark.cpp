@@ -0,0 +1,90 @@
+/** @file bench/simulations/simulations_benchmark.cpp
+ *  @author Kyle Krol
+ *
+ *  Measures the end to end step throughput of every simulation exposed to
+ *  Python using the committed parameter files. Each iteration is a single step
+ *  so the reported time is per step and items per second is steps per second.
+ *  Pass `--benchmark_format=json` for machine readable output.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <psim/core/configuration.hpp>
+#include <psim/core/simulation.hpp>
+#include <psim/simulations/attitude_estimator_test.hpp>
+#include <psim/simulations/detumbler_test.hpp>
+#include <psim/simulations/dual_attitude_orbit.hpp>
+#include <psim/simulations/dual_orbit.hpp>
+#include <psim/simulations/orbit_controller_test.hpp>
+#include <psim/simulations/orbit_estimator_test.hpp>
+#include <psim/simulations/relative_orbit_estimator_test.hpp>
+#include <psim/simulations/single_attitude_orbit.hpp>
+#include <psim/simulations/single_orbit.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace {
+
+/** @brief Number of steps in roughly one orbit with the base step size.
+ */
+constexpr std::size_t orbit = 33600;
+
+template <class C>
+void BM_Simulation(benchmark::State &state, std::string const &scenario) {
+  std::vector<std::string> files;
+  for (auto const *file : {"sensors/base", "truth/base", "fc/base"})
+    files.push_back("config/parameters/" + std::string(file) + ".txt");
+  files.push_back("config/parameters/truth/" + scenario + ".txt");
+
+  psim::Configuration const config(files);
+  psim::Simulation<C> sim(config);
+
+  for (auto _ : state)
+    sim.step();
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+/** @brief Registers a simulation benchmark.
+ *
+ *  @param[in] name     Simulation name.
+ *  @param[in] scenario Initial conditions from `config/parameters/truth`.
+ *  @param[in] window   Fixed number of steps to run (zero lets the library
+ *                      decide).
+ */
+template <class C>
+void simulation(std::string const &name, std::string const &scenario,
+    std::size_t window = 0) {
+  auto *benchmark = benchmark::RegisterBenchmark(
+      ("BM_" + name + "/" + scenario).c_str(),
+      [scenario](benchmark::State &state) {
+        BM_Simulation<C>(state, scenario);
+      });
+  if (window)
+    benchmark->Iterations(window);
+}
+
+int const registered = []() {
+  simulation<psim::AttitudeEstimatorTestGnc>(
+      "AttitudeEstimatorTestGnc", "standby");
+  simulation<psim::DetumblerTest>("DetumblerTest", "detumble");
+  simulation<psim::SingleAttitudeOrbitGnc>("SingleAttitudeOrbitGnc", "standby");
+  simulation<psim::SingleOrbitGnc>("SingleOrbitGnc", "standby");
+  simulation<psim::OrbOrbitEstimatorTest>("OrbOrbitEstimatorTest", "standby");
+  simulation<psim::RelativeOrbitEstimatorTest>(
+      "RelativeOrbitEstimatorTest", "near_field");
+  simulation<psim::DualAttitudeOrbitGnc>("DualAttitudeOrbitGnc", "standby");
+  simulation<psim::DualOrbitGnc>("DualOrbitGnc", "standby");
+
+  // The 30 day rendezvous is truncated to the first two orbits after standby,
+  // which include the first controller firings, and one orbit of the final
+  // close approach.
+  simulation<psim::OrbitControllerTest>(
+      "OrbitControllerTest", "standby", 2 * orbit);
+  simulation<psim::OrbitControllerTest>(
+      "OrbitControllerTest", "near_field", orbit);
+  return 0;
+}();
+} // namespace
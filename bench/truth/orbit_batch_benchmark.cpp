@@ -0,0 +1,119 @@
+/** @file bench/truth/orbit_batch_benchmark.cpp
+ *  @author Kyle Krol
+ *
+ *  Measures the throughput of the batched orbit propagator stepping in series
+ *  and on a thread pool against a simulation with one `OrbitEcef` model per
+ *  satellite. The argument is the number of satellites.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <psim/core/configuration.hpp>
+#include <psim/core/model.hpp>
+#include <psim/core/model_list.hpp>
+#include <psim/core/simulation.hpp>
+#include <psim/core/state.hpp>
+#include <psim/core/state_field_valued.hpp>
+#include <psim/core/thread_pool.hpp>
+#include <psim/core/types.hpp>
+#include <psim/truth/orbit.hpp>
+#include <psim/truth/orbit_batch.hpp>
+
+#include <cstddef>
+#include <string>
+#include <thread>
+
+namespace {
+
+psim::Vector3 const earth_w = {0.0, 0.0, 7.2921150e-5};
+psim::Vector3 const earth_w_dot = {0.0, 0.0, 0.0};
+
+/* Provides the Earth and timestep fields read by the orbit propagators.
+ */
+class Environment : public psim::Model {
+ private:
+  psim::StateFieldValued<psim::Vector3> _w, _w_dot;
+  psim::StateFieldValued<psim::Real> _dt;
+
+ public:
+  Environment(psim::RandomsGenerator &randoms)
+    : Model(randoms), _w("truth.earth.w", earth_w),
+      _w_dot("truth.earth.w_dot", earth_w_dot), _dt("truth.dt.s", 0.1) {}
+
+  virtual void add_fields(psim::State &state) override {
+    state.add(&_w);
+    state.add(&_w_dot);
+    state.add(&_dt);
+  }
+};
+
+class Propagators : public psim::ModelList {
+ public:
+  Propagators(psim::RandomsGenerator &randoms,
+      psim::Configuration const &config)
+    : ModelList(randoms) {
+    add<Environment>(randoms);
+
+    auto const n = config["satellites"].get<psim::Integer>();
+    for (psim::Integer i = 0; i < n; i++)
+      add<psim::OrbitEcef>(randoms, config, std::to_string(i));
+  }
+};
+
+psim::Configuration config(std::size_t n) {
+  psim::Configuration config;
+  config.set<psim::Integer>("seed", 0);
+  config.set<psim::Integer>("satellites", n);
+  for (std::size_t i = 0; i < n; i++) {
+    auto const prefix = "truth." + std::to_string(i) + ".";
+    config.set<psim::Real>(prefix + "m", 5.0);
+    config.set<psim::Real>(prefix + "S", 0.03);
+    config.set<psim::Vector3>(prefix + "orbit.r", {6.8538e6, 0.0, 1.0 * i});
+    config.set<psim::Vector3>(prefix + "orbit.v", {0.0, 5.3952e3, 5.3952e3});
+  }
+  return config;
+}
+
+psim::OrbitEcefBatch batch(std::size_t n) {
+  psim::OrbitEcefBatch orbits(n);
+  for (std::size_t i = 0; i < n; i++)
+    orbits.set(i, {6.8538e6, 0.0, 1.0 * i}, {0.0, 5.3952e3, 5.3952e3}, 5.0,
+        0.03);
+  return orbits;
+}
+
+} // namespace
+
+static void BM_OrbitEcefBatchSeries(benchmark::State &state) {
+  auto orbits = batch(state.range(0));
+
+  for (auto _ : state)
+    orbits.step(0.1, earth_w, earth_w_dot);
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_OrbitEcefBatchParallel(benchmark::State &state) {
+  auto orbits = batch(state.range(0));
+
+  psim::ThreadPool pool(std::thread::hardware_concurrency() - 1);
+  orbits.parallelize(pool);
+
+  for (auto _ : state)
+    orbits.step(0.1, earth_w, earth_w_dot);
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_OrbitEcefModels(benchmark::State &state) {
+  psim::Simulation<Propagators> simulation(config(state.range(0)));
+
+  for (auto _ : state)
+    simulation.step();
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_OrbitEcefModels)->RangeMultiplier(8)->Range(1, 4096);
+BENCHMARK(BM_OrbitEcefBatchSeries)->RangeMultiplier(8)->Range(1, 32768);
+BENCHMARK(BM_OrbitEcefBatchParallel)->RangeMultiplier(8)->Range(1, 32768);
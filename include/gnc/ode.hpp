@@ -17,13 +17,21 @@
 #ifndef GNC_ODE_HPP_
 #define GNC_ODE_HPP_
 
-#define GNC_ODEXX_TEMPLATE(odexx, type) \
-    template \
+#define GNC_ODEXX_INSTANTIATE(prefix, odexx, type) \
+    prefix template \
+    int odexx<type>(type, type, type const *, type *, unsigned int, type *, \
+        type, type, type, unsigned int, void (*const)(type, type const *, type *)); \
+    prefix template \
     int odexx<type>(type, type, type const *, type *, unsigned int, type *, \
-        type, type, type, unsigned int, void (*const)(type, type const *, type *));
+        type, type, type, unsigned int, \
+        void (*const)(type, type const *, type *, void *), void *, type *, \
+        type const *, type *, unsigned int);
+
+#define GNC_ODEXX_TEMPLATE(odexx, type) \
+    GNC_ODEXX_INSTANTIATE(, odexx, type)
 
 #define GNC_ODEXX_EXTERN_TEMPLATE(odexx, type) \
-    extern GNC_ODEXX_TEMPLATE(odexx, type)
+    GNC_ODEXX_INSTANTIATE(extern, odexx, type)
 
 namespace gnc {
 
@@ -62,6 +70,36 @@ template <typename T>
 int ode23(T ti, T tf, T const *yi, T *yf, unsigned int ne, T *bf, T h_min,
     T rel_tol, T abs_tol, unsigned int max_iter, void (*const f)(T, T const *, T *));
 
+/** @fn ode23
+ *  @param[in]    ti       Initial conditions for the independant variable.
+ *  @param[in]    tf       Desired final state for the independant variable.
+ *  @param[in]    yi       Initial conditions of the dependant variables.
+ *  @param[out]   yf       Final state of the system (dependant variables).
+ *  @param[in]    ne       Number of dependant variables.
+ *  @param[in]    bf       Buffer of length (6 * ne).
+ *  @param[in]    h_min    Minimum timestep allowed.
+ *  @param[in]    rel_tol  Relative tolerance.
+ *  @param[in]    abs_tol  Absolute tolerance.
+ *  @param[in]    max_iter Maximum number of allowed iterations.
+ *  @param[in]    f        Dependant variable update function.
+ *  @param[in]    ptr      Pointer to arbitrary data passed to f.
+ *  @param[inout] h        Initial timestep which is overwritten with the
+ *                         suggested timestep for a following call (optional).
+ *  @param[in]    to       Increasing output times within (ti, tf] (optional).
+ *  @param[out]   yo       Buffer of length (no * ne) holding the state at each
+ *                         output time one after another (optional).
+ *  @param[in]    no       Number of output times.
+ *  @returns Zero on success (see implementation for more details).
+ *  Same as the above except the update function is given the data pointer. If
+ *  h is null or not positive, the initial timestep is a tenth of the interval.
+ *  Output states are interpolated with the method's cubic Hermite dense output.
+ *  NOTE: Template specializations are provided for double and float types. */
+template <typename T>
+int ode23(T ti, T tf, T const *yi, T *yf, unsigned int ne, T *bf, T h_min,
+    T rel_tol, T abs_tol, unsigned int max_iter,
+    void (*const f)(T, T const *, T *, void *), void *ptr, T *h = nullptr,
+    T const *to = nullptr, T *yo = nullptr, unsigned int no = 0);
+
 GNC_ODEXX_EXTERN_TEMPLATE(ode23, float);
 GNC_ODEXX_EXTERN_TEMPLATE(ode23, double);
 
@@ -86,6 +124,37 @@ template <typename T>
 int ode45(T ti, T tf, T const *yi, T *yf, unsigned int ne, T *bf, T h_min,
     T rel_tol, T abs_tol, unsigned int max_iter, void (*const f)(T, T const *, T *));
 
+/** @fn ode45
+ *  @param[in]    ti       Initial conditions for the independant variable.
+ *  @param[in]    tf       Desired final state for the independant variable.
+ *  @param[in]    yi       Initial conditions of the dependant variables.
+ *  @param[out]   yf       Final state of the system (dependant variables).
+ *  @param[in]    ne       Number of dependant variables.
+ *  @param[in]    bf       Buffer of length (9 * ne).
+ *  @param[in]    h_min    Minimum timestep allowed.
+ *  @param[in]    rel_tol  Relative tolerance.
+ *  @param[in]    abs_tol  Absolute tolerance.
+ *  @param[in]    max_iter Maximum number of allowed iterations.
+ *  @param[in]    f        Dependant variable update function.
+ *  @param[in]    ptr      Pointer to arbitrary data passed to f.
+ *  @param[inout] h        Initial timestep which is overwritten with the
+ *                         suggested timestep for a following call (optional).
+ *  @param[in]    to       Increasing output times within (ti, tf] (optional).
+ *  @param[out]   yo       Buffer of length (no * ne) holding the state at each
+ *                         output time one after another (optional).
+ *  @param[in]    no       Number of output times.
+ *  @returns Zero on success (see implementation for more details).
+ *  Same as the above except the update function is given the data pointer. If
+ *  h is null or not positive, the initial timestep is a hundredth of the
+ *  interval. Output states are interpolated with the fourth order continuous
+ *  extension of the Dormand-Prince method.
+ *  NOTE: Template specializations are provided for double and float types. */
+template <typename T>
+int ode45(T ti, T tf, T const *yi, T *yf, unsigned int ne, T *bf, T h_min,
+    T rel_tol, T abs_tol, unsigned int max_iter,
+    void (*const f)(T, T const *, T *, void *), void *ptr, T *h = nullptr,
+    T const *to = nullptr, T *yo = nullptr, unsigned int no = 0);
+
 GNC_ODEXX_EXTERN_TEMPLATE(ode45, float);
 GNC_ODEXX_EXTERN_TEMPLATE(ode45, double);
 
@@ -0,0 +1,121 @@
+//
+// MIT License
+//
+// Copyright (c) 2020 Pathfinder for Autonomous Navigation (PAN)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/** @file gnc/ode45.hpp
+ *  @author Kyle Krol
+ */
+
+#ifndef GNC_ODE45_HPP_
+#define GNC_ODE45_HPP_
+
+#include "ode.hpp"
+
+#include <lin/core.hpp>
+
+namespace gnc {
+
+/** @brief Fourth-fifth order variable step size integrator.
+ *
+ *  @tparam T Fundamental data type.
+ *  @tparam N Number of state parameters.
+ *
+ *  Exposes `ode45` through the same interface as the fixed step size
+ *  integrators so it can be swapped in for them. A call integrates over the
+ *  entire timestep taking as many internal steps as the tolerances require.
+ */
+template <typename T, lin::size_t N>
+class Ode45 {
+ private:
+  struct Data {
+    lin::Vector<T, N> (*dx)(T t, lin::Vector<T, N> const &x, void *ptr);
+    void *ptr;
+  };
+
+  T _y[2 * N];
+  T _bf[9 * N];
+  T _rel_tol;
+  T _abs_tol;
+  T _h_min;
+  unsigned int _max_iter;
+  int _err = ODE_ERR_OK;
+
+  static void _f(T t, T const *y, T *dy, void *ptr) {
+    auto const *data = static_cast<Data const *>(ptr);
+
+    lin::Vector<T, N> x;
+    for (lin::size_t i = 0; i < N; i++) x(i) = y[i];
+    x = data->dx(t, x, data->ptr);
+    for (lin::size_t i = 0; i < N; i++) dy[i] = x(i);
+  }
+
+ public:
+  /** @param[in] rel_tol  Relative tolerance.
+   *  @param[in] abs_tol  Absolute tolerance.
+   *  @param[in] h_min    Minimum internal step size.
+   *  @param[in] max_iter Maximum number of internal steps per call.
+   */
+  Ode45(T rel_tol = T(1.0e-6), T abs_tol = T(1.0e-6), T h_min = T(0.0),
+      unsigned int max_iter = 10000)
+    : _rel_tol(rel_tol), _abs_tol(abs_tol), _h_min(h_min),
+      _max_iter(max_iter) {}
+
+  /** @return Error code of the last call (see `ode45`).
+   */
+  int error() const {
+    return _err;
+  }
+
+  /** @brief Step a differential equation forward in time by a single timestep.
+   *
+   *  @param[in] ti  Initial time.
+   *  @param[in] dt  Integrator timestep.
+   *  @param[in] xi  Initial state.
+   *  @param[in] ptr Pointer to arbitrary data accesible in the update function.
+   *  @param[in] dx  Differential update function.
+   *
+   *  The first internal step attempted spans the entire timestep so the result
+   *  only depends on the arguments and not on previous calls.
+   */
+  lin::Vector<T, N> operator()(
+      T ti, T dt,
+      lin::Vector<T, N> const &xi, void *ptr,
+      lin::Vector<T, N> (*dx)(T t, lin::Vector<T, N> const &x, void *ptr)) {
+    Data data = {dx, ptr};
+    T h = dt;
+
+    T *const yi = _y;
+    T *const yf = _y + N;
+    for (lin::size_t i = 0; i < N; i++) yi[i] = xi(i);
+
+    _err = ode45<T>(ti, ti + dt, yi, yf, N, _bf, _h_min, _rel_tol, _abs_tol,
+        _max_iter, _f, &data, &h);
+
+    lin::Vector<T, N> xf;
+    for (lin::size_t i = 0; i < N; i++) xf(i) = yf[i];
+    return xf;
+  }
+};
+}  // namespace gnc
+
+#endif
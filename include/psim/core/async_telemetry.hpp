@@ -0,0 +1,250 @@
+//
+// MIT License
+//
+// Copyright (c) 2020 Pathfinder for Autonomous Navigation (PAN)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/** @file psim/core/async_telemetry.hpp
+ *  @author Kyle Krol
+ */
+
+#ifndef PSIM_CORE_ASYNC_TELEMETRY_HPP_
+#define PSIM_CORE_ASYNC_TELEMETRY_HPP_
+
+#include <psim/core/ring_buffer.hpp>
+#include <psim/core/state.hpp>
+#include <psim/core/telemetry.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace psim {
+
+/** @brief Streams state field values to a telemetry file from a background
+ *         thread.
+ *
+ *  Samples are copied into a lock free ring buffer by the simulation's thread
+ *  and drained in batches by a writer thread which owns a `TelemetryWriter`.
+ *  This keeps file writes, and any stalls in the disk or page cache, off the
+ *  stepping thread. The resulting file is identical to one written by a
+ *  `TelemetryWriter` so long as no samples were dropped.
+ *
+ *  What happens when the ring buffer fills up is determined by the
+ *  backpressure policy:
+ *
+ *   - `Policy::Block` waits for the writer thread to make room so no samples
+ *     are lost. Every wait is counted as a stall.
+ *   - `Policy::DropOldest` overwrites the oldest queued sample.
+ *   - `Policy::Decimate` drops the new sample and halves the rate samples are
+ *     queued at until the queue drains below a quarter of its capacity.
+ *
+ *  If the writer thread fails, the error is rethrown on the simulation's
+ *  thread by the next call to `step`, `record`, or `close`.
+ */
+class AsyncTelemetryWriter : public TelemetrySink {
+ public:
+  /** @brief Backpressure policy applied when the ring buffer is full.
+   */
+  enum class Policy { Block, DropOldest, Decimate };
+
+  /** @brief Counters describing the state of the pipeline.
+   */
+  struct Stats {
+    /** @brief Samples taken by the simulation's thread.
+     */
+    std::uint64_t samples;
+
+    /** @brief Samples written to the file.
+     */
+    std::uint64_t written;
+
+    /** @brief Samples dropped by the backpressure policy.
+     */
+    std::uint64_t dropped;
+
+    /** @brief Number of times the simulation's thread waited on the writer.
+     */
+    std::uint64_t stalls;
+
+    /** @brief Total time the simulation's thread spent waiting (ns).
+     */
+    std::uint64_t stall_ns;
+
+    /** @brief Number of samples currently queued.
+     */
+    std::size_t depth;
+
+    /** @brief Largest number of samples queued at once.
+     */
+    std::size_t max_depth;
+  };
+
+ private:
+  /** @brief Writer used by the background thread.
+   */
+  TelemetryWriter _writer;
+
+  /** @brief Queued samples.
+   */
+  RingBuffer<TelemetryWriter::Value> _ring;
+
+  /** @brief Sample being queued by the simulation's thread.
+   */
+  std::vector<TelemetryWriter::Value> _row;
+
+  /** @brief Backpressure policy.
+   */
+  Policy _policy;
+
+  /** @brief Log every `_decimation` steps.
+   */
+  std::size_t _decimation;
+
+  /** @brief Steps since the last logged sample.
+   */
+  std::size_t _n;
+
+  /** @brief Samples are queued every `_factor` records under the decimate
+   *         policy.
+   */
+  std::size_t _factor;
+
+  /** @brief Records since the last queued sample under the decimate policy.
+   */
+  std::size_t _skipped;
+
+  /** @brief Counters only updated by the simulation's thread.
+   */
+  std::uint64_t _samples, _dropped, _stalls, _stall_ns;
+  std::size_t _max_depth;
+
+  /** @brief Samples written by the writer thread.
+   */
+  std::atomic<std::uint64_t> _written;
+
+  /** @brief Flag set once the writer thread has stopped due to an error.
+   */
+  std::atomic<bool> _failed;
+
+  /** @brief Flag requesting the writer thread to drain the queue and exit.
+   */
+  std::atomic<bool> _stop;
+
+  /** @brief Flag specifying whether the log has been closed.
+   */
+  bool _closed;
+
+  /** @brief Error raised on the writer thread.
+   */
+  std::exception_ptr _exception;
+
+  std::mutex _mutex;
+  std::condition_variable _condition;
+
+  /** @brief Writer thread.
+   */
+  std::thread _thread;
+
+  /** @brief Writer thread loop.
+   */
+  void _drain();
+
+  /** @brief Rethrows an error raised on the writer thread.
+   */
+  void _check();
+
+ public:
+  AsyncTelemetryWriter() = delete;
+  AsyncTelemetryWriter(AsyncTelemetryWriter const &) = delete;
+  AsyncTelemetryWriter(AsyncTelemetryWriter &&) = delete;
+  AsyncTelemetryWriter &operator=(AsyncTelemetryWriter const &) = delete;
+  AsyncTelemetryWriter &operator=(AsyncTelemetryWriter &&) = delete;
+
+  /** @brief Closes the log if it hasn't been already.
+   */
+  virtual ~AsyncTelemetryWriter();
+
+  /** @param[in] state      Simulation state.
+   *  @param[in] file       Telemetry file which is overwritten.
+   *  @param[in] fields     Names of the fields to log.
+   *  @param[in] decimation Log a sample every `decimation` steps.
+   *  @param[in] chunk      Number of samples per chunk.
+   *  @param[in] capacity   Number of samples the ring buffer holds.
+   *  @param[in] policy     Backpressure policy.
+   *
+   *  See `TelemetryWriter` and `RingBuffer` for the errors that may be
+   *  thrown.
+   */
+  AsyncTelemetryWriter(State const &state, std::string const &file,
+      std::vector<std::string> const &fields, std::size_t decimation = 1,
+      std::size_t chunk = 4096, std::size_t capacity = 1024,
+      Policy policy = Policy::Block);
+
+  /** @brief Signals a simulation step was taken.
+   *
+   *  A sample is logged every `decimation` calls.
+   */
+  virtual void step() override;
+
+  /** @brief Queues a sample of all fields subject to the backpressure policy.
+   *
+   *  If the log has been closed, a runtime error will be thrown.
+   */
+  void record();
+
+  /** @brief Waits for all queued samples to be written, stops the writer
+   *         thread, and closes the file.
+   *
+   *  Closing an already closed log has no effect.
+   */
+  virtual void close() override;
+
+  /** @return Current pipeline counters.
+   */
+  Stats stats() const;
+
+  /** @return Column names in file order.
+   */
+  std::vector<std::string> const &columns() const;
+
+  /** @return Telemetry file name.
+   */
+  std::string const &file() const;
+
+  /** @param[in] name Policy name; one of "block", "drop_oldest", or
+   *                  "decimate".
+   *
+   *  @return Backpressure policy.
+   *
+   *  If the name isn't recognized, a runtime error will be thrown.
+   */
+  static Policy policy(std::string const &name);
+};
+} // namespace psim
+
+#endif
@@ -30,6 +30,7 @@
 #define PSIM_CORE_CASTABLE_BASE_HPP_
 
 #include <psim/core/nameable.hpp>
+#include <psim/core/types.hpp>
 
 #include <stdexcept>
 
@@ -39,16 +40,81 @@ namespace psim {
  *
  *  @tparam D Expected derived type.
  *
- *  This is used to help with state field and parameter casting.
+ *  This is used to help with state field and parameter casting. Derived types
+ *  are expected to register themselves on construction which fills in the type
+ *  tag of their underlying type. Casts to tagged underlying types then only
+ *  require comparing tags. Casts to untagged underlying types, or from objects
+ *  that were copied, fall back to a dynamic cast.
  */
 template <template <typename> class D>
 class CastableBase : public virtual Nameable {
+ private:
+  /** @brief Type tag of the derived type's underlying type.
+   */
+  TypeTag _tag = TypeTag::Unknown;
+
+  /** @brief Pointer to the registered derived object.
+   */
+  void *_derived = nullptr;
+
+  /** @brief Attempts to downcast this object to the expected derived type.
+   *
+   *  @tparam T Expected underlying type.
+   *
+   *  @return Casted pointer or null if the cast failed.
+   */
+  template <typename T, typename To, typename From>
+  To _cast(From ptr) const {
+    if (type_tag<T>() == TypeTag::Unknown)
+      return dynamic_cast<To>(ptr);
+    if (type_tag<T>() != _tag)
+      return nullptr;
+    if (_derived)
+      return static_cast<To>(_derived);
+
+    return dynamic_cast<To>(ptr);
+  }
+
  protected:
   CastableBase() = default;
 
+  /** @brief Registers the derived object.
+   *
+   *  @param[in] derived Pointer to the derived object.
+   */
+  template <typename T>
+  CastableBase(D<T> *derived) : _tag(type_tag<T>()), _derived(derived) {}
+
+  /** @brief Copies the type tag of another object.
+   *
+   *  The copy isn't registered as its derived object can't be known here.
+   */
+  CastableBase(CastableBase const &castable) : _tag(castable._tag) {}
+
+  CastableBase &operator=(CastableBase const &) = delete;
+
+  /** @brief Registers the derived object.
+   *
+   *  @param[in] derived Pointer to the derived object.
+   *
+   *  Used by derived types which inherit this class virtually and therefore
+   *  can't initialize it directly.
+   */
+  template <typename T>
+  void _register(D<T> *derived) {
+    _tag = type_tag<T>();
+    _derived = derived;
+  }
+
  public:
   virtual ~CastableBase() = default;
 
+  /** @return Type tag of the underlying type.
+   */
+  inline TypeTag tag() const {
+    return _tag;
+  }
+
   /** @brief Attempt to cast to an expected derived type.
    *
    *  @tparam T Expected underlying type.
@@ -63,7 +129,7 @@ class CastableBase : public virtual Nameable {
    */
   template <typename T>
   D<T> const &cast() const {
-    auto const *ptr = dynamic_cast<D<T> const *>(this);
+    auto const *ptr = _cast<T, D<T> const *>(this);
     if (!ptr)
       throw std::runtime_error(
           "Invalid call to 'CastableBase::cast() const' on '" + name() + ":" +
@@ -74,7 +140,7 @@ class CastableBase : public virtual Nameable {
 
   template <typename T>
   D<T> &cast() {
-    auto *ptr = dynamic_cast<D<T> *>(this);
+    auto *ptr = _cast<T, D<T> *>(this);
     if (!ptr)
       throw std::runtime_error("Invalid call to 'CastableBase::cast()' on '" +
                                name() + ":" + type() + "'");
@@ -0,0 +1,197 @@
+//
+// MIT License
+//
+// Copyright (c) 2020 Pathfinder for Autonomous Navigation (PAN)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/** @file psim/core/checkpoint.hpp
+ *  @author Kyle Krol
+ */
+
+#ifndef PSIM_CORE_CHECKPOINT_HPP_
+#define PSIM_CORE_CHECKPOINT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace psim {
+
+/** @brief Compact binary snapshot of a simulation's state.
+ *
+ *  A checkpoint is an ordered sequence of named records each holding the raw
+ *  bytes of a trivially copyable value. Only the values are stored, back to
+ *  back, while the names and sizes of all records are folded into a single
+ *  layout hash. Records are read back in the order they were written and a
+ *  reader is only done once the layout it read matches the one written.
+ *  Restoring a checkpoint into a simulation with a different set of models
+ *  therefore fails loudly instead of silently scrambling the state.
+ *
+ *  Checkpoints may be kept in memory or saved to and loaded from files. Files
+ *  begin with a magic string, the format version, and the layout hash. Values
+ *  are stored in the host's byte order so files are only portable between
+ *  hosts of the same architecture.
+ */
+class Checkpoint {
+ public:
+  class Reader;
+
+  /** @brief Version of the checkpoint format.
+   */
+  static constexpr std::uint32_t version = 2;
+
+ private:
+  /** @brief Values of the records.
+   */
+  std::string _data;
+
+  /** @brief Hash of the names and sizes of the records.
+   */
+  std::uint64_t _layout;
+
+  /** @brief Folds a record's name and size into a layout hash.
+   */
+  static std::uint64_t _fold(
+      std::uint64_t layout, std::string const &name, std::size_t size);
+
+  void _write(std::string const &name, void const *value, std::size_t size);
+
+ public:
+  Checkpoint();
+  Checkpoint(Checkpoint const &) = default;
+  Checkpoint(Checkpoint &&) = default;
+  Checkpoint &operator=(Checkpoint const &) = default;
+  Checkpoint &operator=(Checkpoint &&) = default;
+
+  ~Checkpoint() = default;
+
+  /** @brief Loads a checkpoint from a file.
+   *
+   *  @param[in] file Checkpoint file.
+   *
+   *  If the file can't be read, isn't a checkpoint, or was written with a
+   *  different format version, a runtime error will be thrown.
+   */
+  Checkpoint(std::string const &file);
+
+  /** @brief Saves the checkpoint to a file.
+   *
+   *  @param[in] file Checkpoint file.
+   *
+   *  If the file can't be written, a runtime error will be thrown.
+   */
+  void save(std::string const &file) const;
+
+  /** @return Size of the serialized records in bytes.
+   */
+  std::size_t size() const;
+
+  /** @return Hash of the names and sizes of the records in the order they
+   *          were written.
+   *
+   *  Checkpoints captured from simulations set up with the same set of models
+   *  share a layout.
+   */
+  std::uint64_t layout() const;
+
+  /** @brief Removes every record.
+   *
+   *  The underlying buffer is kept so the checkpoint can be rewritten without
+   *  reallocating.
+   */
+  void clear();
+
+  /** @brief Appends a record.
+   *
+   *  @tparam T Trivially copyable type.
+   *
+   *  @param[in] name  Record name.
+   *  @param[in] value Value.
+   */
+  template <typename T>
+  void write(std::string const &name, T const &value) {
+    static_assert(std::is_trivially_copyable<T>::value,
+        "Checkpoint records must be trivially copyable");
+
+    _write(name, &value, sizeof(T));
+  }
+};
+
+/** @brief Reads the records of a checkpoint in order.
+ */
+class Checkpoint::Reader {
+ private:
+  /** @brief Checkpoint being read.
+   */
+  Checkpoint const &_checkpoint;
+
+  /** @brief Offset of the next record.
+   */
+  std::size_t _offset;
+
+  /** @brief Hash of the names and sizes of the records read so far.
+   */
+  std::uint64_t _layout;
+
+  void _read(std::string const &name, void *value, std::size_t size);
+
+ public:
+  Reader() = delete;
+  Reader(Reader const &) = delete;
+  Reader(Reader &&) = delete;
+  Reader &operator=(Reader const &) = delete;
+  Reader &operator=(Reader &&) = delete;
+
+  ~Reader() = default;
+
+  /** @param[in] checkpoint Checkpoint which must outlive the reader.
+   */
+  Reader(Checkpoint const &checkpoint);
+
+  /** @brief Reads the next record.
+   *
+   *  @tparam T Trivially copyable type.
+   *
+   *  @param[in]  name  Expected record name.
+   *  @param[out] value Value.
+   *
+   *  If the checkpoint doesn't hold enough bytes for the value, a runtime error
+   *  will be thrown and the value is left untouched. Records read with a
+   *  different name or size than they were written with are only detected by
+   *  `done`.
+   */
+  template <typename T>
+  void read(std::string const &name, T &value) {
+    static_assert(std::is_trivially_copyable<T>::value,
+        "Checkpoint records must be trivially copyable");
+
+    _read(name, &value, sizeof(T));
+  }
+
+  /** @return True if every record has been read with the name and size it
+   *          was written with and false otherwise.
+   */
+  bool done() const;
+};
+} // namespace psim
+
+#endif
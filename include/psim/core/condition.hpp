@@ -0,0 +1,135 @@
+//
+// MIT License
+//
+// Copyright (c) 2020 Pathfinder for Autonomous Navigation (PAN)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/** @file psim/core/condition.hpp
+ *  @author Kyle Krol
+ */
+
+#ifndef PSIM_CORE_CONDITION_HPP_
+#define PSIM_CORE_CONDITION_HPP_
+
+#include <psim/core/state.hpp>
+#include <psim/core/state_field.hpp>
+#include <psim/core/types.hpp>
+
+#include <string>
+
+namespace psim {
+
+/** @brief Comparison between a scalar state field and a constant value.
+ *
+ *  Conditions are evaluated entirely in C++ and are intended to be used as stop
+ *  predicates when stepping a simulation many times in a row. Boolean, integer,
+ *  and real valued fields are supported. Integer fields are compared exactly
+ *  against integer values.
+ */
+class Condition {
+ public:
+  /** @brief Supported comparison operators.
+   */
+  enum class Comparison {
+    Less,
+    LessEqual,
+    Greater,
+    GreaterEqual,
+    Equal,
+    NotEqual
+  };
+
+ private:
+  /** @brief Field being compared (only the one matching the kind is set).
+   */
+  StateField<Boolean> const *_boolean_field;
+  StateField<Integer> const *_integer_field;
+  StateField<Real> const *_real_field;
+
+  /** @brief Type tag of the field's underlying type.
+   */
+  TypeTag _tag;
+
+  /** @brief Comparison operator.
+   */
+  Comparison _comparison;
+
+  /** @brief Value the field is compared to (only one is used).
+   */
+  Integer _integer;
+  Real _real;
+
+  template <typename T>
+  bool _compare(T const &lhs, T const &rhs) const;
+
+  void _bind(State const &state, std::string const &name);
+
+ public:
+  Condition() = delete;
+
+  /** @param[in] state      Simulation state.
+   *  @param[in] field      Field name.
+   *  @param[in] comparison Comparison operator.
+   *  @param[in] value      Value the field is compared against.
+   *
+   *  If the field doesn't exist or has an unsupported underlying type, a
+   *  runtime error will be thrown.
+   *
+   *  @{
+   */
+  Condition(State const &state, std::string const &field,
+      Comparison comparison, Integer value);
+
+  Condition(State const &state, std::string const &field,
+      Comparison comparison, Real value);
+  /** @}
+   */
+
+  /** @brief Parses a condition from a string expression.
+   *
+   *  @param[in] state      Simulation state.
+   *  @param[in] expression Expression of the form '<field> <op> <value>'.
+   *
+   *  The operator must be one of '<', '<=', '>', '>=', '==', or '!='. Boolean
+   *  fields may only be compared against 'true' or 'false' with '==' and '!='.
+   *  If the expression is malformed, the field doesn't exist, or the field has
+   *  an unsupported type, a runtime error will be thrown.
+   */
+  Condition(State const &state, std::string const &expression);
+
+  /** @brief Extracts the field name from a condition expression.
+   *
+   *  @param[in] expression Expression of the form '<field> <op> <value>'.
+   *
+   *  @return Field name.
+   *
+   *  This allows the fields read by stop conditions to be determined before a
+   *  simulation is constructed. The rest of the expression isn't validated.
+   */
+  static std::string field(std::string const &expression);
+
+  /** @return True if the condition is currently satisfied and false otherwise.
+   */
+  bool operator()() const;
+};
+} // namespace psim
+
+#endif
@@ -60,7 +60,10 @@ class Configuration {
   std::unordered_map<std::string, std::unique_ptr<ParameterBase const>>
       _parameters;
 
-  Configuration() = default;
+  /** @brief Configuration parameters not found here are looked up in (may be
+   *         null).
+   */
+  Configuration const *_base = nullptr;
 
   void _parse(std::string const &file);
 
@@ -73,6 +76,10 @@ class Configuration {
 
   virtual ~Configuration() = default;
 
+  /** @brief Creates an empty configuration.
+   */
+  Configuration() = default;
+
   /** @brief Parses a configuration file into a configuration.
    *
    *  @param[in] file Configuration file.
@@ -93,14 +100,63 @@ class Configuration {
    */
   Configuration(std::vector<std::string> const &files);
 
+  /** @brief Creates an empty configuration layered on top of another.
+   *
+   *  @param[in] base Base configuration.
+   *
+   *  @return Layered configuration.
+   *
+   *  Parameters not set in the layered configuration are looked up in the base
+   *  configuration, which must outlive it. This allows many configurations to
+   *  share a single parsed base while overriding select parameters.
+   */
+  static Configuration overlay(Configuration const &base);
+
+  /** @brief Creates a standalone copy of a configuration.
+   *
+   *  @param[in] config Configuration to copy.
+   *
+   *  @return Copied configuration.
+   *
+   *  The parameters of any base configurations are copied as well so the copy
+   *  doesn't reference the original. See `merge` for more information.
+   */
+  static Configuration copy(Configuration const &config);
+
+  /** @brief Copies every parameter of another configuration into this one.
+   *
+   *  @param[in] config Configuration to merge.
+   *
+   *  Parameters of the other configuration's base configurations are merged
+   *  first so they're shadowed as they would be when looked up. Parameters
+   *  already set under the same names are replaced. If a parameter doesn't
+   *  hold one of the tagged underlying types, a runtime error will be thrown.
+   */
+  void merge(Configuration const &config);
+
+  /** @brief Sets a parameter.
+   *
+   *  @tparam T Underlying type.
+   *
+   *  @param[in] name  Parameter name.
+   *  @param[in] value Parameter value.
+   *
+   *  Any parameter previously set under the same name is replaced. Parameters
+   *  of a base configuration are shadowed rather than modified.
+   */
+  template <typename T>
+  void set(std::string const &name, T const &value) {
+    _parameters[name] = std::make_unique<Parameter<T>>(name, value);
+  }
+
   /** @brief Retrives a parameter by name.
    *
    *  @param[in] name
    *
    *  @return Pointer to the parameter.
    *
-   *  If no parameter is found by the specified name, a null pointer is
-   *  returned.
+   *  If no parameter is found by the specified name, in this or any base
+   *  configuration, a null pointer is returned.
    */
   ParameterBase const *get(std::string const &name) const;
 
@@ -0,0 +1,142 @@
+//
+// MIT License
+//
+// Copyright (c) 2020 Pathfinder for Autonomous Navigation (PAN)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/** @file psim/core/dependencies.hpp
+ *  @author Kyle Krol
+ */
+
+#ifndef PSIM_CORE_DEPENDENCIES_HPP_
+#define PSIM_CORE_DEPENDENCIES_HPP_
+
+#include <psim/core/state_field.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace psim {
+
+/** @brief Set of state fields, and their versions, read while evaluating a
+ *         lazy state field.
+ *
+ *  Every state field carries a version counter which is incremented whenever
+ *  the field's value changes. While a dependency set is being recorded (see
+ *  `Dependencies::Scope`), all state field reads on the current thread are
+ *  appended to it. A memoized lazy field can then check whether any of its
+ *  inputs have changed since it was last evaluated.
+ *
+ *  Recording only happens while a memoized lazy field is evaluating. Reads
+ *  outside of an evaluation only pay for a relaxed load of a global counter.
+ */
+class Dependencies {
+ private:
+  /** @brief Number of dependency sets being recorded across all threads.
+   *
+   *  Checked before the thread local below which is comparatively expensive
+   *  to access.
+   */
+  static std::atomic<std::size_t> _recording;
+
+  /** @brief Dependency set currently being recorded on this thread.
+   */
+  static thread_local Dependencies *_current;
+
+  /** @brief Fields read and their versions at the time of the read.
+   */
+  std::vector<std::pair<StateFieldBase const *, std::size_t>> _reads;
+
+ public:
+  /** @brief Records all state field reads into a dependency set for as long as
+   *         the scope is alive.
+   *
+   *  Scopes can be nested and recording resumes in the enclosing dependency set
+   *  once a scope is destroyed. Passing a null dependency set suspends recording
+   *  for the lifetime of the scope.
+   */
+  class Scope {
+   private:
+    Dependencies *const _previous;
+    Dependencies *const _dependencies;
+
+   public:
+    Scope() = delete;
+    Scope(Scope const &) = delete;
+    Scope(Scope &&) = delete;
+    Scope &operator=(Scope const &) = delete;
+    Scope &operator=(Scope &&) = delete;
+
+    /** @param[in] dependencies Dependency set to record into (may be null).
+     *
+     *  The dependency set is cleared before recording starts.
+     */
+    Scope(Dependencies *dependencies)
+      : _previous(_current), _dependencies(dependencies) {
+      if (_dependencies) {
+        _dependencies->_reads.clear();
+        _recording.fetch_add(1, std::memory_order_relaxed);
+      }
+      _current = _dependencies;
+    }
+
+    ~Scope() {
+      _current = _previous;
+      if (_dependencies)
+        _recording.fetch_sub(1, std::memory_order_relaxed);
+    }
+  };
+
+  Dependencies() = default;
+
+  /** @return True if a dependency set is being recorded on this thread.
+   */
+  static inline bool recording() {
+    return _recording.load(std::memory_order_relaxed) != 0 && _current;
+  }
+
+  /** @brief Notifies the dependency set currently being recorded of a read.
+   *
+   *  @param[in] field   Field being read.
+   *  @param[in] version Version of the field's value being read.
+   */
+  static inline void read(StateFieldBase const &field, std::size_t version) {
+    if (recording())
+      _current->_reads.emplace_back(&field, version);
+  }
+
+  /** @return True if any of the recorded fields have changed.
+   *
+   *  Note that checking lazy fields brings them up to date.
+   */
+  bool changed() const;
+
+  /** @return Number of recorded reads.
+   */
+  inline std::size_t size() const {
+    return _reads.size();
+  }
+};
+} // namespace psim
+
+#endif
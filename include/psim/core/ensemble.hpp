@@ -0,0 +1,233 @@
+//
+// MIT License
+//
+// Copyright (c) 2020 Pathfinder for Autonomous Navigation (PAN)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/** @file psim/core/ensemble.hpp
+ *  @author Kyle Krol
+ */
+
+#ifndef PSIM_CORE_ENSEMBLE_HPP_
+#define PSIM_CORE_ENSEMBLE_HPP_
+
+#include <psim/core/configuration.hpp>
+#include <psim/core/recorder.hpp>
+#include <psim/core/simulation.hpp>
+#include <psim/core/thread_pool.hpp>
+#include <psim/core/types.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace psim {
+
+/** @brief Set of independent simulations of the same model stepped together.
+ *
+ *  @tparam C Underlying model used by every member simulation.
+ *
+ *  An ensemble is intended for Monte Carlo analysis. Every member is built
+ *  from its own configuration - typically an overlay of a shared base
+ *  configuration overriding the seed and perturbing initial conditions (see
+ *  `Configuration::overlay`).
+ *
+ *  Members are constructed and stepped concurrently on a thread pool with each
+ *  member only ever being touched by a single thread at a time. Because members
+ *  share no state and each owns its random number generator and streams, the
+ *  results are identical regardless of the number of threads used.
+ */
+template <class C>
+class Ensemble {
+ private:
+  /** @brief Member simulations.
+   */
+  std::vector<std::unique_ptr<Simulation<C>>> _members;
+
+  /** @brief Thread pool the members are stepped on (may be null).
+   */
+  std::unique_ptr<ThreadPool> _pool;
+
+  /** @brief Calls a function for every member index.
+   */
+  template <typename F>
+  void _for_each(F const &f) {
+    if (_pool) {
+      _pool->for_each(_members.size(), f);
+    } else {
+      for (std::size_t i = 0; i < _members.size(); i++)
+        f(i);
+    }
+  }
+
+  /** @brief Shared implementation of the public constructors.
+   */
+  Ensemble(std::vector<Configuration> const &configs,
+      std::vector<std::string> const &fields, bool prune, std::size_t threads)
+    : _members(configs.size()) {
+    if (threads > 1)
+      _pool = std::make_unique<ThreadPool>(threads - 1);
+
+    _for_each([&](std::size_t i) {
+      auto config = Configuration::overlay(configs[i]);
+      config.set<Integer>("threads", 1);
+      _members[i] = prune ? std::make_unique<Simulation<C>>(config, fields)
+                          : std::make_unique<Simulation<C>>(config);
+    });
+  }
+
+ public:
+  Ensemble() = delete;
+  Ensemble(Ensemble const &) = delete;
+  Ensemble(Ensemble &&) = default;
+  Ensemble &operator=(Ensemble const &) = delete;
+  Ensemble &operator=(Ensemble &&) = default;
+
+  ~Ensemble() = default;
+
+  /** @brief Creates one member simulation per configuration.
+   *
+   *  @param[in] configs Member configurations.
+   *  @param[in] threads Total number of threads used to step the members.
+   *
+   *  Members are always stepped serially internally, any 'threads' parameter in
+   *  the member configurations is overridden. The configurations are only
+   *  required for the duration of the constructor.
+   */
+  Ensemble(std::vector<Configuration> const &configs, std::size_t threads = 1)
+    : Ensemble(configs, {}, false, threads) {}
+
+  /** @brief Creates one member simulation per configuration computing only
+   *         what's needed for a set of fields.
+   *
+   *  @param[in] configs Member configurations.
+   *  @param[in] fields  Names of the fields that will be read.
+   *  @param[in] threads Total number of threads used to step the members.
+   *
+   *  Every member is pruned for the given fields. See `Simulation` for more
+   *  information.
+   */
+  Ensemble(std::vector<Configuration> const &configs,
+      std::vector<std::string> const &fields, std::size_t threads = 1)
+    : Ensemble(configs, fields, true, threads) {}
+
+  /** @return Number of member simulations.
+   */
+  std::size_t size() const {
+    return _members.size();
+  }
+
+  /** @param[in] i Member index.
+   *
+   *  @return Member simulation.
+   *
+   *  If the index is out of bounds, a runtime error will be thrown.
+   *
+   *  @{
+   */
+  Simulation<C> &at(std::size_t i) {
+    if (i >= _members.size())
+      throw std::runtime_error("Ensemble member index out of bounds");
+
+    return *_members[i];
+  }
+
+  Simulation<C> const &at(std::size_t i) const {
+    if (i >= _members.size())
+      throw std::runtime_error("Ensemble member index out of bounds");
+
+    return *_members[i];
+  }
+  /** @}
+   */
+
+  /** @brief Steps every member simulation forward a number of times.
+   *
+   *  @param[in] n Number of steps.
+   */
+  void step(std::size_t n = 1) {
+    _for_each([&](std::size_t i) { _members[i]->step(n); });
+  }
+
+  /** @brief Steps every member simulation until any of its conditions are
+   *         satisfied.
+   *
+   *  @param[in] expressions Stop conditions.
+   *
+   *  @return Index of the first satisfied condition for each member.
+   *
+   *  See `Simulation::step_until` for more information.
+   */
+  std::vector<std::size_t> step_until(
+      std::vector<std::string> const &expressions) {
+    std::vector<std::size_t> indices(_members.size());
+    _for_each([&](std::size_t i) {
+      indices[i] = _members[i]->step_until(expressions);
+    });
+    return indices;
+  }
+
+  /** @brief Attaches a new recorder to every member simulation.
+   *
+   *  @param[in] fields     Names of the fields to record.
+   *  @param[in] decimation Record a sample every `decimation` steps.
+   *  @param[in] capacity   Number of samples to preallocate.
+   *
+   *  @return Pointers to the attached recorders in member order.
+   *
+   *  See `Simulation::record` for more information.
+   */
+  std::vector<std::shared_ptr<Recorder>> record(
+      std::vector<std::string> const &fields, std::size_t decimation = 1,
+      std::size_t capacity = 0) {
+    std::vector<std::shared_ptr<Recorder>> recorders;
+    recorders.reserve(_members.size());
+    for (auto const &member : _members)
+      recorders.push_back(member->record(fields, decimation, capacity));
+    return recorders;
+  }
+
+  /** @brief Gathers the current value of fields across all members.
+   *
+   *  @param[in] fields Names of the fields to gather.
+   *
+   *  @return Recorder holding one sample per member in member order.
+   *
+   *  If the ensemble is empty or a field can't be recorded, a runtime error
+   *  will be thrown.
+   */
+  std::shared_ptr<Recorder> gather(
+      std::vector<std::string> const &fields) const {
+    if (_members.empty())
+      throw std::runtime_error("Can't gather fields from an empty ensemble");
+
+    auto recorder = std::make_shared<Recorder>(
+        *_members.front(), fields, 1, _members.size());
+    for (auto const &member : _members)
+      recorder->record(*member);
+    return recorder;
+  }
+};
+} // namespace psim
+
+#endif
@@ -0,0 +1,188 @@
+//
+// MIT License
+//
+// Copyright (c) 2020 Pathfinder for Autonomous Navigation (PAN)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/** @file psim/core/field_handle.hpp
+ *  @author Kyle Krol
+ */
+
+#ifndef PSIM_CORE_FIELD_HANDLE_HPP_
+#define PSIM_CORE_FIELD_HANDLE_HPP_
+
+#include <psim/core/state_field.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+namespace psim {
+
+/** @brief Typed reference to a field registered in a frozen simulation state.
+ *
+ *  @tparam T Underlying type.
+ *
+ *  A handle is produced by `State::resolve` and holds both the field's index in
+ *  the state's flat field table and a pointer to the already casted field. This
+ *  allows repeated reads without hashing the field's name or performing a
+ *  dynamic cast on every access.
+ */
+template <typename T>
+class FieldHandle {
+ private:
+  /** @brief Index of the field in the state's field table.
+   */
+  std::size_t _index;
+
+  /** @brief Pointer to the field.
+   */
+  StateField<T> const *_field;
+
+ public:
+  /** @brief Index value held by an invalid handle.
+   */
+  static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+  /** @brief Constructs an invalid handle.
+   */
+  FieldHandle() : _index(npos), _field(nullptr) {}
+
+  /** @param[in] index Index of the field in the state's field table.
+   *  @param[in] field Pointer to the field.
+   */
+  FieldHandle(std::size_t index, StateField<T> const *field)
+    : _index(index), _field(field) {}
+
+  /** @return True if the handle refers to a field and false otherwise.
+   */
+  explicit operator bool() const {
+    return _field != nullptr;
+  }
+
+  /** @return Index of the field in the state's field table.
+   */
+  std::size_t index() const {
+    return _index;
+  }
+
+  /** @return Reference to the field.
+   *
+   *  If the handle is invalid, a runtime error will be thrown.
+   */
+  StateField<T> const &field() const {
+    if (!_field)
+      throw std::runtime_error("Invalid call to 'FieldHandle::field() const' "
+                               "on an invalid handle");
+
+    return *_field;
+  }
+
+  /** @return Constant reference to the underlying value.
+   *
+   *  No checks are performed here - the handle must be valid.
+   */
+  T const &get() const {
+    return _field->get();
+  }
+};
+
+/** @brief Typed reference to a writable field registered in a frozen simulation
+ *         state.
+ *
+ *  @tparam T Underlying type.
+ *
+ *  See `FieldHandle` for more information.
+ */
+template <typename T>
+class FieldHandleWritable {
+ private:
+  /** @brief Index of the field in the state's field table.
+   */
+  std::size_t _index;
+
+  /** @brief Pointer to the writable field.
+   */
+  StateFieldWritable<T> *_field;
+
+ public:
+  /** @brief Index value held by an invalid handle.
+   */
+  static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+  /** @brief Constructs an invalid handle.
+   */
+  FieldHandleWritable() : _index(npos), _field(nullptr) {}
+
+  /** @param[in] index Index of the field in the state's field table.
+   *  @param[in] field Pointer to the writable field.
+   */
+  FieldHandleWritable(std::size_t index, StateFieldWritable<T> *field)
+    : _index(index), _field(field) {}
+
+  /** @return True if the handle refers to a field and false otherwise.
+   */
+  explicit operator bool() const {
+    return _field != nullptr;
+  }
+
+  /** @return Index of the field in the state's field table.
+   */
+  std::size_t index() const {
+    return _index;
+  }
+
+  /** @return Reference to the writable field.
+   *
+   *  If the handle is invalid, a runtime error will be thrown.
+   */
+  StateFieldWritable<T> &field() const {
+    if (!_field)
+      throw std::runtime_error("Invalid call to 'FieldHandleWritable::field() "
+                               "const' on an invalid handle");
+
+    return *_field;
+  }
+
+  /** @return Reference to the underlying value.
+   *
+   *  No checks are performed here - the handle must be valid.
+   */
+  T &get() const {
+    return _field->get();
+  }
+
+  /** @return Read only handle to the same field.
+   */
+  operator FieldHandle<T>() const {
+    return FieldHandle<T>(_index, _field);
+  }
+};
+
+template <typename T>
+constexpr std::size_t FieldHandle<T>::npos;
+
+template <typename T>
+constexpr std::size_t FieldHandleWritable<T>::npos;
+
+} // namespace psim
+
+#endif
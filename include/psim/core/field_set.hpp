@@ -0,0 +1,175 @@
+//
+// MIT License
+//
+// Copyright (c) 2020 Pathfinder for Autonomous Navigation (PAN)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/** @file psim/core/field_set.hpp
+ *  @author Kyle Krol
+ */
+
+#ifndef PSIM_CORE_FIELD_SET_HPP_
+#define PSIM_CORE_FIELD_SET_HPP_
+
+#include <psim/core/state.hpp>
+#include <psim/core/state_field.hpp>
+#include <psim/core/types.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace psim {
+
+/** @brief Reads and writes a fixed set of state fields as a flat array of
+ *         reals.
+ *
+ *  Field names are resolved once on construction so repeated reads and writes
+ *  don't hash names or cast fields. Values are laid out in the order the fields
+ *  were given with vector fields taking one entry per component. Booleans are
+ *  stored as zero or one and integers are converted to reals which is exact
+ *  for magnitudes up to 2^53 (i.e. over a hundred days in nanoseconds).
+ *
+ *  The field set holds pointers into the state and must not outlive it.
+ */
+class FieldSet {
+ private:
+  /** @brief Resolved field and the index of its first value.
+   */
+  struct Entry {
+    StateFieldBase const *field;
+    StateFieldWritableBase *writable;
+    TypeTag tag;
+    std::size_t offset;
+    std::size_t width;
+  };
+
+  /** @brief Names of the fields in order.
+   */
+  std::vector<std::string> _fields;
+
+  /** @brief Resolved fields.
+   */
+  std::vector<Entry> _entries;
+
+  /** @brief Total number of values.
+   */
+  std::size_t _size;
+
+  /** @brief Flag specifying whether every field is writable.
+   */
+  bool _writable;
+
+  /** @brief Retrieves a resolved field by index.
+   *
+   *  If the index is out of bounds, a runtime error will be thrown.
+   */
+  Entry const &_at(std::size_t i) const;
+
+  /** @brief Copies a field's values into `v`.
+   */
+  static void _get(Entry const &entry, Real *v);
+
+  /** @brief Writes a field's values from `v`.
+   */
+  static void _set(Entry const &entry, Real const *v);
+
+ public:
+  FieldSet() = delete;
+  FieldSet(FieldSet const &) = default;
+  FieldSet(FieldSet &&) = default;
+  FieldSet &operator=(FieldSet const &) = default;
+  FieldSet &operator=(FieldSet &&) = default;
+
+  ~FieldSet() = default;
+
+  /** @param[in] state  Simulation state.
+   *  @param[in] fields Names of the fields in the set.
+   *
+   *  If a field doesn't exist, has an unsupported type, or is listed more than
+   *  once, a runtime error will be thrown.
+   */
+  FieldSet(State &state, std::vector<std::string> const &fields);
+
+  /** @return Names of the fields in order.
+   */
+  std::vector<std::string> const &fields() const;
+
+  /** @return Total number of values across all fields.
+   */
+  std::size_t size() const;
+
+  /** @param[in] i Field index within the set.
+   *
+   *  @return Index of the field's first value.
+   *
+   *  If the index is out of bounds, a runtime error will be thrown.
+   */
+  std::size_t offset(std::size_t i) const;
+
+  /** @param[in] i Field index within the set.
+   *
+   *  @return Number of values held by the field.
+   *
+   *  See `offset` for more information.
+   */
+  std::size_t width(std::size_t i) const;
+
+  /** @param[in] i Field index within the set.
+   *
+   *  @return Type of the field.
+   *
+   *  See `offset` for more information.
+   */
+  TypeTag tag(std::size_t i) const;
+
+  /** @return True if every field in the set is writable and false otherwise.
+   */
+  bool writable() const;
+
+  /** @brief Copies the values of every field.
+   *
+   *  @param[out] values Array of at least `size()` reals.
+   */
+  void get(Real *values) const;
+
+  /** @brief Writes the values of every field.
+   *
+   *  @param[in] values Array of at least `size()` reals.
+   *
+   *  If any field isn't writable, a runtime error will be thrown before any
+   *  field is written.
+   */
+  void set(Real const *values);
+
+  /** @brief Writes the values of a single field.
+   *
+   *  @param[in] i      Field index within the set.
+   *  @param[in] values Array of at least `width(i)` reals.
+   *
+   *  If the index is out of bounds or the field isn't writable, a runtime error
+   *  will be thrown.
+   */
+  void set(std::size_t i, Real const *values);
+};
+} // namespace psim
+
+#endif
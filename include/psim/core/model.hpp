@@ -29,12 +29,16 @@
 #ifndef PSIM_CORE_MODEL_HPP_
 #define PSIM_CORE_MODEL_HPP_
 
+#include <psim/core/checkpoint.hpp>
 #include <psim/core/configuration.hpp>
 #include <psim/core/state.hpp>
 #include <psim/core/state_field.hpp>
+#include <psim/core/thread_pool.hpp>
 
+#include <cstddef>
 #include <memory>
 #include <stdexcept>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -45,13 +49,45 @@ namespace psim {
  *  Every simulation relies on a model type to declare state fields, request
  *  state fields, and contain all the neccesary functionality to step the
  *  simulation forward in time.
+ *
+ *  A model within a model list may be scheduled to only step on some of the
+ *  list's ticks (see `schedule`). Models integrating over time must then
+ *  advance by `ticks` base timesteps each step.
  */
 class Model {
+ private:
+  /** @brief Number of enclosing model list ticks between steps.
+   */
+  std::size_t _period;
+
+  /** @brief Enclosing model list tick, modulo the period, the model steps on.
+   */
+  std::size_t _phase;
+
+  /** @brief Model list the model was added to (may be null).
+   */
+  Model const *_parent;
+
+  /** @brief Name the profiler attributes the model's steps to (empty until
+   *         first profiled).
+   */
+  mutable std::string _profile_name;
+
+  friend class ModelList;
+  friend class Profiler;
+
  protected:
   /** @brief Reference to the simulation's random number generator.
    */
   RandomsGenerator &_randoms;
 
+  /** @brief Step epoch of the model.
+   *
+   *  This is incremented every time the model steps. Lazy fields added by the
+   *  model are tied to this counter so they're all invalidated at once.
+   */
+  std::size_t _epoch;
+
   /** @brief Sets the model random number generator.
    *
    *  @param[in] randoms
@@ -136,12 +172,122 @@ class Model {
    */
   virtual void get_fields(State &state);
 
+  /** @brief Schedules the model to step on a subset of its model list's ticks.
+   *
+   *  @param[in] period Number of model list ticks between steps.
+   *  @param[in] phase  Model list tick, modulo the period, the model steps on.
+   *
+   *  By default, models step on every tick. A model list's first step is tick
+   *  zero so a model with period ten and phase zero steps on the first, 11th,
+   *  21st, etc. steps of its list. Lazy fields tied to the model's step epoch
+   *  keep their last value between steps.
+   *
+   *  Models should be scheduled by the model list adding them before the
+   *  simulation is constructed. If the period is zero or the phase isn't less
+   *  than the period, a runtime error will be thrown.
+   */
+  void schedule(std::size_t period, std::size_t phase = 0);
+
+  /** @return Number of model list ticks between steps.
+   */
+  std::size_t period() const;
+
+  /** @return Model list tick, modulo the period, the model steps on.
+   */
+  std::size_t phase() const;
+
+  /** @param[in] tick Model list tick.
+   *
+   *  @return True if the model steps on the given tick of its model list.
+   */
+  inline bool scheduled(std::size_t tick) const {
+    return _period == 1 || tick % _period == _phase;
+  }
+
+  /** @return Number of base ticks, those of the outermost model list, between
+   *          steps.
+   *
+   *  This is the product of the model's period and those of all enclosing
+   *  model lists.
+   */
+  std::size_t ticks() const;
+
+  /** @return Label distinguishing the model from other instances of its type,
+   *          for example the satellite it simulates.
+   *
+   *  The label is empty by default. Autocoded models return their arguments
+   *  separated by commas.
+   */
+  virtual std::string label() const;
+
   /** @brief The model steps forward.
    *
    *  This essentially is the update step that is responsible for updating state
-   *  fields values.
+   *  fields values. Derived models are expected to call this implementation
+   *  first in order to advance the model's step epoch.
    */
   virtual void step();
+
+  /** @return True if the model draws from the simulation's random number
+   *          generator and false otherwise.
+   *
+   *  Models sharing a random number generator can't be stepped concurrently.
+   *  Autocoded models draw from their own random streams instead (see
+   *  `RandomStream`) and never need to override this.
+   */
+  virtual bool draws_randoms() const;
+
+  /** @brief Allows the model to step its submodels on a thread pool.
+   *
+   *  @param[in] pool Thread pool.
+   *
+   *  This is called, if at all, after the model has gotten its fields. Models
+   *  without submodels ignore the pool.
+   */
+  virtual void parallelize(ThreadPool &pool);
+
+  /** @brief Removes submodels that don't contribute to a set of fields.
+   *
+   *  @param[in] state  Simulation state.
+   *  @param[in] fields Fields that must continue to be computed.
+   *
+   *  This is called, if at all, after the model has gotten its fields and
+   *  before the state is frozen. Fields added by removed submodels are removed
+   *  from the state. Models without submodels ignore this.
+   */
+  virtual void prune(
+      State &state, std::vector<StateFieldBase const *> const &fields);
+
+  /** @brief Writes the model's state to a checkpoint.
+   *
+   *  @param[in] checkpoint Checkpoint.
+   *
+   *  Models write the values of the fields they've added and any internal state
+   *  future steps depend on. Derived models are expected to call this
+   *  implementation first in order to write the model's step epoch.
+   */
+  virtual void checkpoint(Checkpoint &checkpoint) const;
+
+  /** @brief Restores the model's state from a checkpoint.
+   *
+   *  @param[in] reader Checkpoint reader.
+   *
+   *  Records are read in the order they were written. Derived models are
+   *  expected to call this implementation first and to reset the lazy fields
+   *  they've added.
+   */
+  virtual void restore(Checkpoint::Reader &reader);
+
+  /** @brief Rereads the model's configuration in place.
+   *
+   *  @param[in] config Simulation configuration.
+   *
+   *  Models update their parameters, the initial values of their initialized
+   *  fields, and the seeds of their random streams. No fields are added or
+   *  removed. This is called by `Simulation::reset` after the simulation has
+   *  been restored to its initial state.
+   */
+  virtual void configure(Configuration const &config);
 };
 } // namespace psim
 
@@ -0,0 +1,189 @@
+//
+// MIT License
+//
+// Copyright (c) 2020 Pathfinder for Autonomous Navigation (PAN)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/** @file psim/core/model_graph.hpp
+ *  @author Kyle Krol
+ */
+
+#ifndef PSIM_CORE_MODEL_GRAPH_HPP_
+#define PSIM_CORE_MODEL_GRAPH_HPP_
+
+#include <psim/core/model.hpp>
+#include <psim/core/state_field.hpp>
+#include <psim/core/state_field_lazy_base.hpp>
+#include <psim/core/thread_pool.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace psim {
+
+/** @brief Dataflow graph of a sequence of models used to step independent
+ *         models concurrently.
+ *
+ *  The graph is built from the fields each model adds and gets. Two models
+ *  conflict if one may write to something the other accesses; fields a model
+ *  adds or gets as writable are written to while any field it gets is read.
+ *  Conflicting models are stepped in the order they were given, which
+ *  guarantees the same results as stepping all models in sequence.
+ *
+ *  Reading a lazy field evaluates it using whatever its owner reads, so a model
+ *  getting a lazy field is considered to access everything the field's owner
+ *  accesses. Lazy fields which may be read concurrently are marked as shared.
+ *
+ *  Models drawing random numbers all share the simulation's generator and
+ *  therefore always conflict with one another.
+ */
+class ModelGraph {
+ public:
+  /** @brief Fields added and retrieved by a single model.
+   */
+  struct Footprint {
+    std::vector<StateFieldBase const *> adds;
+    std::vector<StateFieldBase const *> reads;
+    std::vector<StateFieldBase const *> writes;
+  };
+
+ private:
+  /** @brief Model and its position in the graph.
+   */
+  struct Node {
+    ModelGraph *graph;
+    Model *model;
+    std::vector<Node *> successors;
+    std::size_t predecessors;
+    std::atomic<std::size_t> remaining;
+  };
+
+  /** @brief Nodes in the order the models were given.
+   */
+  std::vector<std::unique_ptr<Node>> _nodes;
+
+  /** @brief Nodes without any predecessors.
+   */
+  std::vector<Node *> _roots;
+
+  /** @brief Lazy fields possibly read by multiple models.
+   */
+  std::vector<StateFieldLazyBase *> _lazies;
+
+  /** @brief Pool the graph is currently being stepped on.
+   */
+  ThreadPool *_pool;
+
+  /** @brief Tick the graph is currently being stepped on.
+   */
+  std::size_t _tick;
+
+  /** @brief Whether models not scheduled for the current tick are skipped.
+   */
+  bool _scheduled;
+
+  /** @brief Number of models yet to finish the current step.
+   */
+  std::atomic<std::size_t> _pending;
+
+  /** @brief First exception thrown by a model during the current step.
+   */
+  std::exception_ptr _exception;
+  std::mutex _exception_mutex;
+  std::atomic<bool> _failed;
+
+  /** @brief Steps a node's model and then any successors made ready by it.
+   *
+   *  @param[in] data Pointer to the node.
+   */
+  static void _run(void *data);
+
+  /** @brief Steps the graph on a thread pool.
+   *
+   *  @param[in] pool Thread pool.
+   */
+  void _step(ThreadPool &pool);
+
+ public:
+  ModelGraph();
+  ModelGraph(ModelGraph const &) = delete;
+  ModelGraph(ModelGraph &&) = delete;
+  ModelGraph &operator=(ModelGraph const &) = delete;
+  ModelGraph &operator=(ModelGraph &&) = delete;
+
+  virtual ~ModelGraph() = default;
+
+  /** @brief Builds the graph.
+   *
+   *  @param[in] models     Models in the order they're stepped in sequence.
+   *  @param[in] footprints Fields added and retrieved by each model.
+   *
+   *  If the number of models and footprints differ, a runtime error will be
+   *  thrown.
+   */
+  void build(std::vector<Model *> const &models,
+      std::vector<Footprint> const &footprints);
+
+  /** @return Number of models in the graph.
+   */
+  std::size_t size() const;
+
+  /** @param[in] i Index of the first model.
+   *  @param[in] j Index of the second model.
+   *
+   *  @return True if the first model must finish stepping before the second
+   *          starts. This relation isn't transitively closed.
+   */
+  bool precedes(std::size_t i, std::size_t j) const;
+
+  /** @brief Marks lazy fields possibly read by multiple models as shared.
+   *
+   *  This must be called before the graph is stepped on a thread pool.
+   */
+  void share();
+
+  /** @brief Steps all models on a thread pool.
+   *
+   *  @param[in] pool Thread pool.
+   *
+   *  The calling thread helps execute tasks until all models have stepped. If
+   *  a model throws, no further models are stepped and the exception is
+   *  rethrown here.
+   */
+  void step(ThreadPool &pool);
+
+  /** @brief Steps the models scheduled for a tick on a thread pool.
+   *
+   *  @param[in] pool Thread pool.
+   *  @param[in] tick Tick of the model list owning the graph.
+   *
+   *  Models not scheduled for the tick are skipped but still order the models
+   *  depending on them. See `Model::schedule` for more information.
+   */
+  void step(ThreadPool &pool, std::size_t tick);
+};
+} // namespace psim
+
+#endif
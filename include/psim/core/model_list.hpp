@@ -30,20 +30,83 @@
 #define PSIM_CORE_MODEL_LIST_HPP_
 
 #include <psim/core/model.hpp>
+#include <psim/core/model_graph.hpp>
+#include <psim/core/thread_pool.hpp>
 
 #include <memory>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
 namespace psim {
 
 /** @brief A model consisting of multiple models run in series.
+ *
+ *  The fields each model adds and gets are traced to build a dataflow graph of
+ *  the models. If given a thread pool, models that don't depend on one another
+ *  are stepped concurrently with the same results as stepping them in series.
+ *  See `ModelGraph` for more information.
+ *
+ *  Nested model lists are always stepped in series within a single task.
+ *
+ *  Each step of the model list is a tick and models only step on the ticks
+ *  they're scheduled for (see `Model::schedule`). This allows models with very
+ *  different natural rates (i.e. attitude dynamics and GPS) to share a
+ *  simulation without stepping everything at the fastest rate.
+ *
+ *  A model list can also be pruned down to the models that contribute to a set
+ *  of fields. Starting from those fields, a model is kept if it adds or writes
+ *  to a needed field and everything a kept model reads or writes is needed in
+ *  turn. Nested model lists are pruned model by model. Models drawing from the
+ *  simulation's random number generator are always kept so the numbers drawn
+ *  by the remaining models don't change.
  */
 class ModelList : public Model {
  private:
   /** @brief Model list.
    */
-  std::vector<std::unique_ptr<Model>> _models;
+  std::vector<Model *> _models;
+
+  /** @brief Models allocated and owned by the model list.
+   */
+  std::vector<std::unique_ptr<Model>> _owned;
+
+  /** @brief Fields added and retrieved by each model.
+   */
+  std::vector<ModelGraph::Footprint> _footprints;
+
+  /** @brief Whether each model contributes to the fields being pruned for.
+   */
+  std::vector<bool> _needed;
+
+  /** @brief Dataflow graph of the models.
+   */
+  ModelGraph _graph;
+
+  /** @brief Thread pool models are stepped on (may be null).
+   */
+  ThreadPool *_pool;
+
+  /** @brief Builds the dataflow graph from the models and their footprints.
+   */
+  void _build();
+
+  /** @brief Marks the models contributing to a set of fields.
+   *
+   *  @param[inout] fields Needed fields. Fields read or written by marked
+   *                       models are inserted.
+   *
+   *  @return True if any model was marked and false otherwise.
+   */
+  bool _require(std::unordered_set<StateFieldBase const *> &fields);
+
+  /** @brief Removes models that weren't marked along with their fields.
+   *
+   *  @param[in]    state   Simulation state.
+   *  @param[inout] removed Fields removed from the state are inserted.
+   */
+  void _prune(
+      State &state, std::unordered_set<StateFieldBase const *> &removed);
 
  protected:
   ModelList(RandomsGenerator &randoms);
@@ -60,7 +123,19 @@ class ModelList : public Model {
    */
   template <class C, typename... Ts>
   void add(Ts &&... ts) {
-    _models.push_back(std::make_unique<C>(std::forward<Ts>(ts)...));
+    _owned.push_back(std::make_unique<C>(std::forward<Ts>(ts)...));
+    add(*_owned.back());
+  }
+
+  /** @brief Adds a model owned by a derived model list.
+   *
+   *  @param[in] model Model which must outlive the model list.
+   *
+   *  See `StaticModelList` for more information.
+   */
+  void add(Model &model) {
+    model._parent = this;
+    _models.push_back(&model);
   }
 
  public:
@@ -79,9 +154,55 @@ class ModelList : public Model {
    */
   virtual void get_fields(State &state) override;
 
-  /** @brief All models step forward.
+  /** @brief All models scheduled for the current tick step forward.
    */
   virtual void step() override;
+
+  /** @return True if any model draws from the simulation's random number
+   *          generator and false otherwise.
+   */
+  virtual bool draws_randoms() const override;
+
+  /** @brief Steps independent models concurrently on a thread pool from now
+   *         on.
+   *
+   *  @param[in] pool Thread pool.
+   */
+  virtual void parallelize(ThreadPool &pool) override;
+
+  /** @brief Removes models that don't contribute to a set of fields.
+   *
+   *  @param[in] state  Simulation state.
+   *  @param[in] fields Fields that must continue to be computed.
+   */
+  virtual void prune(State &state,
+      std::vector<StateFieldBase const *> const &fields) override;
+
+  /** @brief All models write their state to a checkpoint in order.
+   *
+   *  @param[in] checkpoint Checkpoint.
+   */
+  virtual void checkpoint(Checkpoint &checkpoint) const override;
+
+  /** @brief All models restore their state from a checkpoint in order.
+   *
+   *  @param[in] reader Checkpoint reader.
+   */
+  virtual void restore(Checkpoint::Reader &reader) override;
+
+  /** @brief All models reread the configuration.
+   *
+   *  @param[in] config Simulation configuration.
+   */
+  virtual void configure(Configuration const &config) override;
+
+  /** @return Models in the order they're stepped.
+   */
+  std::vector<Model *> const &models() const;
+
+  /** @return Dataflow graph of the models.
+   */
+  ModelGraph const &graph() const;
 };
 } // namespace psim
 
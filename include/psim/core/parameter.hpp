@@ -31,6 +31,7 @@
 
 #include <psim/core/castable_base.hpp>
 #include <psim/core/nameable.hpp>
+#include <psim/core/types.hpp>
 
 #include <utility>
 
@@ -41,15 +42,19 @@ class Parameter;
 
 /** @brief Virtual base class for all parameters.
  *
- *  The main purpose of this class is to allow dynamic casting to be used to
- *  check parameter types at runtime and provide helpful casting functions.
+ *  The main purpose of this class is to allow parameter types to be checked at
+ *  runtime, via their type tag, and provide helpful casting functions.
  */
 class ParameterBase : public virtual Nameable, public CastableBase<Parameter> {
  protected:
   ParameterBase() = default;
 
+  template <typename T>
+  ParameterBase(Parameter<T> *derived) : CastableBase<Parameter>(derived) {}
+
  public:
   using CastableBase<Parameter>::cast;
+  using CastableBase<Parameter>::tag;
 
   virtual ~ParameterBase() = default;
 
@@ -95,7 +100,7 @@ class Parameter : public ParameterBase {
    *
    *  https://stackoverflow.com/questions/2417065/does-the-default-constructor-initialize-built-in-types
    */
-  Parameter() : Nameable("", "parameter"), _value() {}
+  Parameter() : Nameable("", "parameter"), ParameterBase(this), _value() {}
 
   /** @brief Default constructs the parameter's value.
    *
@@ -103,10 +108,11 @@ class Parameter : public ParameterBase {
    *
    *  @{
    */
-  Parameter(std::string const &name) : Nameable(name, "parameter"), _value() {}
+  Parameter(std::string const &name)
+    : Nameable(name, "parameter"), ParameterBase(this), _value() {}
 
   Parameter(std::string &&name)
-    : Nameable(std::move(name), "parameter"), _value() {}
+    : Nameable(std::move(name), "parameter"), ParameterBase(this), _value() {}
   /** @}
    */
 
@@ -114,9 +120,12 @@ class Parameter : public ParameterBase {
    *
    *  @{
    */
-  Parameter(T const &value) : Nameable("", "parameter"), _value(value) {}
+  Parameter(T const &value)
+    : Nameable("", "parameter"), ParameterBase(this), _value(value) {}
 
-  Parameter(T &&value) : Nameable("", "parameter"), _value(std::move(value)) {}
+  Parameter(T &&value)
+    : Nameable("", "parameter"), ParameterBase(this),
+      _value(std::move(value)) {}
   /** @}
    */
 
@@ -126,16 +135,19 @@ class Parameter : public ParameterBase {
    *  @{
    */
   Parameter(std::string const &name, T const &value)
-    : Nameable(name, "parameter"), _value(value) {}
+    : Nameable(name, "parameter"), ParameterBase(this), _value(value) {}
 
   Parameter(std::string &&name, T const &value)
-    : Nameable(std::move(name), "parameter"), _value(value) {}
+    : Nameable(std::move(name), "parameter"), ParameterBase(this),
+      _value(value) {}
 
   Parameter(std::string const &name, T &&value)
-    : Nameable(name, "parameter"), _value(std::move(value)) {}
+    : Nameable(name, "parameter"), ParameterBase(this),
+      _value(std::move(value)) {}
 
   Parameter(std::string &&name, T &&value)
-    : Nameable(std::move(name), "parameter"), _value(std::move(value)) {}
+    : Nameable(std::move(name), "parameter"), ParameterBase(this),
+      _value(std::move(value)) {}
   /** @}
    */
 
@@ -0,0 +1,210 @@
+//
+// MIT License
+//
+// Copyright (c) 2020 Pathfinder for Autonomous Navigation (PAN)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/** @file psim/core/profiler.hpp
+ *  @author Kyle Krol
+ */
+
+#ifndef PSIM_CORE_PROFILER_HPP_
+#define PSIM_CORE_PROFILER_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace psim {
+
+class Model;
+
+/** @brief Process wide profiler for model steps and lazy field evaluations.
+ *
+ *  When enabled, every model step and lazy field evaluation is timed along with
+ *  its nesting depth and the thread it ran on. Models are attributed to their
+ *  type name followed by their label, if any, and lazy fields to their field
+ *  name. Events are aggregated per model instance or field so instances of
+ *  the same type are never merged. The events can be summarized
+ *  into a report or exported as a Chrome trace, which can be opened in
+ *  Perfetto or `chrome://tracing`.
+ *
+ *  The profiler is disabled by default in which case instrumented code only
+ *  checks an atomic flag. Events are buffered per thread so concurrently
+ *  stepped models don't contend with one another.
+ */
+class Profiler {
+ public:
+  class Scope;
+
+  /** @brief Timed section of code.
+   */
+  struct Event {
+    /** @brief Event category ("simulation", "model", or "field").
+     */
+    char const *category;
+
+    /** @brief Model type and label or field name.
+     */
+    std::string name;
+
+    /** @brief Model or field the event timed.
+     */
+    void const *instance;
+
+    /** @brief Profiler assigned index of the thread the event ran on.
+     */
+    std::size_t thread;
+
+    /** @brief Number of enclosing events on the same thread.
+     */
+    std::size_t depth;
+
+    /** @brief Start time in nanoseconds since the profiler was cleared.
+     */
+    std::int64_t begin;
+
+    /** @brief Duration in nanoseconds.
+     */
+    std::int64_t duration;
+
+    /** @brief Duration excluding nested events in nanoseconds.
+     */
+    std::int64_t self;
+  };
+
+  /** @brief Aggregate statistics of all events timing the same model or
+   *         field.
+   */
+  struct Summary {
+    char const *category;
+    std::string name;
+    std::size_t calls;
+    std::int64_t total;
+    std::int64_t self;
+  };
+
+ private:
+  /** @brief Whether events are currently being recorded.
+   */
+  static std::atomic<bool> _enabled;
+
+  /** @brief Starts an event on the current thread.
+   *
+   *  @return Start time.
+   */
+  static std::int64_t _enter();
+
+  /** @brief Finishes the current thread's innermost event.
+   */
+  static void _exit(char const *category, std::string const &name,
+      void const *instance, std::int64_t begin);
+
+  /** @return Cached type name and label of a model.
+   */
+  static std::string const &_model_name(Model const &model);
+
+ public:
+  Profiler() = delete;
+
+  /** @brief Starts recording events.
+   */
+  static void enable();
+
+  /** @brief Stops recording events. Recorded events are kept.
+   */
+  static void disable();
+
+  /** @return True if events are being recorded and false otherwise.
+   */
+  inline static bool enabled() {
+    return _enabled.load(std::memory_order_relaxed);
+  }
+
+  /** @brief Discards all recorded events and restarts the profiler's clock.
+   *
+   *  This must not be called while instrumented code is running.
+   */
+  static void clear();
+
+  /** @return All recorded events ordered by thread and then by the time they
+   *          finished.
+   */
+  static std::vector<Event> events();
+
+  /** @return Statistics of the recorded events sorted by decreasing self time.
+   */
+  static std::vector<Summary> summary();
+
+  /** @return Human readable table of the summary.
+   */
+  static std::string report();
+
+  /** @brief Saves the recorded events as a Chrome trace.
+   *
+   *  @param[in] file JSON file.
+   *
+   *  If the file can't be written, a runtime error will be thrown.
+   */
+  static void save(std::string const &file);
+};
+
+/** @brief Times the enclosing block if the profiler is enabled.
+ */
+class Profiler::Scope {
+ private:
+  char const *const _category;
+  std::string const *const _name;
+  void const *const _instance;
+  std::int64_t const _begin;
+
+ public:
+  Scope() = delete;
+  Scope(Scope const &) = delete;
+  Scope(Scope &&) = delete;
+  Scope &operator=(Scope const &) = delete;
+  Scope &operator=(Scope &&) = delete;
+
+  /** @param[in] category Event category which must be a string literal.
+   *  @param[in] name     Event name which must outlive the scope.
+   *
+   *  The name's address identifies the timed instance.
+   */
+  inline Scope(char const *category, std::string const &name)
+    : _category(category), _name(enabled() ? &name : nullptr),
+      _instance(&name), _begin(_name ? _enter() : 0) {}
+
+  /** @param[in] model Model being stepped.
+   */
+  inline Scope(Model const &model)
+    : _category("model"), _name(enabled() ? &_model_name(model) : nullptr),
+      _instance(&model), _begin(_name ? _enter() : 0) {}
+
+  inline ~Scope() {
+    if (_name)
+      _exit(_category, *_name, _instance, _begin);
+  }
+};
+} // namespace psim
+
+#endif
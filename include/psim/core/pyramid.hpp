@@ -0,0 +1,265 @@
+//
+// MIT License
+//
+// Copyright (c) 2020 Pathfinder for Autonomous Navigation (PAN)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/** @file psim/core/pyramid.hpp
+ *  @author Kyle Krol
+ */
+
+#ifndef PSIM_CORE_PYRAMID_HPP_
+#define PSIM_CORE_PYRAMID_HPP_
+
+#include <psim/core/state.hpp>
+#include <psim/core/state_field.hpp>
+#include <psim/core/telemetry.hpp>
+#include <psim/core/types.hpp>
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace psim {
+
+/** @brief Records state field values at several levels of detail over the
+ *         course of a simulation.
+ *
+ *  Fields are split into columns as they are by a `Recorder` except every
+ *  column is stored as reals. Samples are grouped into buckets and the minimum,
+ *  maximum, and mean of each column is kept per bucket. The finest level has
+ *  `bucket` samples per bucket and every coarser level combines `factor`
+ *  buckets of the level below it. All levels are updated online as samples are
+ *  recorded so the cost per sample is constant.
+ *
+ *  Plots spanning a long run can therefore be drawn from a coarse level with
+ *  few points while the minimum and maximum still show short transients a
+ *  plain decimation would skip over. Only complete buckets are visible until
+ *  the pyramid is closed which flushes the partial bucket at the end of every
+ *  level. As with a `Recorder`, recording more buckets may reallocate the
+ *  underlying buffers.
+ */
+class Pyramid : public TelemetrySink {
+ private:
+  /** @brief Recorded field and the index of its first column.
+   */
+  struct Entry {
+    StateFieldBase const *field;
+    TypeTag tag;
+    std::size_t column;
+  };
+
+  /** @brief Running statistics of a single column within a bucket.
+   */
+  struct Bucket {
+    Real min;
+    Real max;
+    Real sum;
+  };
+
+  /** @brief Single level of detail.
+   */
+  struct Level {
+    /** @brief Number of samples per bucket.
+     */
+    std::size_t bucket;
+
+    /** @brief Inputs accumulated into the pending bucket.
+     */
+    std::size_t count;
+
+    /** @brief Pending bucket of each column.
+     */
+    std::vector<Bucket> pending;
+
+    /** @brief Complete buckets' statistics of each column.
+     */
+    std::vector<std::vector<Real>> min, max, mean;
+  };
+
+  /** @brief Record every `_decimation` steps.
+   */
+  std::size_t _decimation;
+
+  /** @brief Steps since the last recorded sample.
+   */
+  std::size_t _n;
+
+  /** @brief Number of buckets of a level combined by the next level.
+   */
+  std::size_t _factor;
+
+  /** @brief Number of samples recorded.
+   */
+  std::size_t _size;
+
+  /** @brief Recorded fields.
+   */
+  std::vector<Entry> _entries;
+
+  /** @brief Column names in the order they were created.
+   */
+  std::vector<std::string> _columns;
+
+  /** @brief Map from column names to column indices.
+   */
+  std::unordered_map<std::string, std::size_t> _locations;
+
+  /** @brief Levels from finest to coarsest.
+   */
+  std::vector<Level> _levels;
+
+  /** @brief Sample being recorded treated as a bucket of one.
+   */
+  std::vector<Bucket> _sample;
+
+  /** @brief True once the partial buckets have been flushed.
+   */
+  bool _closed;
+
+  /** @brief Combines buckets into the pending bucket of a level and completes
+   *         it once enough inputs have been added.
+   */
+  void _add(std::size_t level, std::vector<Bucket> const &buckets,
+      std::size_t inputs);
+
+  std::size_t _column(std::string const &name) const;
+
+  Level const &_level(std::size_t level) const;
+
+  /** @return Number of buckets of the given size covering the samples.
+   */
+  std::size_t _buckets(std::size_t samples, std::size_t bucket) const;
+
+ public:
+  Pyramid() = delete;
+  Pyramid(Pyramid const &) = delete;
+  Pyramid(Pyramid &&) = delete;
+  Pyramid &operator=(Pyramid const &) = delete;
+  Pyramid &operator=(Pyramid &&) = delete;
+
+  virtual ~Pyramid() = default;
+
+  /** @param[in] state      Simulation state.
+   *  @param[in] fields     Names of the fields to record.
+   *  @param[in] bucket     Number of samples per bucket on the finest level.
+   *  @param[in] factor     Number of buckets combined by each coarser level.
+   *  @param[in] levels     Number of levels.
+   *  @param[in] decimation Record a sample every `decimation` steps.
+   *
+   *  If a field doesn't exist, has an unsupported type, or is listed more than
+   *  once, the bucket size, number of levels, or decimation is zero, or the
+   *  factor is less than two, a runtime error will be thrown.
+   */
+  Pyramid(State const &state, std::vector<std::string> const &fields,
+      std::size_t bucket = 16, std::size_t factor = 4, std::size_t levels = 6,
+      std::size_t decimation = 1);
+
+  /** @brief Signals a simulation step was taken.
+   *
+   *  A sample is recorded every `decimation` calls.
+   */
+  virtual void step() override;
+
+  /** @brief Flushes the partial bucket at the end of every level.
+   *
+   *  The flushed buckets' means are taken over the samples they hold. The
+   *  pyramid is kept in memory.
+   */
+  virtual void close() override;
+
+  /** @brief Records a sample of all fields unconditionally.
+   *
+   *  If the pyramid has been closed, a runtime error will be thrown.
+   */
+  void record();
+
+  /** @return Number of samples recorded.
+   */
+  std::size_t size() const;
+
+  /** @return Column names in the order they were created.
+   */
+  std::vector<std::string> const &columns() const;
+
+  /** @param[in] name Column name.
+   *
+   *  @return True if the column exists and false otherwise.
+   */
+  bool has(std::string const &name) const;
+
+  /** @return Number of levels.
+   */
+  std::size_t levels() const;
+
+  /** @param[in] level Level index where zero is the finest.
+   *
+   *  @return Number of samples per bucket.
+   *
+   *  If the level is out of bounds, a runtime error will be thrown.
+   */
+  std::size_t bucket(std::size_t level) const;
+
+  /** @param[in] level Level index where zero is the finest.
+   *
+   *  @return Number of complete buckets, including the partial bucket
+   *          flushed on close.
+   *
+   *  If the level is out of bounds, a runtime error will be thrown.
+   */
+  std::size_t size(std::size_t level) const;
+
+  /** @brief Selects the level to draw a window of samples from.
+   *
+   *  @param[in] samples Number of samples in the window.
+   *  @param[in] points  Maximum number of buckets wanted.
+   *
+   *  @return Finest level covering the window with at most `points` buckets or
+   *          the coarsest level if none do.
+   *
+   *  A trailing partial bucket is only counted once the pyramid is closed.
+   */
+  std::size_t select(std::size_t samples, std::size_t points) const;
+
+  /** @param[in] name  Column name.
+   *  @param[in] level Level index where zero is the finest.
+   *
+   *  @return Pointer to the per bucket statistic of a column. Bucket `i`
+   *          covers samples `i * bucket(level)` up to `(i + 1) *
+   *          bucket(level)`.
+   *
+   *  If no such column exists or the level is out of bounds, a runtime error
+   *  will be thrown.
+   *
+   *  @{
+   */
+  Real const *min(std::string const &name, std::size_t level) const;
+
+  Real const *max(std::string const &name, std::size_t level) const;
+
+  Real const *mean(std::string const &name, std::size_t level) const;
+  /** @}
+   */
+};
+} // namespace psim
+
+#endif
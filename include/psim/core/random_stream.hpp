@@ -0,0 +1,159 @@
+//
+// MIT License
+//
+// Copyright (c) 2020 Pathfinder for Autonomous Navigation (PAN)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/** @file psim/core/random_stream.hpp
+ *  @author Kyle Krol
+ */
+
+#ifndef PSIM_CORE_RANDOM_STREAM_HPP_
+#define PSIM_CORE_RANDOM_STREAM_HPP_
+
+#include <psim/core/checkpoint.hpp>
+#include <psim/core/types.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace psim {
+
+/** @brief Counter based stream of random numbers.
+ *
+ *  Random numbers are generated with the Philox4x32-10 block cipher. The key is
+ *  derived from the simulation's seed, the name of the model owning the
+ *  stream, and the stream's name while the counter holds the owning model's
+ *  step epoch and the number of draws made so far in that step.
+ *
+ *  The numbers drawn by a model therefore only depend on the seed, which step
+ *  the model is on, and the model's own sequence of draws. They don't depend
+ *  on the order other models step in, the order lazy fields are evaluated in,
+ *  or the number of threads a simulation is stepped with.
+ */
+class RandomStream {
+ public:
+  /** @brief Philox key type.
+   */
+  using Key = std::array<std::uint32_t, 2>;
+
+  /** @brief Philox counter and output block type.
+   */
+  using Block = std::array<std::uint32_t, 4>;
+
+ private:
+  /** @brief Key derived from the seed, model, and stream name.
+   */
+  Key _key;
+
+  /** @brief Epoch counter the stream is tied to (may be null).
+   */
+  std::size_t const *const _epoch;
+
+  /** @brief Epoch the draw counter corresponds to.
+   */
+  std::size_t _step;
+
+  /** @brief Number of draws made in the current epoch.
+   */
+  std::uint64_t _draws;
+
+  /** @return Next block of random bits.
+   */
+  Block _next();
+
+ public:
+  RandomStream() = delete;
+  RandomStream(RandomStream const &) = default;
+  RandomStream(RandomStream &&) = default;
+  RandomStream &operator=(RandomStream const &) = delete;
+  RandomStream &operator=(RandomStream &&) = delete;
+
+  /** @param[in] seed  Simulation seed.
+   *  @param[in] model Name of the model owning the stream.
+   *  @param[in] name  Name of the stream.
+   *  @param[in] epoch Optional epoch counter the stream is tied to.
+   */
+  RandomStream(Integer seed, std::string const &model, std::string const &name,
+      std::size_t const *epoch = nullptr);
+
+  /** @brief Evaluates the Philox4x32-10 block cipher.
+   *
+   *  @param[in] key     Key.
+   *  @param[in] counter Counter.
+   *
+   *  @return Block of random bits.
+   */
+  static Block philox(Key key, Block counter);
+
+  /** @brief Rekeys the stream and rewinds it to the start of the epoch.
+   *
+   *  @param[in] seed  Simulation seed.
+   *  @param[in] model Name of the model owning the stream.
+   *  @param[in] name  Name of the stream.
+   */
+  void reseed(Integer seed, std::string const &model, std::string const &name);
+
+  /** @brief Writes the stream's position to a checkpoint.
+   *
+   *  @param[in] checkpoint Checkpoint.
+   *  @param[in] name       Record name.
+   *
+   *  The key isn't written. Restoring into a simulation with a different seed
+   *  continues from the same position with different numbers.
+   */
+  void checkpoint(Checkpoint &checkpoint, std::string const &name) const;
+
+  /** @brief Restores the stream's position from a checkpoint.
+   *
+   *  @param[in] reader Checkpoint reader.
+   *  @param[in] name   Record name.
+   */
+  void restore(Checkpoint::Reader &reader, std::string const &name);
+
+  /** @return Uniformly distributed random number in (0, 1).
+   */
+  Real rand();
+
+  /** @return Normally distributed random number with zero mean and unit
+   *          variance.
+   */
+  Real gaussian();
+
+  /** @tparam T Vector or matrix type.
+   *
+   *  @return Vector or matrix of normally distributed random numbers with zero
+   *          mean and unit variance.
+   */
+  template <typename T>
+  T gaussians() {
+    T t;
+    for (lin::size_t i = 0; i < t.size(); i++)
+      t(i) = gaussian();
+
+    return t;
+  }
+};
+} // namespace psim
+
+#endif
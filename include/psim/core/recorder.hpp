@@ -0,0 +1,226 @@
+//
+// MIT License
+//
+// Copyright (c) 2020 Pathfinder for Autonomous Navigation (PAN)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/** @file psim/core/recorder.hpp
+ *  @author Kyle Krol
+ */
+
+#ifndef PSIM_CORE_RECORDER_HPP_
+#define PSIM_CORE_RECORDER_HPP_
+
+#include <psim/core/state.hpp>
+#include <psim/core/state_field.hpp>
+#include <psim/core/types.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace psim {
+
+/** @brief Records state field values into columnar buffers over the course of a
+ *         simulation.
+ *
+ *  Each scalar field is recorded into a single column named after the field.
+ *  Vector fields are split into one column per component with the suffixes
+ *  '.x', '.y', '.z', and '.w' appended to the field name. Boolean and real
+ *  valued columns are stored as reals while integer columns keep their integer
+ *  type to avoid losing precision on fields like 'truth.t.ns'.
+ *
+ *  Columns are contiguous in memory which allows them to be handed off to
+ *  other consumers (i.e. numpy) without copying. Each column is held in a
+ *  shared buffer (see `real_buffer` and `integer_buffer`). Samples in a buffer
+ *  held outside the recorder are never moved or overwritten; when such a
+ *  buffer is full or the recorder is cleared, the column continues in a new
+ *  buffer instead. Unshared buffers are grown and reused in place.
+ */
+class Recorder {
+ private:
+  /** @brief Recorded field and the index of its first column.
+   */
+  struct Entry {
+    StateFieldBase const *field;
+    TypeTag tag;
+    std::size_t column;
+  };
+
+  /** @brief Location of a named column.
+   */
+  struct Location {
+    bool is_integer;
+    std::size_t column;
+  };
+
+  /** @brief Record every `_decimation` steps.
+   */
+  std::size_t _decimation;
+
+  /** @brief Steps since the last recorded sample.
+   */
+  std::size_t _n;
+
+  /** @brief Number of samples recorded.
+   */
+  std::size_t _size;
+
+  /** @brief Recorded fields.
+   */
+  std::vector<Entry> _entries;
+
+  /** @brief Column names in the order they were created.
+   */
+  std::vector<std::string> _columns;
+
+  /** @brief Map from column names to column locations.
+   */
+  std::unordered_map<std::string, Location> _locations;
+
+  /** @brief Real valued columns.
+   */
+  std::vector<std::shared_ptr<std::vector<Real>>> _reals;
+
+  /** @brief Integer valued columns.
+   */
+  std::vector<std::shared_ptr<std::vector<Integer>>> _integers;
+
+  void _add_column(std::string const &name, bool is_integer);
+
+  void _record(Entry const &entry, StateFieldBase const *field);
+
+ public:
+  Recorder() = delete;
+  Recorder(Recorder const &) = delete;
+  Recorder(Recorder &&) = default;
+  Recorder &operator=(Recorder const &) = delete;
+  Recorder &operator=(Recorder &&) = default;
+
+  ~Recorder() = default;
+
+  /** @param[in] state      Simulation state.
+   *  @param[in] fields     Names of the fields to record.
+   *  @param[in] decimation Record a sample every `decimation` steps.
+   *  @param[in] capacity   Number of samples to preallocate.
+   *
+   *  If a field doesn't exist, has an unsupported type, or the decimation is
+   *  zero, a runtime error will be thrown.
+   */
+  Recorder(State const &state, std::vector<std::string> const &fields,
+      std::size_t decimation = 1, std::size_t capacity = 0);
+
+  /** @brief Signals a simulation step was taken.
+   *
+   *  A sample is recorded every `decimation` calls.
+   */
+  void step();
+
+  /** @brief Records a sample of all fields unconditionally.
+   */
+  void record();
+
+  /** @brief Records a sample of all fields from another state.
+   *
+   *  @param[in] state Simulation state.
+   *
+   *  Fields are looked up by name which allows samples to be gathered from many
+   *  simulations of the same model (i.e. the members of an ensemble). If a
+   *  field doesn't exist or its type differs from the original field's, a
+   *  runtime error will be thrown.
+   */
+  void record(State const &state);
+
+  /** @brief Discards all recorded samples while keeping the allocated buffers.
+   */
+  void clear();
+
+  /** @return Number of samples recorded.
+   */
+  std::size_t size() const;
+
+  /** @return Decimation factor.
+   */
+  std::size_t decimation() const;
+
+  /** @return Column names in the order they were created.
+   */
+  std::vector<std::string> const &columns() const;
+
+  /** @param[in] name Column name.
+   *
+   *  @return True if the column exists and false otherwise.
+   */
+  bool has(std::string const &name) const;
+
+  /** @param[in] name Column name.
+   *
+   *  @return True if the column holds integers and false otherwise.
+   *
+   *  If no such column exists, a runtime error will be thrown.
+   */
+  bool is_integer(std::string const &name) const;
+
+  /** @param[in] name Column name.
+   *
+   *  @return Pointer to the start of a real valued column.
+   *
+   *  If no such real valued column exists, a runtime error will be thrown.
+   *  The pointer is invalidated by the next sample or clear.
+   */
+  Real const *reals(std::string const &name) const;
+
+  /** @param[in] name Column name.
+   *
+   *  @return Pointer to the start of an integer valued column.
+   *
+   *  If no such integer valued column exists, a runtime error will be thrown.
+   *  The pointer is invalidated by the next sample or clear.
+   */
+  Integer const *integers(std::string const &name) const;
+
+  /** @param[in] name Column name.
+   *
+   *  @return Buffer holding a real valued column.
+   *
+   *  The buffer's first `size()` elements are the column's samples and remain
+   *  valid, and unchanged, for as long as the buffer is held. Later samples
+   *  are appended to the same buffer while it has spare capacity. If no such
+   *  real valued column exists, a runtime error will be thrown.
+   */
+  std::shared_ptr<std::vector<Real> const> real_buffer(
+      std::string const &name) const;
+
+  /** @param[in] name Column name.
+   *
+   *  @return Buffer holding an integer valued column.
+   *
+   *  See `real_buffer` for more information. If no such integer valued column
+   *  exists, a runtime error will be thrown.
+   */
+  std::shared_ptr<std::vector<Integer> const> integer_buffer(
+      std::string const &name) const;
+};
+} // namespace psim
+
+#endif
@@ -0,0 +1,214 @@
+//
+// MIT License
+//
+// Copyright (c) 2020 Pathfinder for Autonomous Navigation (PAN)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/** @file psim/core/ring_buffer.hpp
+ *  @author Kyle Krol
+ */
+
+#ifndef PSIM_CORE_RING_BUFFER_HPP_
+#define PSIM_CORE_RING_BUFFER_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+namespace psim {
+
+/** @brief Lock free, single producer and single consumer ring buffer of fixed
+ *         width rows.
+ *
+ *  @tparam T Trivially copyable element type.
+ *
+ *  This is the concurrent counterpart of `gnc::CircularBuffer`. One thread may
+ *  push rows while another pops them without either ever blocking. The
+ *  producer may also drop the oldest row to make room for a new one, in which
+ *  case a consumer concurrently copying that row detects it and discards the
+ *  copy.
+ *
+ *  Elements are stored as relaxed atomics so a row being overwritten while it's
+ *  copied is never a data race. Publishing and consuming rows is ordered by the
+ *  head and tail counters.
+ */
+template <typename T>
+class RingBuffer {
+  static_assert(std::is_trivially_copyable<T>::value,
+      "Ring buffer elements must be trivially copyable");
+
+ private:
+  /** @brief Number of rows, always a power of two.
+   */
+  std::size_t _capacity;
+
+  /** @brief Number of elements per row.
+   */
+  std::size_t _width;
+
+  /** @brief Row storage.
+   */
+  std::unique_ptr<std::atomic<T>[]> _data;
+
+  /** @brief Index of the next row to be popped.
+   */
+  alignas(64) std::atomic<std::size_t> _head;
+
+  /** @brief Index of the next row to be pushed.
+   */
+  alignas(64) std::atomic<std::size_t> _tail;
+
+  /** @brief Copies a row into its slot.
+   */
+  void _store(std::size_t i, T const *row) {
+    auto *const slot = &_data[(i & (_capacity - 1)) * _width];
+    for (std::size_t j = 0; j < _width; j++)
+      slot[j].store(row[j], std::memory_order_relaxed);
+  }
+
+  /** @brief Copies a row out of its slot.
+   */
+  void _load(std::size_t i, T *row) const {
+    auto const *const slot = &_data[(i & (_capacity - 1)) * _width];
+    for (std::size_t j = 0; j < _width; j++)
+      row[j] = slot[j].load(std::memory_order_relaxed);
+  }
+
+ public:
+  RingBuffer() = delete;
+  RingBuffer(RingBuffer const &) = delete;
+  RingBuffer(RingBuffer &&) = delete;
+  RingBuffer &operator=(RingBuffer const &) = delete;
+  RingBuffer &operator=(RingBuffer &&) = delete;
+
+  ~RingBuffer() = default;
+
+  /** @param[in] capacity Minimum number of rows, rounded up to a power of two.
+   *  @param[in] width    Number of elements per row.
+   *
+   *  If the capacity or width is zero, a runtime error will be thrown.
+   */
+  RingBuffer(std::size_t capacity, std::size_t width = 1)
+    : _capacity(1), _width(width), _head(0), _tail(0) {
+    if (capacity == 0 || width == 0)
+      throw std::runtime_error(
+          "Ring buffer capacity and width must be greater than zero");
+
+    while (_capacity < capacity)
+      _capacity <<= 1;
+    _data.reset(new std::atomic<T>[_capacity * _width]);
+  }
+
+  /** @return Maximum number of rows.
+   */
+  std::size_t capacity() const {
+    return _capacity;
+  }
+
+  /** @return Number of elements per row.
+   */
+  std::size_t width() const {
+    return _width;
+  }
+
+  /** @return Number of rows currently held.
+   *
+   *  The value may be stale by the time it's used if the other thread is
+   *  active.
+   */
+  std::size_t size() const {
+    auto const head = _head.load(std::memory_order_acquire);
+    auto const tail = _tail.load(std::memory_order_acquire);
+    return tail - head;
+  }
+
+  /** @brief Appends a row if there is room for it.
+   *
+   *  @param[in] row Row of `width()` elements.
+   *
+   *  @return True if the row was pushed and false if the buffer was full.
+   *
+   *  May only be called from the producer thread.
+   */
+  bool push(T const *row) {
+    auto const tail = _tail.load(std::memory_order_relaxed);
+    if (tail - _head.load(std::memory_order_acquire) == _capacity)
+      return false;
+
+    _store(tail, row);
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /** @brief Appends a row dropping the oldest row if the buffer is full.
+   *
+   *  @param[in] row Row of `width()` elements.
+   *
+   *  @return True if a row was dropped to make room and false otherwise.
+   *
+   *  May only be called from the producer thread.
+   */
+  bool push_overwrite(T const *row) {
+    auto const tail = _tail.load(std::memory_order_relaxed);
+    auto head = _head.load(std::memory_order_acquire);
+
+    // If the consumer pops the oldest row first there is room anyways
+    auto const dropped = tail - head == _capacity &&
+                         _head.compare_exchange_strong(
+                             head, head + 1, std::memory_order_acq_rel);
+
+    _store(tail, row);
+    _tail.store(tail + 1, std::memory_order_release);
+    return dropped;
+  }
+
+  /** @brief Removes up to `n` of the oldest rows.
+   *
+   *  @param[out] rows Array of at least `n * width()` elements.
+   *  @param[in]  n    Maximum number of rows to pop.
+   *
+   *  @return Number of rows popped.
+   *
+   *  May only be called from the consumer thread.
+   */
+  std::size_t pop(T *rows, std::size_t n = 1) {
+    auto head = _head.load(std::memory_order_acquire);
+    while (true) {
+      auto const tail = _tail.load(std::memory_order_acquire);
+      auto const count = tail - head < n ? tail - head : n;
+      if (count == 0)
+        return 0;
+
+      for (std::size_t i = 0; i < count; i++)
+        _load(head + i, rows + i * _width);
+
+      // Fails if the producer dropped rows while they were copied
+      if (_head.compare_exchange_weak(head, head + count,
+              std::memory_order_acq_rel, std::memory_order_acquire))
+        return count;
+    }
+  }
+};
+} // namespace psim
+
+#endif
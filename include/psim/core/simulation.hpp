@@ -29,8 +29,24 @@
 #ifndef PSIM_CORE_SIMULATION_HPP_
 #define PSIM_CORE_SIMULATION_HPP_
 
+#include <psim/core/async_telemetry.hpp>
+#include <psim/core/checkpoint.hpp>
+#include <psim/core/condition.hpp>
+#include <psim/core/configuration.hpp>
 #include <psim/core/model.hpp>
+#include <psim/core/profiler.hpp>
+#include <psim/core/pyramid.hpp>
+#include <psim/core/recorder.hpp>
 #include <psim/core/state.hpp>
+#include <psim/core/telemetry.hpp>
+#include <psim/core/thread_pool.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace psim {
 
@@ -49,10 +65,80 @@ class Simulation : public State {
    */
   RandomsGenerator _randoms;
 
+  /** @brief Thread pool the model is stepped on (may be null).
+   */
+  std::unique_ptr<ThreadPool> _pool;
+
   /** @brief Model employed by the simulation.
    */
   C _model;
 
+  /** @brief Recorders attached to the simulation.
+   */
+  std::vector<std::shared_ptr<Recorder>> _recorders;
+
+  /** @brief Telemetry logs attached to the simulation.
+   */
+  std::vector<std::shared_ptr<TelemetrySink>> _logs;
+
+  /** @brief Configuration the simulation was constructed with.
+   */
+  Configuration _config;
+
+  /** @brief State of the simulation immediately after construction.
+   */
+  Checkpoint _initial;
+
+  /** @brief Buffer other simulations fork into this one through.
+   */
+  Checkpoint _scratch;
+
+  /** @brief Fields the model was pruned for.
+   */
+  std::vector<std::string> _fields;
+
+  /** @brief Flag specifying whether the model was pruned.
+   */
+  bool _pruned;
+
+  /** @brief Shared implementation of the public constructors.
+   */
+  Simulation(Configuration const &config,
+      std::vector<std::string> const &fields, bool prune)
+    : _randoms(config["seed"].get<Integer>()), _model(_randoms, config),
+      _config(Configuration::copy(config)), _pruned(prune) {
+    _model.add_fields(*this);
+    _model.get_fields(*this);
+
+    if (_pruned) {
+      std::vector<StateFieldBase const *> needed;
+      needed.reserve(fields.size());
+      for (auto const &name : fields)
+        needed.push_back(&(*this)[name]);
+
+      _model.prune(*this, needed);
+      _fields = fields;
+    }
+    freeze();
+
+    auto const *threads = config.get("threads");
+    if (threads && threads->get<Integer>() > 1) {
+      _pool = std::make_unique<ThreadPool>(threads->get<Integer>() - 1);
+      _model.parallelize(*_pool);
+    }
+
+    _checkpoint(_initial);
+  }
+
+  /** @brief Appends the simulation's state to a checkpoint.
+   *
+   *  @param[out] checkpoint Checkpoint.
+   */
+  void _checkpoint(Checkpoint &checkpoint) const {
+    checkpoint.write("randoms", _randoms);
+    _model.checkpoint(checkpoint);
+  }
+
  public:
   Simulation() = delete;
   Simulation(Simulation const &) = delete;
@@ -67,18 +153,328 @@ class Simulation : public State {
    *  @param[in] config Simulation configuration.
    *
    *  Note, the simulation expects a field named 'seed' in the configuration to
-   *  initialize the random number generator.
+   *  initialize the random number generator and the models' random streams.
+   *
+   *  Once all models have added and requested their fields, the simulation
+   *  state is frozen so fields can be resolved to handles.
+   *
+   *  If the configuration has an integer field named 'threads' greater than
+   *  one, independent models are stepped concurrently using that many threads
+   *  in total. See `ModelList` for more information.
    */
-  Simulation(Configuration const &config)
-    : _randoms(config["seed"].get<Integer>()), _model(_randoms, config) {
-    _model.add_fields(*this);
-    _model.get_fields(*this);
+  Simulation(Configuration const &config) : Simulation(config, {}, false) {}
+
+  /** @brief Creates a simulation computing only what's needed for a set of
+   *         fields.
+   *
+   *  @param[in] config Simulation configuration.
+   *  @param[in] fields Names of the fields that will be read.
+   *
+   *  Models that don't contribute to the given fields, directly or through
+   *  the fields of other models, are removed before the state is frozen along
+   *  with the fields they added. This is intended for batch runs that only
+   *  read a handful of fields, for example those recorded and those used in
+   *  stop conditions (see `Condition::field`). The given fields evolve exactly
+   *  as they would in the full simulation. See `ModelList` for more
+   *  information.
+   *
+   *  If any of the fields don't exist, a runtime error will be thrown.
+   */
+  Simulation(Configuration const &config,
+      std::vector<std::string> const &fields)
+    : Simulation(config, fields, true) {}
+
+  /** @return Model employed by the simulation.
+   */
+  C const &model() const {
+    return _model;
   }
 
   /** @brief Steps the simulation (and all underlying models) forward.
+   *
+   *  All attached recorders and telemetry logs are notified after the models
+   *  have stepped.
    */
   void step() {
-    _model.step();
+    {
+      Profiler::Scope const profile(_model);
+      _model.step();
+    }
+
+    for (auto const &recorder : _recorders)
+      recorder->step();
+    for (auto const &log : _logs)
+      log->step();
+  }
+
+  /** @brief Steps the simulation forward a number of times.
+   *
+   *  @param[in] n Number of steps.
+   */
+  void step(std::size_t n) {
+    for (std::size_t i = 0; i < n; i++)
+      step();
+  }
+
+  /** @brief Steps the simulation until any of the conditions are satisfied.
+   *
+   *  @param[in] conditions Stop conditions.
+   *
+   *  @return Index of the first satisfied condition.
+   *
+   *  The simulation is always stepped at least once and the conditions are
+   *  checked after every step. If no conditions are provided, a runtime error
+   *  will be thrown.
+   *
+   *  @{
+   */
+  std::size_t step_until(std::vector<Condition> const &conditions) {
+    if (conditions.empty())
+      throw std::runtime_error("At least one stop condition must be provided");
+
+    while (true) {
+      step();
+
+      for (std::size_t i = 0; i < conditions.size(); i++)
+        if (conditions[i]())
+          return i;
+    }
+  }
+
+  std::size_t step_until(std::vector<std::string> const &expressions) {
+    std::vector<Condition> conditions;
+    conditions.reserve(expressions.size());
+    for (auto const &expression : expressions)
+      conditions.emplace_back(*this, expression);
+
+    return step_until(conditions);
+  }
+  /** @}
+   */
+
+  /** @brief Captures the simulation's state.
+   *
+   *  @return Checkpoint.
+   *
+   *  The checkpoint holds the random number generator, the values of all fields
+   *  added by the models, and any internal state of the models. Parameters are
+   *  not included.
+   */
+  Checkpoint checkpoint() const {
+    Checkpoint checkpoint;
+    _checkpoint(checkpoint);
+    return checkpoint;
+  }
+
+  /** @brief Restores the simulation's state from a checkpoint.
+   *
+   *  @param[in] checkpoint Checkpoint.
+   *
+   *  The checkpoint must have been captured from a simulation of the same model
+   *  type set up with the same set of models. Parameters of this simulation
+   *  are left as is which allows many branches to continue from one checkpoint
+   *  with, for example, different seeds.
+   *
+   *  If the checkpoint's layout doesn't match the simulation's, a runtime error
+   *  will be thrown before any state is modified.
+   */
+  void restore(Checkpoint const &checkpoint) {
+    if (checkpoint.layout() != _initial.layout())
+      throw std::runtime_error(
+          "Checkpoint doesn't match the simulation restoring it");
+
+    Checkpoint::Reader reader(checkpoint);
+    reader.read("randoms", _randoms);
+    _model.restore(reader);
+
+    if (!reader.done())
+      throw std::runtime_error("Checkpoint wasn't fully restored");
+  }
+
+  /** @brief Creates a copy of the simulation configured for a new branch.
+   *
+   *  @param[in] config Configuration of the branch.
+   *
+   *  @return Pointer to the new simulation.
+   *
+   *  The new simulation is built from the configuration and then restored from
+   *  a checkpoint of this simulation. Its state, random number generators, and
+   *  step count match this simulation's while parameters, such as controller
+   *  gains, and random stream seeds are taken from the configuration. Recorders
+   *  and telemetry logs aren't copied. If this simulation was pruned, the new
+   *  simulation is pruned for the same fields.
+   *
+   *  Note, this costs as much as constructing the simulation from scratch. Use
+   *  `fork(Simulation &)` to branch repeatedly into simulations that have
+   *  already been built.
+   */
+  std::unique_ptr<Simulation> fork(Configuration const &config) const {
+    auto simulation = _pruned ? std::make_unique<Simulation>(config, _fields)
+                              : std::make_unique<Simulation>(config);
+    fork(*simulation);
+    return simulation;
+  }
+
+  /** @brief Copies the simulation's state into an existing simulation.
+   *
+   *  @param[in] twin Simulation to branch into.
+   *
+   *  The twin's random number generators, field values, and model internals
+   *  are overwritten with this simulation's through a buffer owned by the
+   *  twin. No models or fields are constructed and, after the first fork into
+   *  a twin, nothing is allocated. The twin keeps its own parameters,
+   *  recorders, and telemetry logs. Variants can be branched off a shared
+   *  history by resetting the twin with each variant's overrides and then
+   *  forking into it.
+   *
+   *  Note, this isn't a memcpy of the state. Every model is checkpointed into
+   *  the buffer and restored from it through virtual calls, and every record's
+   *  name is hashed on both sides to check the layout. The cost grows with the
+   *  number of models and records and, in `//bench:core`, is tens of
+   *  nanoseconds per model compared to well under a nanosecond per model for
+   *  copying the same bytes directly.
+   *
+   *  The twin must be set up with the same set of models, see `restore`. Many
+   *  twins can be forked into concurrently.
+   */
+  void fork(Simulation &twin) const {
+    twin._scratch.clear();
+    _checkpoint(twin._scratch);
+    twin.restore(twin._scratch);
+  }
+
+  /** @brief Reinitializes the simulation in place.
+   *
+   *  @param[in] overrides Parameters that differ from construction.
+   *
+   *  The simulation is restored to its state immediately after construction
+   *  and every model then rereads its parameters, initial conditions, and
+   *  random stream seeds from the configuration the simulation was constructed
+   *  with, with the overrides applied on top. Only the parameters that change
+   *  need to be set in the overrides; an empty configuration replays the
+   *  original run. Overrides don't accumulate across resets.
+   *
+   *  No models or fields are reallocated so resolved field handles and
+   *  attached recorders remain valid; the recorders aren't cleared. The set of
+   *  models and the number of threads are fixed at construction and aren't
+   *  affected.
+   *
+   *  Note, values models compute while adding their fields are restored from
+   *  construction rather than recomputed from the overrides.
+   */
+  void reset(Configuration const &overrides) {
+    auto config = Configuration::overlay(_config);
+    config.merge(overrides);
+
+    restore(_initial);
+    _randoms = RandomsGenerator(config["seed"].get<Integer>());
+    _model.configure(config);
+  }
+
+  /** @brief Attaches a new recorder to the simulation.
+   *
+   *  @param[in] fields     Names of the fields to record.
+   *  @param[in] decimation Record a sample every `decimation` steps.
+   *  @param[in] capacity   Number of samples to preallocate.
+   *
+   *  @return Pointer to the attached recorder.
+   *
+   *  See `Recorder` for more information.
+   */
+  std::shared_ptr<Recorder> record(std::vector<std::string> const &fields,
+      std::size_t decimation = 1, std::size_t capacity = 0) {
+    _recorders.push_back(
+        std::make_shared<Recorder>(*this, fields, decimation, capacity));
+    return _recorders.back();
+  }
+
+  /** @brief Detaches a recorder from the simulation.
+   *
+   *  @param[in] recorder Pointer to the recorder.
+   *
+   *  The recorder and its buffers remain valid after being detached.
+   */
+  void detach(std::shared_ptr<Recorder> const &recorder) {
+    _recorders.erase(
+        std::remove(_recorders.begin(), _recorders.end(), recorder),
+        _recorders.end());
+  }
+
+  /** @brief Attaches a new telemetry log to the simulation.
+   *
+   *  @param[in] file       Telemetry file.
+   *  @param[in] fields     Names of the fields to log.
+   *  @param[in] decimation Log a sample every `decimation` steps.
+   *  @param[in] chunk      Number of samples per chunk.
+   *
+   *  @return Pointer to the attached telemetry log.
+   *
+   *  See `TelemetryWriter` for more information.
+   */
+  std::shared_ptr<TelemetryWriter> log(std::string const &file,
+      std::vector<std::string> const &fields, std::size_t decimation = 1,
+      std::size_t chunk = 4096) {
+    auto log = std::make_shared<TelemetryWriter>(
+        *this, file, fields, decimation, chunk);
+    _logs.push_back(log);
+    return log;
+  }
+
+  /** @brief Attaches a new telemetry log written from a background thread to
+   *         the simulation.
+   *
+   *  @param[in] file       Telemetry file.
+   *  @param[in] fields     Names of the fields to log.
+   *  @param[in] decimation Log a sample every `decimation` steps.
+   *  @param[in] chunk      Number of samples per chunk.
+   *  @param[in] capacity   Number of samples the ring buffer holds.
+   *  @param[in] policy     Backpressure policy.
+   *
+   *  @return Pointer to the attached telemetry log.
+   *
+   *  See `AsyncTelemetryWriter` for more information.
+   */
+  std::shared_ptr<AsyncTelemetryWriter> log_async(std::string const &file,
+      std::vector<std::string> const &fields, std::size_t decimation = 1,
+      std::size_t chunk = 4096, std::size_t capacity = 1024,
+      AsyncTelemetryWriter::Policy policy =
+          AsyncTelemetryWriter::Policy::Block) {
+    auto log = std::make_shared<AsyncTelemetryWriter>(
+        *this, file, fields, decimation, chunk, capacity, policy);
+    _logs.push_back(log);
+    return log;
+  }
+
+  /** @brief Attaches a new level of detail pyramid to the simulation.
+   *
+   *  @param[in] fields     Names of the fields to record.
+   *  @param[in] bucket     Number of samples per bucket on the finest level.
+   *  @param[in] factor     Number of buckets combined by each coarser level.
+   *  @param[in] levels     Number of levels.
+   *  @param[in] decimation Record a sample every `decimation` steps.
+   *
+   *  @return Pointer to the attached pyramid.
+   *
+   *  The pyramid is detached like a telemetry log. See `Pyramid` for more
+   *  information.
+   */
+  std::shared_ptr<Pyramid> pyramid(std::vector<std::string> const &fields,
+      std::size_t bucket = 16, std::size_t factor = 4, std::size_t levels = 6,
+      std::size_t decimation = 1) {
+    auto pyramid = std::make_shared<Pyramid>(
+        *this, fields, bucket, factor, levels, decimation);
+    _logs.push_back(pyramid);
+    return pyramid;
+  }
+
+  /** @brief Detaches a telemetry log from the simulation.
+   *
+   *  @param[in] log Pointer to the telemetry log.
+   *
+   *  The log isn't closed and remains valid after being detached.
+   */
+  void detach(std::shared_ptr<TelemetrySink> const &log) {
+    _logs.erase(std::remove(_logs.begin(), _logs.end(), log), _logs.end());
   }
 };
 } // namespace psim
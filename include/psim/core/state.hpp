@@ -29,11 +29,15 @@
 #ifndef PSIM_CORE_STATE_HPP_
 #define PSIM_CORE_STATE_HPP_
 
+#include <psim/core/field_handle.hpp>
 #include <psim/core/state_field.hpp>
 
+#include <cstddef>
 #include <functional>
+#include <stdexcept>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace psim {
 
@@ -45,8 +49,16 @@ namespace psim {
  *
  *  The fields are mapped one to one with a string name. It's not possible to
  *  have a readable and writable field registered to the same name.
+ *
+ *  Each field is also assigned an index, in the order it was added, into a flat
+ *  field table. Once the state is frozen, no more fields may be added and
+ *  fields can be resolved to typed handles or accessed directly by index. This
+ *  avoids hashing a field's name on every access.
  */
 class State {
+ public:
+  class Trace;
+
  private:
   /** @brief Map to the readable fields.
    */
@@ -62,6 +74,36 @@ class State {
       std::equal_to<std::string>>
       _writable_fields;
 
+  /** @brief Map from field names to indices in the field table.
+   */
+  std::unordered_map<std::reference_wrapper<std::string const>, std::size_t,
+      std::hash<std::string>, std::equal_to<std::string>>
+      _indices;
+
+  /** @brief Flat table of all fields in the order they were added.
+   */
+  std::vector<StateFieldBase const *> _fields;
+
+  /** @brief Flat table of writable fields parallel to the field table.
+   *
+   *  Entries corresponding to readable only fields are null.
+   */
+  std::vector<StateFieldWritableBase *> _fields_writable;
+
+  /** @brief Flag specifying whether the state has been frozen.
+   */
+  bool _frozen = false;
+
+  /** @brief Traces currently recording accesses to the state.
+   */
+  std::vector<Trace *> _traces;
+
+  /** @brief Ensures fields can still be added to the state.
+   *
+   *  @param[in] field_ptr Pointer to the field being added.
+   */
+  void _check_not_frozen(StateFieldBase const *field_ptr) const;
+
  public:
   State() = default;
   State(State const &) = delete;
@@ -105,6 +147,16 @@ class State {
    */
   void add_writable(StateFieldWritableBase *field_ptr);
 
+  /** @brief Removes a field from the simulation state.
+   *
+   *  @param[in] field_ptr Pointer to the field.
+   *
+   *  Indices of the fields added after it are shifted down by one. If the state
+   *  is frozen or the field isn't registered with the state, a runtime error
+   *  will be thrown.
+   */
+  void remove(StateFieldBase const *field_ptr);
+
   /** @brief Retrieve a field from the simulation state.
    *
    *  @param[in] name Field name.
@@ -134,6 +186,134 @@ class State {
    *  If no such field exists, a runtime error will be thrown.
    */
   StateFieldBase const &operator[](std::string const &name) const;
+
+  /** @brief Freezes the set of fields registered with the state.
+   *
+   *  After this call, attempting to add a new field will throw a runtime error
+   *  and fields may be accessed by index or resolved to handles.
+   */
+  void freeze();
+
+  /** @return True if the state has been frozen and false otherwise.
+   */
+  bool is_frozen() const;
+
+  /** @return Number of fields registered with the state.
+   */
+  std::size_t size() const;
+
+  /** @brief Retrieve the index of a field in the field table.
+   *
+   *  @param[in] name Field name.
+   *
+   *  @return Index of the field.
+   *
+   *  If the state isn't frozen or no such field exists, a runtime error will be
+   *  thrown.
+   */
+  std::size_t index(std::string const &name) const;
+
+  /** @brief Retrieve a field by index.
+   *
+   *  @param[in] i Field index.
+   *
+   *  @return Reference to the field.
+   *
+   *  If the index is out of bounds, a runtime error will be thrown.
+   */
+  StateFieldBase const &at(std::size_t i) const;
+
+  /** @brief Retrieve a writable field by index.
+   *
+   *  @param[in] i Field index.
+   *
+   *  @return Pointer to the writable field.
+   *
+   *  If the field at the given index isn't writable, a null pointer is returned.
+   *  If the index is out of bounds, a runtime error will be thrown.
+   */
+  StateFieldWritableBase *at_writable(std::size_t i);
+
+  /** @brief Resolve a field to a typed handle.
+   *
+   *  @tparam T Underlying type.
+   *
+   *  @param[in] name Field name.
+   *
+   *  @return Handle to the field.
+   *
+   *  If the state isn't frozen, the field doesn't exist, or the underlying type
+   *  is incorrect, a runtime error will be thrown.
+   */
+  template <typename T>
+  FieldHandle<T> resolve(std::string const &name) const {
+    auto const i = index(name);
+    return FieldHandle<T>(i, &_fields[i]->template cast<T>());
+  }
+
+  /** @brief Resolve a writable field to a typed handle.
+   *
+   *  @tparam T Underlying type.
+   *
+   *  @param[in] name Field name.
+   *
+   *  @return Handle to the writable field.
+   *
+   *  If the state isn't frozen, the field doesn't exist or isn't writable, or
+   *  the underlying type is incorrect, a runtime error will be thrown.
+   */
+  template <typename T>
+  FieldHandleWritable<T> resolve_writable(std::string const &name) {
+    auto const i = index(name);
+    auto *field_ptr = _fields_writable[i];
+    if (!field_ptr)
+      throw std::runtime_error(
+          "State field '" + name + "' is not writable and cannot be resolved " +
+          "to a writable handle");
+
+    return FieldHandleWritable<T>(i, &field_ptr->template cast<T>());
+  }
+};
+
+/** @brief Records the fields added to and retrieved from a state for as long as
+ *         the trace is alive.
+ *
+ *  Traces can be nested in which case all live traces record every access.
+ *  This is how the fields a model declares while adding and getting its fields
+ *  are determined.
+ */
+class State::Trace {
+ private:
+  friend class State;
+
+  /** @brief State being traced.
+   */
+  State &_state;
+
+ public:
+  /** @brief Fields added to the state.
+   */
+  std::vector<StateFieldBase const *> adds;
+
+  /** @brief Fields retrieved as readable fields.
+   */
+  std::vector<StateFieldBase const *> reads;
+
+  /** @brief Fields retrieved as writable fields.
+   */
+  std::vector<StateFieldBase const *> writes;
+
+  Trace() = delete;
+  Trace(Trace const &) = delete;
+  Trace(Trace &&) = delete;
+  Trace &operator=(Trace const &) = delete;
+  Trace &operator=(Trace &&) = delete;
+
+  /** @param[in] state State to trace.
+   */
+  Trace(State &state);
+
+  ~Trace();
 };
 } // namespace psim
 
@@ -32,7 +32,9 @@
 #include <psim/core/castable.hpp>
 #include <psim/core/castable_base.hpp>
 #include <psim/core/nameable.hpp>
+#include <psim/core/types.hpp>
 
+#include <cstddef>
 #include <stdexcept>
 #include <type_traits>
 
@@ -48,17 +50,25 @@ class StateFieldWritable;
 
 /** @brief Parent class for all state fields.
  *
- *  The main purpose of this class is to allow dynamic casting to be used to
- * check field types at runtime and provided casting functions for convenience.
+ *  The main purpose of this class is to allow field types to be checked at
+ *  runtime, via their type tag, and provide casting functions for convenience.
  */
 class StateFieldBase : public virtual Nameable,
                        public CastableBase<StateField>,
                        public CastableBase<StateFieldWritable> {
  protected:
+  /** @brief Version of the field's current value.
+   *
+   *  Implementations increment this whenever the value changes; i.e. on a lazy
+   *  evaluation or once a valued field is seen to hold a new value.
+   */
+  std::size_t mutable _version = 0;
+
   StateFieldBase() = default;
 
  public:
   using CastableBase<StateField>::cast;
+  using CastableBase<StateField>::tag;
 
   template <typename T>
   auto const &cast_writable() const {
@@ -77,6 +87,15 @@ class StateFieldBase : public virtual Nameable,
 
   virtual ~StateFieldBase() = default;
 
+  /** @return Version of the field's current value.
+   *
+   *  If the version differs from a previously returned version, the value may
+   *  have changed in between. Lazy fields are brought up to date first.
+   */
+  virtual std::size_t version() const {
+    return _version;
+  }
+
   /** @brief Attempt to get read only data from the field.
    *
    *  @tparam Expected underlying type.
@@ -112,7 +131,9 @@ template <typename T>
 class StateField : virtual public StateFieldBase,
                    public Castable<StateFieldWritable, T> {
  protected:
-  StateField() = default;
+  StateField() {
+    CastableBase<StateField>::_register(this);
+  }
 
   /** @return Constant reference to the underlying type.
    */
@@ -247,7 +268,9 @@ class StateFieldWritableBase : virtual public StateFieldBase {
 template <typename T>
 class StateFieldWritable : public StateFieldWritableBase, public StateField<T> {
  protected:
-  StateFieldWritable() = default;
+  StateFieldWritable() {
+    CastableBase<StateFieldWritable>::_register(this);
+  }
 
   /** @return Reference to the underlying value.
    */
@@ -29,9 +29,12 @@
 #ifndef PSIM_CORE_STATE_FIELD_LAZY_HPP_
 #define PSIM_CORE_STATE_FIELD_LAZY_HPP_
 
+#include <psim/core/dependencies.hpp>
 #include <psim/core/nameable.hpp>
 #include <psim/core/state_field.hpp>
+#include <psim/core/state_field_lazy_base.hpp>
 
+#include <cstddef>
 #include <functional>
 #include <string>
 #include <utility>
@@ -45,28 +48,28 @@ namespace psim {
  *  This field is particularly useful for fields that may be helpful when
  *  debugging or devloping but don't need to be evaluated all the time. The
  * field take a function that can later be evaluated if the field is read.
+ *
+ *  The field may optionally be tied to an epoch counter - typically the step
+ *  epoch of the model owning the field - or memoized on the fields read while
+ *  evaluating it. See `StateFieldLazyBase` for more information.
  */
 template <typename T>
-class StateFieldLazy : public StateField<T> {
+class StateFieldLazy : public StateField<T>, public StateFieldLazyBase {
  private:
   /** @brief Lazy evaluation function.
    */
   std::function<T()> const _function;
 
-  /** @brief Flag specifying if the currently held value is up to date.
-   */
-  bool mutable _evaluated;
-
   /** @brief Current value (may or may not be valid).
    */
   T mutable _value;
 
   virtual T const &_get() const override {
-    if (!_evaluated) {
-      _value = _function();
-      _evaluated = true;
-    }
-    return _value;
+    return get();
+  }
+
+  virtual void _refresh() const override {
+    this->_update([this]() { _value = _function(); }, false);
   }
 
  public:
@@ -76,40 +79,43 @@ class StateFieldLazy : public StateField<T> {
 
   /** @param[in] name State field's name.
    *  @param[in] function Lazy evaluation function.
+   *  @param[in] epoch Optional epoch counter the field is tied to.
+   *  @param[in] memoized Whether the field is memoized on its dependencies.
    *
    *  @{
    */
-  StateFieldLazy(std::string const &name, std::function<T()> const &function)
-    : Nameable(name, "state_field_lazy"), _function(function),
-      _evaluated(false) {}
+  StateFieldLazy(std::string const &name, std::function<T()> const &function,
+      std::size_t const *epoch = nullptr, bool memoized = false)
+    : Nameable(name, "state_field_lazy"), StateFieldLazyBase(epoch, memoized),
+      _function(function) {}
 
-  StateFieldLazy(std::string &&name, std::function<T()> const &function)
-    : Nameable(std::move(name), "state_field_lazy"), _function(function),
-      _evaluated(false) {}
+  StateFieldLazy(std::string &&name, std::function<T()> const &function,
+      std::size_t const *epoch = nullptr, bool memoized = false)
+    : Nameable(std::move(name), "state_field_lazy"),
+      StateFieldLazyBase(epoch, memoized), _function(function) {}
 
-  StateFieldLazy(std::string const &name, std::function<T()> &&function)
-    : Nameable(name, "state_field_lazy"), _function(std::move(function)),
-      _evaluated(false) {}
+  StateFieldLazy(std::string const &name, std::function<T()> &&function,
+      std::size_t const *epoch = nullptr, bool memoized = false)
+    : Nameable(name, "state_field_lazy"), StateFieldLazyBase(epoch, memoized),
+      _function(std::move(function)) {}
 
-  StateFieldLazy(std::string &&name, std::function<T()> &&function)
+  StateFieldLazy(std::string &&name, std::function<T()> &&function,
+      std::size_t const *epoch = nullptr, bool memoized = false)
     : Nameable(std::move(name), "state_field_lazy"),
-      _function(std::move(function)), _evaluated(false) {}
+      StateFieldLazyBase(epoch, memoized), _function(std::move(function)) {}
   /** @}
    */
 
-  /** @brief Clears the current value held by the state field.
-   */
-  void reset() {
-    _evaluated = false;
-  }
-
   /** @return Reference to the underlying type.
    *
    *  This function was re-implemented to avoid potential type checking overhead
    *  and keep a consistant interface.
    */
   T const &get() const {
-    return _get();
+    this->_update([this]() { _value = _function(); }, true);
+
+    Dependencies::read(*this, this->_version);
+    return _value;
   }
 };
 } // namespace psim
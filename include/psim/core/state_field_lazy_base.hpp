@@ -0,0 +1,223 @@
+//
+// MIT License
+//
+// Copyright (c) 2020 Pathfinder for Autonomous Navigation (PAN)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/** @file psim/core/state_field_lazy_base.hpp
+ *  @author Kyle Krol
+ */
+
+#ifndef PSIM_CORE_STATE_FIELD_LAZY_BASE_HPP_
+#define PSIM_CORE_STATE_FIELD_LAZY_BASE_HPP_
+
+#include <psim/core/dependencies.hpp>
+#include <psim/core/profiler.hpp>
+#include <psim/core/state_field.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <mutex>
+
+namespace psim {
+
+/** @brief Parent class for all lazily evaluated state fields.
+ *
+ *  Implements the bookkeeping deciding when the cached value of a lazy field
+ *  needs to be reevaluated. By default, a lazy field is tied to an epoch counter
+ *  (typically the step epoch of the model owning it) and the cached value is
+ *  considered stale whenever the epoch it was evaluated in differs from the
+ *  current epoch.
+ *
+ *  Memoized lazy fields instead record the versions of all fields read while
+ *  being evaluated and are only reevaluated once one of those inputs changes,
+ *  even across steps. This is only valid if the evaluation depends on nothing
+ *  but state fields and parameters.
+ *
+ *  Hit and miss counters are kept to help judge how much reevaluation is saved.
+ *  Evaluations are also timed by the profiler when it's enabled.
+ *
+ *  Lazy fields read by models stepping concurrently must be marked as shared.
+ *  Bringing a shared field up to date is then guarded by a mutex so it's
+ *  evaluated exactly once no matter how many threads read it.
+ */
+class StateFieldLazyBase : virtual public StateFieldBase {
+ private:
+  /** @brief Epoch value marking the currently held value as invalid.
+   */
+  static constexpr std::size_t _invalid =
+      std::numeric_limits<std::size_t>::max();
+
+  /** @brief Epoch counter the field is tied to (may be null).
+   */
+  std::size_t const *const _epoch;
+
+  /** @brief Whether the field is memoized on its dependencies.
+   */
+  bool const _memoized;
+
+  /** @brief Epoch the currently held value was evaluated in.
+   */
+  std::size_t mutable _evaluated;
+
+  /** @brief Fields read during the last evaluation (memoized only).
+   */
+  Dependencies mutable _dependencies;
+
+  /** @brief Whether the field may be read by multiple threads at once.
+   */
+  bool _shared;
+
+  /** @brief Guards evaluation of shared fields.
+   */
+  std::mutex mutable _mutex;
+
+  /** @return Current epoch.
+   */
+  inline std::size_t _current_epoch() const {
+    return _epoch ? *_epoch : 0;
+  }
+
+ protected:
+  /** @brief Number of reads served from the cached value.
+   */
+  std::size_t mutable _hits;
+
+  /** @brief Number of evaluations.
+   */
+  std::size_t mutable _misses;
+
+  /** @param[in] epoch    Optional epoch counter the field is tied to.
+   *  @param[in] memoized Whether the field is memoized on its dependencies.
+   */
+  StateFieldLazyBase(std::size_t const *epoch, bool memoized)
+    : _epoch(epoch), _memoized(memoized), _evaluated(_invalid),
+      _dependencies(), _shared(false), _hits(0), _misses(0) {}
+
+  /** @return True if the currently held value must be reevaluated.
+   */
+  inline bool _is_stale() const {
+    if (_evaluated == _invalid)
+      return true;
+    if (_memoized)
+      return _dependencies.changed();
+
+    return _evaluated != _current_epoch();
+  }
+
+  /** @brief Evaluates the field's value.
+   *
+   *  @param[in] evaluate Callable updating the currently held value.
+   *
+   *  Reads made while evaluating are recorded as dependencies for memoized
+   *  fields and hidden from any enclosing evaluation otherwise.
+   */
+  template <typename F>
+  void _evaluate(F const &evaluate) const {
+    _evaluated = _invalid;
+    {
+      Profiler::Scope const profile("field", this->name());
+      Dependencies::Scope const scope(_memoized ? &_dependencies : nullptr);
+      evaluate();
+    }
+    _evaluated = _current_epoch();
+    _version++;
+    _misses++;
+  }
+
+  /** @brief Evaluates the field's value if it's stale.
+   *
+   *  @param[in] evaluate Callable updating the currently held value.
+   *  @param[in] read     Whether to count a hit if the value is up to date.
+   */
+  template <typename F>
+  inline void _update(F const &evaluate, bool read) const {
+    std::unique_lock<std::mutex> lock(_mutex, std::defer_lock);
+    if (_shared)
+      lock.lock();
+
+    if (_is_stale())
+      _evaluate(evaluate);
+    else if (read)
+      _hits++;
+  }
+
+  /** @brief Brings the currently held value up to date.
+   */
+  virtual void _refresh() const = 0;
+
+ public:
+  virtual ~StateFieldLazyBase() = default;
+
+  /** @return Version of the field's current value.
+   *
+   *  The field is brought up to date first.
+   */
+  virtual std::size_t version() const override {
+    _refresh();
+    return _version;
+  }
+
+  /** @brief Clears the current value held by the state field.
+   *
+   *  Lazy fields don't need to be reset manually when tied to an epoch counter
+   *  or memoized.
+   */
+  void reset() {
+    _evaluated = _invalid;
+  }
+
+  /** @brief Marks the field as possibly being read by multiple threads at
+   *         once.
+   *
+   *  This must not be called while the field is being read.
+   */
+  void share() {
+    _shared = true;
+  }
+
+  /** @return Whether the field may be read by multiple threads at once.
+   */
+  inline bool shared() const {
+    return _shared;
+  }
+
+  /** @return Whether the field is memoized on its dependencies.
+   */
+  inline bool memoized() const {
+    return _memoized;
+  }
+
+  /** @return Number of reads served from the cached value.
+   */
+  inline std::size_t hits() const {
+    return _hits;
+  }
+
+  /** @return Number of evaluations.
+   */
+  inline std::size_t misses() const {
+    return _misses;
+  }
+};
+} // namespace psim
+
+#endif
@@ -0,0 +1,125 @@
+//
+// MIT License
+//
+// Copyright (c) 2020 Pathfinder for Autonomous Navigation (PAN)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/** @file psim/core/state_field_lazy_member.hpp
+ *  @author Kyle Krol
+ */
+
+#ifndef PSIM_CORE_STATE_FIELD_LAZY_MEMBER_HPP_
+#define PSIM_CORE_STATE_FIELD_LAZY_MEMBER_HPP_
+
+#include <psim/core/dependencies.hpp>
+#include <psim/core/nameable.hpp>
+#include <psim/core/state_field.hpp>
+#include <psim/core/state_field_lazy_base.hpp>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+namespace psim {
+
+/** @brief State field implementation whose value is lazily evaluated by a
+ *         member function of the model owning it.
+ *
+ *  @tparam T Underlying type.
+ *  @tparam D Model type owning the field.
+ *  @tparam F Stateless evaluator called as `F()(model)`.
+ *
+ *  This is the field the autocoder generates for lazy fields. Unlike the more
+ *  general `StateFieldLazy`, the evaluation isn't type erased behind a
+ *  `std::function` so it never allocates and reads through the concrete field
+ *  type can be fully inlined. Only reads through the generic `StateField<T>`
+ *  interface require a virtual call.
+ *
+ *  The evaluator is used rather than a member function pointer template
+ *  parameter because the owning model is still an incomplete type when its
+ *  autocoded base class, and therefore this field, is instantiated.
+ *
+ *  The field is tied to the step epoch of the owning model or, if requested,
+ *  memoized on the fields read while evaluating it. See `StateFieldLazyBase`
+ *  for more information.
+ */
+template <typename T, class D, class F>
+class StateFieldLazyMember final : public StateField<T>,
+                                   public StateFieldLazyBase {
+ private:
+  /** @brief Model owning the field.
+   */
+  D const &_model;
+
+  /** @brief Current value (may or may not be valid).
+   */
+  T mutable _value;
+
+  virtual T const &_get() const override {
+    return get();
+  }
+
+  virtual void _refresh() const override {
+    this->_update([this]() { _value = F()(_model); }, false);
+  }
+
+ public:
+  StateFieldLazyMember() = delete;
+
+  virtual ~StateFieldLazyMember() = default;
+
+  /** @param[in] name     State field's name.
+   *  @param[in] model    Model owning the field.
+   *  @param[in] epoch    Epoch counter the field is tied to.
+   *  @param[in] memoized Whether the field is memoized on its dependencies.
+   *
+   *  The model may not be fully constructed yet; it's only used once the field
+   *  is read.
+   *
+   *  @{
+   */
+  StateFieldLazyMember(std::string const &name, D const &model,
+      std::size_t const &epoch, bool memoized = false)
+    : Nameable(name, "state_field_lazy"), StateFieldLazyBase(&epoch, memoized),
+      _model(model) {}
+
+  StateFieldLazyMember(std::string &&name, D const &model,
+      std::size_t const &epoch, bool memoized = false)
+    : Nameable(std::move(name), "state_field_lazy"),
+      StateFieldLazyBase(&epoch, memoized), _model(model) {}
+  /** @}
+   */
+
+  /** @return Reference to the underlying type.
+   *
+   *  This function was re-implemented to avoid potential type checking overhead
+   *  and the virtual call required by the generic interface.
+   */
+  inline T const &get() const {
+    this->_update([this]() { _value = F()(_model); }, true);
+
+    Dependencies::read(*this, this->_version);
+    return _value;
+  }
+};
+} // namespace psim
+
+#endif
@@ -29,10 +29,13 @@
 #ifndef PSIM_CORE_STATE_FIELD_VALUED_HPP_
 #define PSIM_CORE_STATE_FIELD_VALUED_HPP_
 
+#include <psim/core/dependencies.hpp>
 #include <psim/core/nameable.hpp>
 #include <psim/core/state_field.hpp>
 
+#include <cstring>
 #include <string>
+#include <type_traits>
 #include <utility>
 
 namespace psim {
@@ -40,19 +43,35 @@ namespace psim {
 /** @brief Writable state field implemenation directly backed by a value.
  *
  *  @tparam Underlying type.
+ *
+ *  Writes through references can't be intercepted so the field's version is
+ *  only incremented once its value is seen to differ from the value the
+ *  current version was taken at. Non-constant accesses which only read the
+ *  value therefore don't invalidate memoized lazy fields depending on it.
  */
 template <typename T>
 class StateFieldValued : public StateFieldWritable<T> {
+  static_assert(std::is_trivially_copyable<T>::value,
+      "Valued state fields must be trivially copyable");
+
  private:
   /** @brief Underlying value.
    */
   T _value;
 
+  /** @brief Value as of the field's current version.
+   */
+  T mutable _versioned;
+
   virtual T const &_get() const override {
+    if (Dependencies::recording())
+      Dependencies::read(*this, version());
     return _value;
   }
 
   virtual T &_get() override {
+    if (Dependencies::recording())
+      Dependencies::read(*this, version());
     return _value;
   }
 
@@ -70,10 +89,12 @@ class StateFieldValued : public StateFieldWritable<T> {
    *  @{
    */
   StateFieldValued(std::string const &name)
-    : Nameable(name, "state_field_valued"), _value() {}
+    : Nameable(name, "state_field_valued"), _value(),
+      _versioned(_value) {}
 
   StateFieldValued(std::string &&name)
-    : Nameable(std::move(name), "state_field_valued"), _value() {}
+    : Nameable(std::move(name), "state_field_valued"), _value(),
+      _versioned(_value) {}
   /** @}
    */
 
@@ -83,20 +104,33 @@ class StateFieldValued : public StateFieldWritable<T> {
    *  @{
    */
   StateFieldValued(std::string const &name, T const &value)
-    : Nameable(name, "state_field_valued"), _value(value) {}
+    : Nameable(name, "state_field_valued"), _value(value),
+      _versioned(_value) {}
 
   StateFieldValued(std::string &&name, T const &value)
-    : Nameable(std::move(name), "state_field_valued"), _value(value) {}
+    : Nameable(std::move(name), "state_field_valued"), _value(value),
+      _versioned(_value) {}
 
   StateFieldValued(std::string const &name, T &&value)
-    : Nameable(name, "state_field_valued"), _value(std::move(value)) {}
+    : Nameable(name, "state_field_valued"),
+      _value(std::move(value)), _versioned(_value) {}
 
   StateFieldValued(std::string &&name, T &&value)
     : Nameable(std::move(name), "state_field_valued"),
-      _value(std::move(value)) {}
+      _value(std::move(value)), _versioned(_value) {}
   /** @}
    */
 
+  /** @return Version of the field's current value.
+   */
+  virtual std::size_t version() const override {
+    if (std::memcmp(&_value, &_versioned, sizeof(T)) != 0) {
+      _versioned = _value;
+      this->_version++;
+    }
+    return this->_version;
+  }
+
   /** @return Reference to the underlying type.
    *
    *  This function was re-implemented to avoid potential type checking overhead
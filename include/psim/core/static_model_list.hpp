@@ -0,0 +1,190 @@
+//
+// MIT License
+//
+// Copyright (c) 2020 Pathfinder for Autonomous Navigation (PAN)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/** @file psim/core/static_model_list.hpp
+ *  @author Kyle Krol
+ */
+
+#ifndef PSIM_CORE_STATIC_MODEL_LIST_HPP_
+#define PSIM_CORE_STATIC_MODEL_LIST_HPP_
+
+#include <psim/core/model.hpp>
+#include <psim/core/model_list.hpp>
+#include <psim/core/profiler.hpp>
+#include <psim/core/state.hpp>
+#include <psim/core/state_field.hpp>
+#include <psim/core/thread_pool.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace psim {
+
+/** @brief A model list with a fixed set of models known at compile time.
+ *
+ *  @tparam Ms Model types in the order they're stepped.
+ *
+ *  The models are held by value in a tuple so they're laid out contiguously
+ *  within the model list itself. When stepped in series, the calls to each
+ *  model's step are unrolled at compile time and dispatched statically which
+ *  allows them to be inlined.
+ *
+ *  Otherwise, this behaves exactly like a `ModelList` with the models added in
+ *  the same order. Field tracing, concurrent stepping on a thread pool,
+ *  pruning, and checkpointing all go through the `ModelList` implementation.
+ *  Pruned models are kept in the tuple but never stepped.
+ */
+template <class... Ms>
+class StaticModelList : public ModelList {
+ private:
+  /** @brief Holds a single model constructed from a tuple of arguments.
+   */
+  template <class M>
+  struct Slot {
+    M model;
+
+    template <typename... Ts>
+    Slot(std::tuple<Ts...> args)
+      : Slot(args, std::index_sequence_for<Ts...>()) {}
+
+    template <typename... Ts, std::size_t... Is>
+    Slot(std::tuple<Ts...> &args, std::index_sequence<Is...>)
+      : model(std::forward<Ts>(std::get<Is>(args))...) {}
+  };
+
+  /** @brief Models held by the list.
+   */
+  std::tuple<Slot<Ms>...> _slots;
+
+  /** @brief Whether each model is stepped in series by this list.
+   */
+  std::array<bool, sizeof...(Ms)> _stepped;
+
+  /** @brief Flag specifying whether the models are stepped on a thread pool.
+   */
+  bool _parallel;
+
+  /** @brief Calls a function with every model and its index in order.
+   */
+  template <typename F, std::size_t... Is>
+  void _for_each(F const &f, std::index_sequence<Is...>) {
+    int const expand[] = {0, (f(std::get<Is>(_slots).model, Is), 0)...};
+    (void) expand;
+  }
+
+  template <typename F>
+  void _for_each(F const &f) {
+    _for_each(f, std::index_sequence_for<Ms...>());
+  }
+
+ protected:
+  /** @brief Constructs the models in place.
+   *
+   *  @tparam Ts Tuple types holding each model's constructor arguments.
+   *
+   *  @param[in] randoms Simulation's random number generator.
+   *  @param[in] args    One tuple of constructor arguments per model, usually
+   *                     created with `std::forward_as_tuple`.
+   */
+  template <typename... Ts>
+  StaticModelList(RandomsGenerator &randoms, Ts &&... args)
+    : ModelList(randoms), _slots(std::forward<Ts>(args)...), _parallel(false) {
+    static_assert(sizeof...(Ts) == sizeof...(Ms),
+        "Static model list requires one argument tuple per model");
+
+    _stepped.fill(true);
+    _for_each([this](Model &model, std::size_t) { add(model); });
+  }
+
+ public:
+  virtual ~StaticModelList() = default;
+
+  /** @return Model at the given index.
+   *
+   *  @{
+   */
+  template <std::size_t I>
+  typename std::tuple_element<I, std::tuple<Ms...>>::type &get() {
+    return std::get<I>(_slots).model;
+  }
+
+  template <std::size_t I>
+  typename std::tuple_element<I, std::tuple<Ms...>>::type const &get() const {
+    return std::get<I>(_slots).model;
+  }
+  /** @}
+   */
+
+  /** @brief All models scheduled for the current tick step forward.
+   */
+  virtual void step() override {
+    if (_parallel) {
+      this->ModelList::step();
+      return;
+    }
+
+    auto const tick = this->_epoch;
+    this->Model::step();
+    _for_each([this, tick](auto &model, std::size_t i) {
+      using M = typename std::decay<decltype(model)>::type;
+      if (_stepped[i] && model.scheduled(tick)) {
+        Profiler::Scope const profile(model);
+        model.M::step();
+      }
+    });
+  }
+
+  /** @brief Steps independent models concurrently on a thread pool from now
+   *         on.
+   *
+   *  @param[in] pool Thread pool.
+   */
+  virtual void parallelize(ThreadPool &pool) override {
+    this->ModelList::parallelize(pool);
+    _parallel = true;
+  }
+
+  /** @brief Stops stepping models that don't contribute to a set of fields.
+   *
+   *  @param[in] state  Simulation state.
+   *  @param[in] fields Fields that must continue to be computed.
+   */
+  virtual void prune(State &state,
+      std::vector<StateFieldBase const *> const &fields) override {
+    this->ModelList::prune(state, fields);
+
+    auto const &models = this->models();
+    _for_each([this, &models](Model &model, std::size_t i) {
+      _stepped[i] =
+          std::find(models.begin(), models.end(), &model) != models.end();
+    });
+  }
+};
+} // namespace psim
+
+#endif
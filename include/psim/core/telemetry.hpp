@@ -0,0 +1,390 @@
+//
+// MIT License
+//
+// Copyright (c) 2020 Pathfinder for Autonomous Navigation (PAN)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/** @file psim/core/telemetry.hpp
+ *  @author Kyle Krol
+ */
+
+#ifndef PSIM_CORE_TELEMETRY_HPP_
+#define PSIM_CORE_TELEMETRY_HPP_
+
+#include <psim/core/state.hpp>
+#include <psim/core/state_field.hpp>
+#include <psim/core/types.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace psim {
+
+/** @brief Destination for state field samples taken as a simulation steps.
+ */
+class TelemetrySink {
+ public:
+  virtual ~TelemetrySink() = default;
+
+  /** @brief Signals a simulation step was taken.
+   */
+  virtual void step() = 0;
+
+  /** @brief Writes out all buffered samples and releases the destination.
+   */
+  virtual void close() = 0;
+};
+
+/** @brief Streams state field values to a columnar telemetry file over the
+ *         course of a simulation.
+ *
+ *  Fields are split into columns exactly as they are by a `Recorder`. Samples
+ *  are buffered in memory one chunk at a time and each full chunk is appended
+ *  to the file, so the cost of a sample is constant and memory use doesn't
+ *  grow with the length of the run.
+ *
+ *  The file begins with a header holding a magic string, the format version,
+ *  the number of columns, the chunk capacity, and the name and type of each
+ *  column, padded to a multiple of eight bytes. Every chunk then holds its
+ *  number of samples followed by each column's samples stored contiguously as
+ *  eight byte values. Closing the log appends an index of the chunks' offsets
+ *  and sizes. Values are stored in the host's byte order.
+ */
+class TelemetryWriter : public TelemetrySink {
+ public:
+  /** @brief Version of the telemetry format.
+   */
+  static constexpr std::uint32_t version = 1;
+
+  /** @brief Single eight byte value in a column.
+   */
+  union Value {
+    Real real;
+    Integer integer;
+  };
+
+  static_assert(sizeof(Value) == 8, "Telemetry values must be eight bytes");
+
+ private:
+  /** @brief Logged field and the index of its first column.
+   */
+  struct Entry {
+    StateFieldBase const *field;
+    TypeTag tag;
+    std::size_t column;
+  };
+
+  /** @brief Location and size of a chunk within the file.
+   */
+  struct Chunk {
+    std::uint64_t offset;
+    std::uint64_t size;
+  };
+
+  /** @brief Telemetry file name.
+   */
+  std::string _file;
+
+  /** @brief Telemetry file stream.
+   */
+  std::ofstream _ofs;
+
+  /** @brief Log every `_decimation` steps.
+   */
+  std::size_t _decimation;
+
+  /** @brief Steps since the last logged sample.
+   */
+  std::size_t _n;
+
+  /** @brief Maximum number of samples per chunk.
+   */
+  std::size_t _capacity;
+
+  /** @brief Number of samples in the current chunk.
+   */
+  std::size_t _rows;
+
+  /** @brief Total number of samples logged.
+   */
+  std::size_t _size;
+
+  /** @brief Logged fields.
+   */
+  std::vector<Entry> _entries;
+
+  /** @brief Column names in file order.
+   */
+  std::vector<std::string> _columns;
+
+  /** @brief Whether each column holds integers.
+   */
+  std::vector<bool> _integers;
+
+  /** @brief Current chunk stored column by column with `_capacity` values
+   *         reserved for each column.
+   */
+  std::vector<Value> _chunk;
+
+  /** @brief Chunks written so far.
+   */
+  std::vector<Chunk> _index;
+
+  /** @brief Offset of the end of the file.
+   */
+  std::uint64_t _offset;
+
+  /** @brief Flag specifying whether the log has been closed.
+   */
+  bool _closed;
+
+  void _write(void const *data, std::size_t size);
+
+  /** @brief Reads every field into the values `v[i * stride]` where `i` is the
+   *         column index.
+   */
+  void _sample(Value *v, std::size_t stride) const;
+
+  /** @brief Counts the sample just written to the current chunk.
+   */
+  void _advance();
+
+ public:
+  TelemetryWriter() = delete;
+  TelemetryWriter(TelemetryWriter const &) = delete;
+  TelemetryWriter(TelemetryWriter &&) = delete;
+  TelemetryWriter &operator=(TelemetryWriter const &) = delete;
+  TelemetryWriter &operator=(TelemetryWriter &&) = delete;
+
+  /** @brief Closes the log if it hasn't been already.
+   */
+  virtual ~TelemetryWriter();
+
+  /** @param[in] state      Simulation state.
+   *  @param[in] file       Telemetry file which is overwritten.
+   *  @param[in] fields     Names of the fields to log.
+   *  @param[in] decimation Log a sample every `decimation` steps.
+   *  @param[in] chunk      Number of samples per chunk.
+   *
+   *  If the file can't be written, a field doesn't exist, has an unsupported
+   *  type, or is listed more than once, or the decimation or chunk size is
+   *  zero, a runtime error will be thrown.
+   */
+  TelemetryWriter(State const &state, std::string const &file,
+      std::vector<std::string> const &fields, std::size_t decimation = 1,
+      std::size_t chunk = 4096);
+
+  /** @brief Signals a simulation step was taken.
+   *
+   *  A sample is logged every `decimation` calls.
+   */
+  virtual void step() override;
+
+  /** @brief Logs a sample of all fields unconditionally.
+   *
+   *  If the log has been closed, a runtime error will be thrown.
+   */
+  void record();
+
+  /** @brief Reads a sample of all fields without logging it.
+   *
+   *  @param[out] row Array of `columns().size()` values.
+   *
+   *  Used along with `append` to log samples taken on another thread.
+   */
+  void sample(Value *row) const;
+
+  /** @brief Logs a sample previously read with `sample`.
+   *
+   *  @param[in] row Array of `columns().size()` values.
+   *
+   *  If the log has been closed, a runtime error will be thrown.
+   */
+  void append(Value const *row);
+
+  /** @brief Writes any buffered samples to the file as a partial chunk.
+   *
+   *  If the file can't be written, a runtime error will be thrown.
+   */
+  void flush();
+
+  /** @brief Flushes buffered samples, writes the chunk index, and closes the
+   *         file.
+   *
+   *  Closing an already closed log has no effect. If the file can't be
+   *  written, a runtime error will be thrown.
+   */
+  virtual void close() override;
+
+  /** @return Total number of samples logged.
+   */
+  std::size_t size() const;
+
+  /** @return Column names in file order.
+   */
+  std::vector<std::string> const &columns() const;
+
+  /** @return Telemetry file name.
+   */
+  std::string const &file() const;
+};
+
+/** @brief Provides read only access to a telemetry file written by a
+ *         `TelemetryWriter`.
+ *
+ *  The file is memory mapped so only the header and chunk index are read on
+ *  construction and column samples are accessed in place. If the file wasn't
+ *  closed, for example because the run was interrupted, the chunks are found
+ *  by walking the file instead and an incomplete trailing chunk is ignored.
+ */
+class TelemetryReader {
+ private:
+  /** @brief Location of a column within each chunk.
+   */
+  struct Column {
+    std::size_t index;
+    bool is_integer;
+  };
+
+  /** @brief Location and size of a chunk within the file.
+   */
+  struct Chunk {
+    std::uint64_t offset;
+    std::uint64_t size;
+  };
+
+  /** @brief Mapped file contents.
+   */
+  unsigned char const *_data;
+
+  /** @brief Size of the mapped file in bytes.
+   */
+  std::size_t _bytes;
+
+  /** @brief Total number of samples.
+   */
+  std::size_t _size;
+
+  /** @brief Column names in file order.
+   */
+  std::vector<std::string> _columns;
+
+  /** @brief Map from column names to their locations.
+   */
+  std::unordered_map<std::string, Column> _locations;
+
+  /** @brief Chunks in file order.
+   */
+  std::vector<Chunk> _chunks;
+
+  Column const &_column(std::string const &name) const;
+
+  void const *_samples(Column const &column, std::size_t chunk) const;
+
+ public:
+  TelemetryReader() = delete;
+  TelemetryReader(TelemetryReader const &) = delete;
+  TelemetryReader(TelemetryReader &&) = delete;
+  TelemetryReader &operator=(TelemetryReader const &) = delete;
+  TelemetryReader &operator=(TelemetryReader &&) = delete;
+
+  ~TelemetryReader();
+
+  /** @param[in] file Telemetry file.
+   *
+   *  If the file can't be mapped, isn't a telemetry file, or was written with
+   *  a different format version, a runtime error will be thrown.
+   */
+  TelemetryReader(std::string const &file);
+
+  /** @return Total number of samples.
+   */
+  std::size_t size() const;
+
+  /** @return Column names in file order.
+   */
+  std::vector<std::string> const &columns() const;
+
+  /** @param[in] name Column name.
+   *
+   *  @return True if the column exists and false otherwise.
+   */
+  bool has(std::string const &name) const;
+
+  /** @param[in] name Column name.
+   *
+   *  @return True if the column holds integers and false otherwise.
+   *
+   *  If no such column exists, a runtime error will be thrown.
+   */
+  bool is_integer(std::string const &name) const;
+
+  /** @return Number of chunks.
+   */
+  std::size_t chunks() const;
+
+  /** @param[in] chunk Chunk index.
+   *
+   *  @return Number of samples in the chunk.
+   *
+   *  If the chunk index is out of bounds, a runtime error will be thrown.
+   */
+  std::size_t chunk_size(std::size_t chunk) const;
+
+  /** @param[in] name  Column name.
+   *  @param[in] chunk Chunk index.
+   *
+   *  @return Pointer to the column's samples within a chunk.
+   *
+   *  If no such column of the requested type exists or the chunk index is out
+   *  of bounds, a runtime error will be thrown.
+   *
+   *  @{
+   */
+  Real const *reals(std::string const &name, std::size_t chunk) const;
+
+  Integer const *integers(std::string const &name, std::size_t chunk) const;
+  /** @}
+   */
+
+  /** @brief Copies all samples of a column into a contiguous array.
+   *
+   *  @param[in]  name   Column name.
+   *  @param[out] values Array of at least `size()` values.
+   *
+   *  If no such column of the requested type exists, a runtime error will be
+   *  thrown.
+   *
+   *  @{
+   */
+  void read(std::string const &name, Real *values) const;
+
+  void read(std::string const &name, Integer *values) const;
+  /** @}
+   */
+};
+} // namespace psim
+
+#endif
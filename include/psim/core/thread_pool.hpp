@@ -0,0 +1,239 @@
+//
+// MIT License
+//
+// Copyright (c) 2020 Pathfinder for Autonomous Navigation (PAN)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/** @file psim/core/thread_pool.hpp
+ *  @author Kyle Krol
+ */
+
+#ifndef PSIM_CORE_THREAD_POOL_HPP_
+#define PSIM_CORE_THREAD_POOL_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace psim {
+
+/** @brief Work stealing pool of worker threads.
+ *
+ *  Every worker owns a task queue. Tasks submitted from a worker are pushed
+ *  onto its own queue and popped in last in, first out order while idle workers
+ *  steal the oldest tasks from other queues. Tasks submitted from outside the
+ *  pool are placed on a shared queue which all workers steal from.
+ *
+ *  The pool is meant for short, fine grained tasks - like stepping a single
+ *  model - so idle workers spin for a while before going to sleep. Threads
+ *  waiting on tasks they submitted should call `help` rather than block so they
+ *  contribute to the work.
+ *
+ *  Tasks are plain function pointers with a user data pointer to avoid an
+ *  allocation per submitted task. They're not allowed to throw.
+ */
+class ThreadPool {
+ public:
+  /** @brief Unit of work executed by the pool.
+   */
+  struct Task {
+    void (*function)(void *);
+    void *data;
+  };
+
+ private:
+  /** @brief Task queue owned by a single worker.
+   */
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  /** @brief Pool the current thread is a worker of (may be null).
+   */
+  static thread_local ThreadPool const *_current;
+
+  /** @brief Index of the current thread's queue if it's a worker.
+   */
+  static thread_local std::size_t _current_index;
+
+  /** @brief Task queues where the last one is shared by external threads.
+   */
+  std::vector<std::unique_ptr<Queue>> _queues;
+
+  /** @brief Worker threads.
+   */
+  std::vector<std::thread> _workers;
+
+  /** @brief Number of tasks sitting in queues.
+   */
+  std::atomic<std::size_t> _queued;
+
+  /** @brief Number of workers currently asleep.
+   */
+  std::atomic<std::size_t> _sleeping;
+
+  /** @brief Flag requesting the workers to exit.
+   */
+  std::atomic<bool> _stop;
+
+  std::mutex _mutex;
+  std::condition_variable _condition;
+
+  /** @brief Attempts to take a task from the given queue.
+   *
+   *  @param[in]  i    Queue index.
+   *  @param[in]  back Whether to take the newest rather than oldest task.
+   *  @param[out] task Task taken from the queue.
+   *
+   *  @return True if a task was taken.
+   */
+  bool _take(std::size_t i, bool back, Task &task);
+
+  /** @brief Attempts to find a task starting with the given queue and stealing
+   *         from all others otherwise.
+   *
+   *  @param[in]  i    Index of the preferred queue.
+   *  @param[out] task Task found.
+   *
+   *  @return True if a task was found.
+   */
+  bool _find(std::size_t i, Task &task);
+
+  /** @brief Worker thread loop.
+   *
+   *  @param[in] i Index of the worker's queue.
+   */
+  void _work(std::size_t i);
+
+ public:
+  ThreadPool() = delete;
+  ThreadPool(ThreadPool const &) = delete;
+  ThreadPool(ThreadPool &&) = delete;
+  ThreadPool &operator=(ThreadPool const &) = delete;
+  ThreadPool &operator=(ThreadPool &&) = delete;
+
+  /** @param[in] workers Number of worker threads.
+   *
+   *  Threads calling `help` also execute tasks so a pool with `n - 1` workers
+   *  is typically used to run work on `n` cores.
+   */
+  explicit ThreadPool(std::size_t workers);
+
+  /** @brief Stops and joins all workers.
+   *
+   *  Tasks remaining in the queues are discarded.
+   */
+  ~ThreadPool();
+
+  /** @return Number of worker threads.
+   */
+  std::size_t size() const;
+
+  /** @brief Submits a new task to the pool.
+   *
+   *  @param[in] task Task to execute.
+   */
+  void submit(Task task);
+
+  /** @brief Executes one queued task on the calling thread.
+   *
+   *  @return True if a task was executed and false if no task was found.
+   */
+  bool help();
+
+  /** @brief Calls a function for every index in a range using the pool.
+   *
+   *  @tparam F Callable invoked as `f(i)`.
+   *
+   *  @param[in] n Number of indices.
+   *  @param[in] f Function.
+   *
+   *  Indices are handed out one at a time to the workers and the calling
+   *  thread, which returns once every index has been processed. If the
+   *  function throws, the remaining indices are skipped and the first exception
+   *  is rethrown.
+   */
+  template <typename F>
+  void for_each(std::size_t n, F const &f);
+};
+
+template <typename F>
+void ThreadPool::for_each(std::size_t n, F const &f) {
+  struct Loop {
+    F const &f;
+    std::size_t const n;
+    std::atomic<std::size_t> next;
+    std::atomic<std::size_t> running;
+    std::atomic<bool> failed;
+    std::exception_ptr exception;
+    std::mutex mutex;
+
+    Loop(F const &f, std::size_t n)
+      : f(f), n(n), next(0), running(0), failed(false) {}
+
+    void work() {
+      for (std::size_t i = next++; i < n && !failed; i = next++) {
+        try {
+          f(i);
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(mutex);
+          if (!exception)
+            exception = std::current_exception();
+          failed = true;
+        }
+      }
+    }
+
+    static void task(void *data) {
+      auto *loop = static_cast<Loop *>(data);
+      loop->work();
+      loop->running--;
+    }
+  };
+
+  Loop loop(f, n);
+
+  // Workers may only pick up their task once the caller is already done so
+  // the caller must wait for every task to finish, not just every index.
+  auto const tasks = std::min(n, _workers.size());
+  loop.running = tasks;
+  for (std::size_t i = 0; i < tasks; i++)
+    submit({&Loop::task, &loop});
+
+  loop.work();
+  while (loop.running > 0)
+    if (!help())
+      std::this_thread::yield();
+
+  if (loop.failed)
+    std::rethrow_exception(loop.exception);
+}
+} // namespace psim
+
+#endif
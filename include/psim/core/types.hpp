@@ -92,6 +92,65 @@ using Matrix = lin::Matrix<Real, R, C, MR, MC>;
  */
 using RandomsGenerator = lin::internal::RandomsGenerator;
 
+/** @brief Runtime tag identifying the underlying type of state fields and
+ *         parameters.
+ *
+ *  Each of the types transactable to and from Python has its own tag. All other
+ *  underlying types share the unknown tag.
+ */
+enum class TypeTag {
+  Unknown,
+  Boolean,
+  Integer,
+  Real,
+  Vector2,
+  Vector3,
+  Vector4
+};
+
+/** @return Type tag associated with the underlying type.
+ *
+ *  @tparam T Underlying type.
+ *
+ *  @{
+ */
+template <typename T>
+constexpr TypeTag type_tag() {
+  return TypeTag::Unknown;
+}
+
+template <>
+constexpr TypeTag type_tag<Boolean>() {
+  return TypeTag::Boolean;
+}
+
+template <>
+constexpr TypeTag type_tag<Integer>() {
+  return TypeTag::Integer;
+}
+
+template <>
+constexpr TypeTag type_tag<Real>() {
+  return TypeTag::Real;
+}
+
+template <>
+constexpr TypeTag type_tag<Vector2>() {
+  return TypeTag::Vector2;
+}
+
+template <>
+constexpr TypeTag type_tag<Vector3>() {
+  return TypeTag::Vector3;
+}
+
+template <>
+constexpr TypeTag type_tag<Vector4>() {
+  return TypeTag::Vector4;
+}
+/** @}
+ */
+
 } // namespace psim
 
 #endif
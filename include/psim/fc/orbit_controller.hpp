@@ -54,6 +54,8 @@ class OrbitController : public OrbitControllerInterface<OrbitController> {
   virtual ~OrbitController() = default;
   virtual void add_fields(State &state) override;
   virtual void step() override;
+  virtual void checkpoint(Checkpoint &checkpoint) const override;
+  virtual void restore(Checkpoint::Reader &reader) override;
 };
 } // namespace psim
 
@@ -51,6 +51,8 @@ class OrbOrbitEstimator : public OrbitEstimatorInterface<OrbOrbitEstimator> {
 
   virtual void add_fields(State &state) override;
   virtual void step() override;
+  virtual void checkpoint(Checkpoint &checkpoint) const override;
+  virtual void restore(Checkpoint::Reader &reader) override;
 
   Vector3 fc_satellite_orbit_r_error() const;
   Vector3 fc_satellite_orbit_r_sigma() const;
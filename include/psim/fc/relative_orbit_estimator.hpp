@@ -57,6 +57,8 @@ class RelativeOrbitEstimator : public RelativeOrbitEstimatorInterface<RelativeOr
 
   virtual void add_fields(State &state) override;
   virtual void step() override;
+  virtual void checkpoint(Checkpoint &checkpoint) const override;
+  virtual void restore(Checkpoint::Reader &reader) override;
 
   Vector3 fc_satellite_relative_orbit_dr_error() const;
   Vector3 fc_satellite_relative_orbit_r_hill_error() const;
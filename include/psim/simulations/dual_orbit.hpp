@@ -30,14 +30,27 @@
 #define PSIM_SIMULATIONS_DUAL_ORBIT_HPP_
 
 #include <psim/core/configuration.hpp>
-#include <psim/core/model_list.hpp>
+#include <psim/core/static_model_list.hpp>
+#include <psim/sensors/cdgps_no_attitude.hpp>
+#include <psim/sensors/satellite_sensors.hpp>
+#include <psim/truth/earth.hpp>
+#include <psim/truth/hill_frame.hpp>
+#include <psim/truth/satellite_truth.hpp>
+#include <psim/truth/time.hpp>
+#include <psim/utilities/norm_vector3.hpp>
 
 namespace psim {
 
 /** @brief Models orbital dynamics for two satellites. All models are backed by
  *         flight software's GNC implementations if possible.
  */
-class DualOrbitGnc : public ModelList {
+class DualOrbitGnc : public StaticModelList<Time, EarthGnc,
+                         SatelliteTruthNoAttitudeGnc,
+                         SatelliteTruthNoAttitudeGnc, HillFrameEci,
+                         HillFrameEci, NormVector3, NormVector3,
+                         SatelliteSensorsNoAttitude,
+                         SatelliteSensorsNoAttitude, CdgpsNoAttitude,
+                         CdgpsNoAttitude> {
  public:
   DualOrbitGnc() = delete;
   virtual ~DualOrbitGnc() = default;
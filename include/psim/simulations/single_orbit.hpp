@@ -30,14 +30,20 @@
 #define PSIM_SIMULATIONS_SINGLE_ORBIT_HPP_
 
 #include <psim/core/configuration.hpp>
-#include <psim/core/model_list.hpp>
+#include <psim/core/static_model_list.hpp>
+#include <psim/sensors/satellite_sensors.hpp>
+#include <psim/truth/earth.hpp>
+#include <psim/truth/satellite_truth.hpp>
+#include <psim/truth/time.hpp>
 
 namespace psim {
 
 /** @brief Models a single satellite's orbital dynamics. All models are backed
  *         by flight software's GNC implementations if possible.
  */
-class SingleOrbitGnc : public ModelList {
+class SingleOrbitGnc : public StaticModelList<Time, EarthGnc,
+                           SatelliteTruthNoAttitudeGnc,
+                           SatelliteSensorsNoAttitude> {
  public:
   SingleOrbitGnc() = delete;
   virtual ~SingleOrbitGnc() = default;
@@ -31,17 +31,33 @@
 
 #include <psim/truth/attitude_orbit.yml.hpp>
 
+#include <psim/truth/gravity_grid.hpp>
+
 #include <gnc/ode4.hpp>
+#include <gnc/ode45.hpp>
+
+#include <string>
 
 namespace psim {
 
 /** @brief Simulates attitude dynamics without fuel slosh and propagates the
  *         orbital state with a Keplerian model in ECI.
+ *
+ *  Supports adaptive integration and the gravity grid in the same way as
+ *  `OrbitEcef`. Actuator
+ *  inputs are held constant over a timestep so large timesteps are only
+ *  appropriate if actuators aren't being commanded.
  */
 class AttitudeOrbitNoFuelEcef : public AttitudeOrbit<AttitudeOrbitNoFuelEcef> {
  private:
   typedef AttitudeOrbit<AttitudeOrbitNoFuelEcef> Super;
   gnc::Ode4<Real, 16> ode;
+  gnc::Ode45<Real, 16> adaptive_ode;
+  bool adaptive = false;
+  GravityGrid const *grid = nullptr;
+  std::string const satellite;
+
+  void configure_integrator(Configuration const &config);
 
  public:
   AttitudeOrbitNoFuelEcef() = delete;
@@ -52,6 +68,10 @@ class AttitudeOrbitNoFuelEcef : public AttitudeOrbit<AttitudeOrbitNoFuelEcef> {
   AttitudeOrbitNoFuelEcef(RandomsGenerator &randoms,
       Configuration const &config, std::string const &satellite);
 
+  /** @brief Rereads the adaptive integration tolerances and gravity backend.
+   */
+  virtual void configure(Configuration const &config) override;
+
   virtual void step() override;
 
   Real truth_satellite_orbit_altitude() const;
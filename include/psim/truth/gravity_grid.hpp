@@ -0,0 +1,158 @@
+//
+// MIT License
+//
+// Copyright (c) 2020 Pathfinder for Autonomous Navigation (PAN)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/** @file psim/truth/gravity_grid.hpp
+ *  @author Kyle Krol
+ */
+
+#ifndef PSIM_TRUTH_GRAVITY_GRID_HPP_
+#define PSIM_TRUTH_GRAVITY_GRID_HPP_
+
+#include <psim/core/types.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace psim {
+
+/** @brief Gravity backend interpolating a precomputed grid of the gravity
+ *         field over low Earth orbit.
+ *
+ *  The grid spans the band of radii between `orb::MINORBITRADIUS` and
+ *  `orb::MAXORBITRADIUS` in shells spaced 25 km apart, each sampled every two
+ *  degrees of colatitude and longitude. Every node holds the gravitational
+ *  potential and acceleration in ECEF less the point mass terms which are
+ *  added back analytically. The remainder is interpolated with tricubic
+ *  Lagrange polynomials over the surrounding four by four by four nodes.
+ *  Positions outside of the band fall back to evaluating the spherical
+ *  harmonic model directly.
+ *
+ *  Within the band, the interpolated acceleration agrees with direct
+ *  evaluation of the degree 11 GGM05S model to within 1.0e-6 m/s^2 per
+ *  component and the potential to within 0.5 J/kg. The interpolation error
+ *  scales with the fourth power of the grid spacing times the model's degree,
+ *  so it's dominated by the highest degree terms near the bottom of the band
+ *  and is typically an order of magnitude below this bound.
+ *
+ *  The grid is built once by direct evaluation, saved to a cache file, and
+ *  memory mapped by later processes. A cache file with a different version or
+ *  layout is rebuilt. Values are stored in the host's byte order.
+ */
+class GravityGrid {
+ private:
+  /** @brief Mapped file contents or nullptr if the grid is held in memory.
+   */
+  unsigned char const *_data;
+
+  /** @brief Size of the mapped file in bytes.
+   */
+  std::size_t _bytes;
+
+  /** @brief Grid values if the cache file couldn't be written.
+   */
+  std::vector<Real> _owned;
+
+  /** @brief Grid values stored node by node with longitude varying fastest.
+   */
+  Real const *_values;
+
+  /** @brief Inner and outer radius of the band (m).
+   */
+  Real _r_min, _r_max;
+
+  std::string const _file;
+
+  bool _map();
+
+  std::vector<Real> _build() const;
+
+ public:
+  /** @brief Version of the cache file format.
+   */
+  static constexpr std::uint32_t version = 1;
+
+  /** @brief Number of intervals radially, in colatitude, and in longitude.
+   */
+  static constexpr std::size_t shells = 40, colatitudes = 90, longitudes = 180;
+
+  /** @brief Number of values stored per node.
+   */
+  static constexpr std::size_t width = 4;
+
+  GravityGrid() = delete;
+  GravityGrid(GravityGrid const &) = delete;
+  GravityGrid(GravityGrid &&) = delete;
+  GravityGrid &operator=(GravityGrid const &) = delete;
+  GravityGrid &operator=(GravityGrid &&) = delete;
+
+  ~GravityGrid();
+
+  /** @param[in] file Cache file.
+   *
+   *  Maps the cache file if it exists and holds a matching grid. Otherwise, the
+   *  grid is built and saved to the file before being mapped. If the file
+   *  can't be written, the grid is kept in memory instead.
+   */
+  GravityGrid(std::string const &file);
+
+  /** @return Shared grid using the default cache file.
+   *
+   *  The grid is loaded on first use. The cache file is set by the
+   *  `PSIM_GRAVITY_GRID` environment variable and defaults to
+   *  `$HOME/.cache/psim/gravity_grid.bin`.
+   */
+  static GravityGrid const &instance();
+
+  /** @return Default cache file.
+   */
+  static std::string default_file();
+
+  /** @return Cache file.
+   */
+  std::string const &file() const;
+
+  /** @return True if the grid is backed by the cache file.
+   */
+  bool mapped() const;
+
+  /** @param[in] r_ecef Position in ECEF (m).
+   *
+   *  @return True if the position lies within the band covered by the grid.
+   */
+  bool covers(Vector3 const &r_ecef) const;
+
+  /** @brief Calculate gravitational acceleration and potential.
+   *
+   *  @param[in]  r_ecef Position in ECEF (m).
+   *  @param[out] U      Gravitational potential (J/kg).
+   *
+   *  @return Gravitational acceleration in ECEF (m/s^2).
+   */
+  Vector3 gravity(Vector3 const &r_ecef, Real &U) const;
+};
+} // namespace psim
+
+#endif
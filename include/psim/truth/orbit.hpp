@@ -31,16 +31,40 @@
 
 #include <psim/truth/orbit.yml.hpp>
 
+#include <psim/truth/gravity_grid.hpp>
+
 #include <gnc/ode4.hpp>
+#include <gnc/ode45.hpp>
+
+#include <string>
 
 namespace psim {
 
 /** @brief Orbit propagator in ECEF.
+ *
+ *  The orbit is integrated with a fourth order fixed step size method over
+ *  each timestep unless adaptive integration is requested by setting
+ *  `truth.{satellite}.orbit.rel_tol` and `truth.{satellite}.orbit.abs_tol`.
+ *  Then a fourth-fifth order variable step size method is used which takes as
+ *  many internal steps as the tolerances require. Accuracy is then held by the
+ *  tolerances rather than the timestep so `truth.dt.ns` can be made large
+ *  (i.e. tens of seconds) for orbit only simulations. Note that thruster
+ *  impulses are still only applied at the start of a timestep.
+ *
+ *  Gravity is evaluated directly from the spherical harmonic model unless
+ *  `truth.gravity.grid` is set to true in which case the shared
+ *  `GravityGrid` is interpolated instead.
  */
 class OrbitEcef : public Orbit<OrbitEcef> {
  private:
   typedef Orbit<OrbitEcef> Super;
   gnc::Ode4<Real, 6> ode;
+  gnc::Ode45<Real, 6> adaptive_ode;
+  bool adaptive = false;
+  GravityGrid const *grid = nullptr;
+  std::string const satellite;
+
+  void configure_integrator(Configuration const &config);
 
  public:
   OrbitEcef() = delete;
@@ -51,6 +75,10 @@ class OrbitEcef : public Orbit<OrbitEcef> {
   OrbitEcef(RandomsGenerator &randoms, Configuration const &config,
       std::string const &satellite);
 
+  /** @brief Rereads the adaptive integration tolerances and gravity backend.
+   */
+  virtual void configure(Configuration const &config) override;
+
   virtual void step() override;
 
   Real truth_satellite_orbit_altitude() const;
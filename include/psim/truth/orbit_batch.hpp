@@ -0,0 +1,183 @@
+//
+// MIT License
+//
+// Copyright (c) 2020 Pathfinder for Autonomous Navigation (PAN)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/** @file psim/truth/orbit_batch.hpp
+ *  @author Kyle Krol
+ */
+
+#ifndef PSIM_TRUTH_ORBIT_BATCH_HPP_
+#define PSIM_TRUTH_ORBIT_BATCH_HPP_
+
+#include <psim/core/thread_pool.hpp>
+#include <psim/core/types.hpp>
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace psim {
+
+/** @brief Propagates a batch of independent point mass orbits in ECEF.
+ *
+ *  Implements the same dynamics and fourth order Runge Kutta integration as
+ *  `OrbitEcef` for many satellites stepped in lockstep (i.e. the members of a
+ *  Monte Carlo dispersion study). The batch is stored as a structure of arrays
+ *  with one contiguous column per position and velocity component.
+ *
+ *  Satellites are processed in fixed size chunks which keeps the integrator's
+ *  scratch columns in cache. Within a chunk, gravity and drag are evaluated
+ *  satellite by satellite through the same scalar helpers `OrbitEcef` uses and
+ *  dominate the cost of a step. The rotating frame terms and the integrator
+ *  updates are loops over the columns but there are no SIMD code paths. The
+ *  batch's gains over separate `OrbitEcef` models come from skipping the per
+ *  model state and lazy field overhead and from stepping chunks concurrently
+ *  if the batch has been parallelized; see `//bench:truth`.
+ *
+ *  All satellites share Earth's angular rate and the timestep.
+ */
+class OrbitEcefBatch {
+ private:
+  /** @brief Position and velocity columns in the order r.x, r.y, r.z, v.x, v.y,
+   *         and v.z.
+   */
+  typedef std::array<std::vector<Real>, 6> Columns;
+
+  /** @brief Number of satellites per chunk.
+   */
+  static constexpr std::size_t _chunk = 64;
+
+  /** @brief Number of satellites.
+   */
+  std::size_t _size;
+
+  /** @brief Satellite positions and velocities.
+   */
+  Columns _x;
+
+  /** @brief Satellite masses.
+   */
+  std::vector<Real> _m;
+
+  /** @brief Satellite areas projected along the direction of travel.
+   */
+  std::vector<Real> _S;
+
+  /** @brief Integrator scratch columns.
+   */
+  Columns _ks, _k1, _k2, _k3, _k4;
+
+  /** @brief Drag acceleration per unit velocity scratch column.
+   */
+  std::vector<Real> _drag;
+
+  /** @brief Thread pool chunks are stepped on (may be null).
+   */
+  ThreadPool *_pool = nullptr;
+
+  void _derivative(Real t, Vector3 const &earth_w, Vector3 const &earth_w_dot,
+      Columns const &x, Columns &dx, std::size_t begin, std::size_t end);
+
+  void _step(Real dt, Vector3 const &earth_w, Vector3 const &earth_w_dot,
+      std::size_t begin, std::size_t end);
+
+ public:
+  OrbitEcefBatch() = delete;
+  OrbitEcefBatch(OrbitEcefBatch const &) = delete;
+  OrbitEcefBatch(OrbitEcefBatch &&) = default;
+  OrbitEcefBatch &operator=(OrbitEcefBatch const &) = delete;
+  OrbitEcefBatch &operator=(OrbitEcefBatch &&) = default;
+
+  ~OrbitEcefBatch() = default;
+
+  /** @brief Creates a batch of satellites at the origin with no mass.
+   *
+   *  @param[in] n Number of satellites.
+   *
+   *  Every satellite must be set before stepping the batch.
+   */
+  OrbitEcefBatch(std::size_t n);
+
+  /** @return Number of satellites.
+   */
+  std::size_t size() const;
+
+  /** @brief Sets a satellite's orbit and physical parameters.
+   *
+   *  @param[in] i      Satellite index.
+   *  @param[in] r_ecef Position in ECEF (m).
+   *  @param[in] v_ecef Velocity in ECEF (m/s).
+   *  @param[in] m      Satellite mass (kg).
+   *  @param[in] S      Area projected along the direction of travel (m^2).
+   */
+  void set(std::size_t i, Vector3 const &r_ecef, Vector3 const &v_ecef, Real m,
+      Real S);
+
+  /** @param[in] i Satellite index.
+   *
+   *  @return Position in ECEF (m).
+   */
+  Vector3 r(std::size_t i) const;
+
+  /** @param[in] i Satellite index.
+   *
+   *  @return Velocity in ECEF (m/s).
+   */
+  Vector3 v(std::size_t i) const;
+
+  /** @param[in] j Component index in the order r.x, r.y, r.z, v.x, v.y, and
+   *               v.z.
+   *
+   *  @return Pointer to the start of the component's column.
+   */
+  Real const *column(std::size_t j) const;
+
+  /** @brief Applies an instantaneous impulse to a satellite.
+   *
+   *  @param[in] i      Satellite index.
+   *  @param[in] J_ecef Impulse in ECEF (kg m/s).
+   *
+   *  Mirrors how `OrbitEcef` applies thruster firings at the start of a step.
+   */
+  void impulse(std::size_t i, Vector3 const &J_ecef);
+
+  /** @brief Steps chunks of the batch concurrently.
+   *
+   *  @param[in] pool Thread pool which must outlive the batch.
+   *
+   *  Chunks share no state so the results are identical to stepping in series.
+   */
+  void parallelize(ThreadPool &pool);
+
+  /** @brief Steps every satellite forward in time.
+   *
+   *  @param[in] dt          Timestep (s).
+   *  @param[in] earth_w     Earth's angular rate in ECEF (rad/s).
+   *  @param[in] earth_w_dot Time derivative of Earth's angular rate in ECEF
+   *                         (rad/s^2).
+   */
+  void step(Real dt, Vector3 const &earth_w, Vector3 const &earth_w_dot);
+};
+} // namespace psim
+
+#endif
@@ -9,7 +9,12 @@ from .plugins import (
 )
 
 from .simulation import (
+    Checkpoint,
     Configuration,
+    Ensemble,
+    FieldSet,
+    Profiler,
     Simulation,
     SimulationRunner,
+    TelemetryReader,
 )
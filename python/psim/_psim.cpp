@@ -28,10 +28,19 @@
 
 #include <mapbox/variant.hpp>
 
+#include <psim/core/async_telemetry.hpp>
+#include <psim/core/checkpoint.hpp>
 #include <psim/core/configuration.hpp>
+#include <psim/core/ensemble.hpp>
+#include <psim/core/field_set.hpp>
 #include <psim/core/parameter.hpp>
+#include <psim/core/profiler.hpp>
+#include <psim/core/pyramid.hpp>
+#include <psim/core/recorder.hpp>
 #include <psim/core/simulation.hpp>
 #include <psim/core/state_field.hpp>
+#include <psim/core/state_field_lazy_base.hpp>
+#include <psim/core/telemetry.hpp>
 #include <psim/core/types.hpp>
 
 #include <psim/simulations/attitude_estimator_test.hpp>
@@ -44,10 +53,15 @@
 #include <psim/simulations/single_attitude_orbit.hpp>
 #include <psim/simulations/single_orbit.hpp>
 
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
 #include <iostream>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
 
 namespace pybind11 {
 namespace detail {
@@ -75,13 +89,18 @@ using PyVariant = mapbox::util::variant<
 
 namespace py = pybind11;
 
-class PyConfiguration : public psim::Configuration {
- private:
-  template <typename T>
-  void _set(std::string const &name, T const &value) {
-    _parameters[name] = std::make_unique<psim::Parameter<T>>(name, value);
-  }
+static void py_configure(psim::Configuration &config, std::string const &name, PyVariant const &value) {
+  value.match(
+    [&](psim::Real    const &v) { config.set(name, v); },
+    [&](psim::Boolean const &v) { config.set(name, v); },
+    [&](psim::Integer const &v) { config.set(name, v); },
+    [&](psim::Vector2 const &v) { config.set(name, v); },
+    [&](psim::Vector3 const &v) { config.set(name, v); },
+    [&](psim::Vector4 const &v) { config.set(name, v); }
+  );
+}
 
+class PyConfiguration : public psim::Configuration {
  public:
   using psim::Configuration::Configuration;
 
@@ -91,42 +110,20 @@ class PyConfiguration : public psim::Configuration {
     auto const *param = this->psim::Configuration::get(name);
     if (!param)
       throw std::runtime_error("Parameter '" + name + "' does not exist.");
-    {
-      auto const *ptr = dynamic_cast<psim::Parameter<psim::Vector3> const *>(param);
-      if (ptr) return ptr->get();
-    }
-    {
-      auto const *ptr = dynamic_cast<psim::Parameter<psim::Vector4> const *>(param);
-      if (ptr) return ptr->get();
-    }
-    {
-      auto const *ptr = dynamic_cast<psim::Parameter<psim::Real> const *>(param);
-      if (ptr) return ptr->get();
-    }
-    {
-      auto const *ptr = dynamic_cast<psim::Parameter<psim::Boolean> const *>(param);
-      if (ptr) return ptr->get();
-    }
-    {
-      auto const *ptr = dynamic_cast<psim::Parameter<psim::Integer> const *>(param);
-      if (ptr) return ptr->get();
-    }
-    {
-      auto const *ptr = dynamic_cast<psim::Parameter<psim::Vector2> const *>(param);
-      if (ptr) return ptr->get();
+    switch (param->tag()) {
+      case psim::TypeTag::Boolean: return param->get<psim::Boolean>();
+      case psim::TypeTag::Integer: return param->get<psim::Integer>();
+      case psim::TypeTag::Real:    return param->get<psim::Real>();
+      case psim::TypeTag::Vector2: return param->get<psim::Vector2>();
+      case psim::TypeTag::Vector3: return param->get<psim::Vector3>();
+      case psim::TypeTag::Vector4: return param->get<psim::Vector4>();
+      default:                     break;
     }
     throw std::runtime_error("Parameter '" + name + "' holds an unsupported type.");
   }
 
   void set(std::string const &name, PyVariant const &value) {
-    value.match(
-      [&](psim::Real    const &v) { this->_set(name, v); },
-      [&](psim::Boolean const &v) { this->_set(name, v); },
-      [&](psim::Integer const &v) { this->_set(name, v); },
-      [&](psim::Vector2 const &v) { this->_set(name, v); },
-      [&](psim::Vector3 const &v) { this->_set(name, v); },
-      [&](psim::Vector4 const &v) { this->_set(name, v); }
-    );
+    py_configure(*this, name, value);
   }
 };
 
@@ -139,66 +136,437 @@ void py_configuration(py::module &m) {
     .def("__setitem__", [](PyConfiguration &self, std::string const &name, PyVariant const &value) { self.set(name, value); });
 }
 
+void py_checkpoint(py::module &m) {
+  py::class_<psim::Checkpoint>(m, "Checkpoint")
+    .def(py::init([](std::string const &file) { return new psim::Checkpoint(file); }))
+    .def("__len__", [](psim::Checkpoint const &self) { return self.size(); })
+    .def("save", [](psim::Checkpoint const &self, std::string const &file) { self.save(file); });
+}
+
+/* The profiler is process wide so it's exposed as a class with only static
+ * methods. Summary times are converted to seconds.
+ */
+void py_profiler(py::module &m) {
+  py::class_<psim::Profiler>(m, "Profiler")
+    .def_static("enable", &psim::Profiler::enable)
+    .def_static("disable", &psim::Profiler::disable)
+    .def_static("enabled", &psim::Profiler::enabled)
+    .def_static("clear", &psim::Profiler::clear)
+    .def_static("report", &psim::Profiler::report)
+    .def_static("save", &psim::Profiler::save)
+    .def_static("summary", []() {
+      py::list summary;
+      for (auto const &entry : psim::Profiler::summary()) {
+        py::dict dict;
+        dict["category"] = entry.category;
+        dict["name"] = entry.name;
+        dict["calls"] = entry.calls;
+        dict["total"] = entry.total * 1.0e-9;
+        dict["self"] = entry.self * 1.0e-9;
+        summary.append(dict);
+      }
+      return summary;
+    });
+}
+
+/* Recorder columns are viewed in place by read only numpy arrays. Each view
+ * holds the column's buffer through a capsule and the recorder moves to a new
+ * buffer, rather than reallocating or overwriting a held one, so views stay
+ * valid as samples are recorded and the recorder is cleared.
+ */
+template <typename T>
+static py::array py_view(std::shared_ptr<std::vector<T> const> buffer, std::size_t n) {
+  auto const *data = buffer->data();
+  auto *held = new std::shared_ptr<std::vector<T> const>(std::move(buffer));
+  py::capsule base(held, [](void *ptr) {
+    delete static_cast<std::shared_ptr<std::vector<T> const> *>(ptr);
+  });
+  py::array_t<T> array(static_cast<py::ssize_t>(n), data, base);
+  array.attr("setflags")(py::arg("write") = false);
+  return array;
+}
+
+void py_recorder(py::module &m) {
+  py::class_<psim::Recorder, std::shared_ptr<psim::Recorder>>(m, "Recorder")
+    .def("__len__", [](psim::Recorder const &self) { return self.size(); })
+    .def("__contains__", [](psim::Recorder const &self, std::string const &name) { return self.has(name); })
+    .def("__getitem__", [](psim::Recorder const &self, std::string const &name) -> py::array {
+      if (self.is_integer(name))
+        return py_view(self.integer_buffer(name), self.size());
+      else
+        return py_view(self.real_buffer(name), self.size());
+    })
+    .def_property_readonly("columns", [](psim::Recorder const &self) { return self.columns(); })
+    .def_property_readonly("decimation", [](psim::Recorder const &self) { return self.decimation(); })
+    .def("clear", [](psim::Recorder &self) { self.clear(); });
+}
+
+/* Telemetry logs are written while the simulation steps and closed explicitly
+ * or when the last reference is dropped. Columns read back from a telemetry file
+ * are copied out of the mapped chunks into a single numpy array while each chunk
+ * can be viewed in place with the reader kept alive as the base object.
+ */
+void py_telemetry(py::module &m) {
+  py::class_<psim::TelemetrySink, std::shared_ptr<psim::TelemetrySink>>(m, "TelemetrySink")
+    .def("close", [](psim::TelemetrySink &self) { self.close(); });
+
+  py::class_<psim::TelemetryWriter, psim::TelemetrySink, std::shared_ptr<psim::TelemetryWriter>>(m, "TelemetryWriter")
+    .def("__len__", [](psim::TelemetryWriter const &self) { return self.size(); })
+    .def_property_readonly("columns", [](psim::TelemetryWriter const &self) { return self.columns(); })
+    .def_property_readonly("file", [](psim::TelemetryWriter const &self) { return self.file(); })
+    .def("flush", [](psim::TelemetryWriter &self) { self.flush(); });
+
+  /* Closing waits on the writer thread so the GIL is released. Stall times are
+   * converted to seconds.
+   */
+  py::class_<psim::AsyncTelemetryWriter, psim::TelemetrySink, std::shared_ptr<psim::AsyncTelemetryWriter>>(m, "AsyncTelemetryWriter")
+    .def_property_readonly("columns", [](psim::AsyncTelemetryWriter const &self) { return self.columns(); })
+    .def_property_readonly("file", [](psim::AsyncTelemetryWriter const &self) { return self.file(); })
+    .def("close", [](psim::AsyncTelemetryWriter &self) { self.close(); }, py::call_guard<py::gil_scoped_release>())
+    .def("stats", [](psim::AsyncTelemetryWriter const &self) {
+      auto const stats = self.stats();
+      py::dict dict;
+      dict["samples"] = stats.samples;
+      dict["written"] = stats.written;
+      dict["dropped"] = stats.dropped;
+      dict["stalls"] = stats.stalls;
+      dict["stall_time"] = stats.stall_ns * 1.0e-9;
+      dict["depth"] = stats.depth;
+      dict["max_depth"] = stats.max_depth;
+      return dict;
+    });
+
+  py::class_<psim::TelemetryReader>(m, "TelemetryReader")
+    .def(py::init([](std::string const &file) { return new psim::TelemetryReader(file); }))
+    .def("__len__", [](psim::TelemetryReader const &self) { return self.size(); })
+    .def("__contains__", [](psim::TelemetryReader const &self, std::string const &name) { return self.has(name); })
+    .def("__getitem__", [](psim::TelemetryReader const &self, std::string const &name) -> py::array {
+      auto const n = static_cast<py::ssize_t>(self.size());
+      if (self.is_integer(name)) {
+        py::array_t<psim::Integer> column(n);
+        self.read(name, column.mutable_data());
+        return column;
+      } else {
+        py::array_t<psim::Real> column(n);
+        self.read(name, column.mutable_data());
+        return column;
+      }
+    })
+    .def("chunk", [](py::object self, std::string const &name, std::size_t i) -> py::array {
+      auto const &reader = self.cast<psim::TelemetryReader const &>();
+      auto const n = static_cast<py::ssize_t>(reader.chunk_size(i));
+      if (reader.is_integer(name))
+        return py::array_t<psim::Integer>(n, reader.integers(name, i), self);
+      else
+        return py::array_t<psim::Real>(n, reader.reals(name, i), self);
+    })
+    .def_property_readonly("columns", [](psim::TelemetryReader const &self) { return self.columns(); })
+    .def_property_readonly("chunks", [](psim::TelemetryReader const &self) { return self.chunks(); });
+}
+
+/* Pyramid statistics are copied into new numpy arrays, as with recorder columns,
+ * because each level's buffers reallocate as buckets complete.
+ */
+void py_pyramid(py::module &m) {
+  using Statistic = psim::Real const *(psim::Pyramid::*)(std::string const &, std::size_t) const;
+
+  auto const copy = [](Statistic statistic) {
+    return [statistic](psim::Pyramid const &self, std::string const &name, std::size_t level) {
+      auto const n = static_cast<py::ssize_t>(self.size(level));
+      return py::array_t<psim::Real>(n, (self.*statistic)(name, level));
+    };
+  };
+
+  py::class_<psim::Pyramid, psim::TelemetrySink, std::shared_ptr<psim::Pyramid>>(m, "Pyramid")
+    .def("__len__", [](psim::Pyramid const &self) { return self.size(); })
+    .def("__contains__", [](psim::Pyramid const &self, std::string const &name) { return self.has(name); })
+    .def_property_readonly("columns", [](psim::Pyramid const &self) { return self.columns(); })
+    .def_property_readonly("levels", [](psim::Pyramid const &self) { return self.levels(); })
+    .def("bucket", [](psim::Pyramid const &self, std::size_t level) { return self.bucket(level); })
+    .def("size", [](psim::Pyramid const &self, std::size_t level) { return self.size(level); })
+    .def("select", [](psim::Pyramid const &self, std::size_t samples, std::size_t points) { return self.select(samples, points); })
+    .def("min", copy(&psim::Pyramid::min))
+    .def("max", copy(&psim::Pyramid::max))
+    .def("mean", copy(&psim::Pyramid::mean));
+}
+
+/* Field sets copy their values into a buffer owned by the field set which is
+ * returned on every call. The dictionary of numpy views into the buffer, one per
+ * field, is built once as well. Both are overwritten by the next read so callers
+ * should copy values they want to keep. The simulation is kept alive for as long
+ * as the field set is.
+ */
+class PyFieldSet {
+ private:
+  psim::State const *_state;
+  psim::FieldSet _set;
+  py::array_t<psim::Real> _buffer;
+  py::dict _views;
+
+ public:
+  PyFieldSet(psim::State &state, std::vector<std::string> const &fields)
+    : _state(&state), _set(state, fields), _buffer(static_cast<py::ssize_t>(_set.size())) {
+    auto *data = _buffer.mutable_data();
+    for (std::size_t i = 0; i < fields.size(); i++) {
+      auto *ptr = data + _set.offset(i);
+      switch (_set.tag(i)) {
+        case psim::TypeTag::Vector2:
+        case psim::TypeTag::Vector3:
+        case psim::TypeTag::Vector4:
+          _views[py::str(fields[i])] = py::array_t<psim::Real>(static_cast<py::ssize_t>(_set.width(i)), ptr, _buffer);
+          break;
+        default:
+          _views[py::str(fields[i])] = py::array_t<psim::Real>(std::vector<py::ssize_t>(), ptr, _buffer);
+          break;
+      }
+    }
+  }
+
+  psim::FieldSet const &set() const {
+    return _set;
+  }
+
+  void check(psim::State const &state) const {
+    if (&state != _state)
+      throw std::runtime_error("Field set was resolved against a different simulation.");
+  }
+
+  py::array_t<psim::Real> get() {
+    _set.get(_buffer.mutable_data());
+    return _buffer;
+  }
+
+  py::dict get_dict() {
+    _set.get(_buffer.mutable_data());
+    return _views;
+  }
+
+  void set(py::array_t<psim::Real, py::array::c_style | py::array::forcecast> const &values) {
+    if (values.ndim() != 1 || static_cast<std::size_t>(values.size()) != _set.size())
+      throw std::runtime_error("Field set expected " + std::to_string(_set.size()) + " values.");
+    _set.set(values.data());
+  }
+};
+
+void py_field_set(py::module &m) {
+  py::class_<PyFieldSet>(m, "FieldSet")
+    .def("__len__", [](PyFieldSet const &self) { return self.set().fields().size(); })
+    .def_property_readonly("fields", [](PyFieldSet const &self) { return self.set().fields(); })
+    .def_property_readonly("size", [](PyFieldSet const &self) { return self.set().size(); })
+    .def_property_readonly("writable", [](PyFieldSet const &self) { return self.set().writable(); })
+    .def("get", [](PyFieldSet &self) { return self.get(); })
+    .def("get_dict", [](PyFieldSet &self) { return self.get_dict(); })
+    .def("set", [](PyFieldSet &self, py::array_t<psim::Real, py::array::c_style | py::array::forcecast> const &values) { self.set(values); });
+}
+
 template <typename T>
 static void py_assign(psim::StateFieldWritableBase &field, T const &value) {
-  auto *ptr = dynamic_cast<psim::StateFieldWritable<T> *>(&field);
-  if (!ptr)
-    std::runtime_error("Attempted to write to '" + field.name() + "' but the underlying type was incorrect.");
-  ptr->get() = value;
+  if (field.tag() != psim::type_tag<T>())
+    throw std::runtime_error("Attempted to write to '" + field.name() + "' but the underlying type was incorrect.");
+  field.get<T>() = value;
 }
 
+static PyVariant py_get(psim::StateFieldBase const &field) {
+  switch (field.tag()) {
+    case psim::TypeTag::Boolean: return field.get<psim::Boolean>();
+    case psim::TypeTag::Integer: return field.get<psim::Integer>();
+    case psim::TypeTag::Real:    return field.get<psim::Real>();
+    case psim::TypeTag::Vector2: return field.get<psim::Vector2>();
+    case psim::TypeTag::Vector3: return field.get<psim::Vector3>();
+    case psim::TypeTag::Vector4: return field.get<psim::Vector4>();
+    default:                     break;
+  }
+  throw std::runtime_error("State field '" + field.name() + "' holds an unsupported type.");
+}
+
+static void py_set(psim::StateFieldWritableBase &field, PyVariant const &value) {
+  value.match(
+    [&](psim::Real    const &v) { py_assign(field, v); },
+    [&](psim::Boolean const &v) { py_assign(field, v); },
+    [&](psim::Integer const &v) { py_assign(field, v); },
+    [&](psim::Vector2 const &v) { py_assign(field, v); },
+    [&](psim::Vector3 const &v) { py_assign(field, v); },
+    [&](psim::Vector4 const &v) { py_assign(field, v); }
+  );
+}
+
+/* Maps the name of every memoized lazy field to its (hits, misses) counts. */
+static py::dict py_lazy_statistics(psim::State const &state) {
+  py::dict statistics;
+  for (std::size_t i = 0; i < state.size(); i++) {
+    auto const *lazy = dynamic_cast<psim::StateFieldLazyBase const *>(&state.at(i));
+    if (lazy && lazy->memoized())
+      statistics[py::str(lazy->name())] = py::make_tuple(lazy->hits(), lazy->misses());
+  }
+  return statistics;
+}
+
+/* Fields may be accessed by name or by the index returned from 'index'. Index
+ * based access skips hashing the field name and should be preferred for fields
+ * read repeatedly over the course of a simulation. Many fields can be read or
+ * written at once through a field set returned from 'field_set'.
+ */
 #define PY_SIMULATION(model) \
     py::class_<psim::Simulation<psim::model>>(m, #model) \
       .def(py::init([](PyConfiguration const &config) { \
         return new psim::Simulation<psim::model>(config); \
       })) \
+      .def(py::init([](PyConfiguration const &config, std::vector<std::string> const &fields) { \
+        return new psim::Simulation<psim::model>(config, fields); \
+      })) \
       .def("__getitem__", [](psim::Simulation<psim::model> const &self, std::string const &name) -> PyVariant { \
         auto const *field = self.get(name); \
         if (!field) \
           throw std::runtime_error("State field '" + name + "' does not exist."); \
-        { \
-            auto const *ptr = dynamic_cast<psim::StateField<psim::Vector3> const *>(field); \
-            if (ptr) return ptr->get(); \
-        } \
-        { \
-            auto const *ptr = dynamic_cast<psim::StateField<psim::Vector4> const *>(field); \
-            if (ptr) return ptr->get(); \
-        } \
-        { \
-            auto const *ptr = dynamic_cast<psim::StateField<psim::Real> const *>(field); \
-            if (ptr) return ptr->get(); \
-        } \
-        { \
-            auto const *ptr = dynamic_cast<psim::StateField<psim::Boolean> const *>(field); \
-            if (ptr) return ptr->get(); \
-        } \
-        { \
-            auto const *ptr = dynamic_cast<psim::StateField<psim::Integer> const *>(field); \
-            if (ptr) return ptr->get(); \
-        } \
-        { \
-            auto const *ptr = dynamic_cast<psim::StateField<psim::Vector2> const *>(field); \
-            if (ptr) return ptr->get(); \
-        } \
-        throw std::runtime_error("State field '" + name + "' holds an unsupported type."); \
+        return py_get(*field); \
+      }) \
+      .def("__getitem__", [](psim::Simulation<psim::model> const &self, std::size_t i) -> PyVariant { \
+        return py_get(self.at(i)); \
       }) \
       .def("__setitem__", [](psim::Simulation<psim::model> &self, std::string const &name, PyVariant const &value) { \
         auto *ptr = self.get_writable(name); \
         if (!ptr) \
           throw std::runtime_error("Writable state field '" + name + "' does not exist."); \
-        value.match( \
-          [&](psim::Real    const &v) { py_assign(*ptr, v); }, \
-          [&](psim::Boolean const &v) { py_assign(*ptr, v); }, \
-          [&](psim::Integer const &v) { py_assign(*ptr, v); }, \
-          [&](psim::Vector2 const &v) { py_assign(*ptr, v); }, \
-          [&](psim::Vector3 const &v) { py_assign(*ptr, v); }, \
-          [&](psim::Vector4 const &v) { py_assign(*ptr, v); }  \
-        ); \
+        py_set(*ptr, value); \
+      }) \
+      .def("__setitem__", [](psim::Simulation<psim::model> &self, std::size_t i, PyVariant const &value) { \
+        auto *ptr = self.at_writable(i); \
+        if (!ptr) \
+          throw std::runtime_error("State field '" + self.at(i).name() + "' is not writable."); \
+        py_set(*ptr, value); \
+      }) \
+      .def("index", [](psim::Simulation<psim::model> const &self, std::string const &name) { \
+        return self.index(name); \
+      }) \
+      .def("field_set", [](psim::Simulation<psim::model> &self, std::vector<std::string> const &fields) { \
+        return new PyFieldSet(self, fields); \
+      }, py::keep_alive<0, 1>()) \
+      .def("get_many", [](psim::Simulation<psim::model> &self, PyFieldSet &fields, bool as_dict) -> py::object { \
+        fields.check(self); \
+        return as_dict ? py::object(fields.get_dict()) : py::object(fields.get()); \
+      }, py::arg("fields"), py::arg("as_dict") = false) \
+      .def("get_many", [](psim::Simulation<psim::model> &self, std::vector<std::string> const &names, bool as_dict) -> py::object { \
+        PyFieldSet fields(self, names); \
+        return as_dict ? py::object(fields.get_dict()) : py::object(fields.get()); \
+      }, py::arg("fields"), py::arg("as_dict") = false) \
+      .def("set_many", [](psim::Simulation<psim::model> &self, PyFieldSet &fields, py::array_t<psim::Real, py::array::c_style | py::array::forcecast> const &values) { \
+        fields.check(self); \
+        fields.set(values); \
+      }) \
+      .def("set_many", [](psim::Simulation<psim::model> &self, std::map<std::string, PyVariant> const &values) { \
+        for (auto const &pair : values) { \
+          auto *ptr = self.get_writable(pair.first); \
+          if (!ptr) \
+            throw std::runtime_error("Writable state field '" + pair.first + "' does not exist."); \
+          py_set(*ptr, pair.second); \
+        } \
       }) \
       .def("step", [](psim::Simulation<psim::model> &self) { \
         self.step(); \
+      }) \
+      .def("step", [](psim::Simulation<psim::model> &self, std::size_t n) { \
+        self.step(n); \
+      }, py::call_guard<py::gil_scoped_release>()) \
+      .def("step_until", [](psim::Simulation<psim::model> &self, std::vector<std::string> const &conditions) { \
+        return self.step_until(conditions); \
+      }, py::call_guard<py::gil_scoped_release>()) \
+      .def("record", [](psim::Simulation<psim::model> &self, std::vector<std::string> const &fields, std::size_t decimation, std::size_t capacity) { \
+        return self.record(fields, decimation, capacity); \
+      }, py::arg("fields"), py::arg("decimation") = 1, py::arg("capacity") = 0) \
+      .def("detach", [](psim::Simulation<psim::model> &self, std::shared_ptr<psim::Recorder> const &recorder) { \
+        self.detach(recorder); \
+      }) \
+      .def("log", [](psim::Simulation<psim::model> &self, std::string const &file, std::vector<std::string> const &fields, std::size_t decimation, std::size_t chunk) { \
+        return self.log(file, fields, decimation, chunk); \
+      }, py::arg("file"), py::arg("fields"), py::arg("decimation") = 1, py::arg("chunk") = 4096) \
+      .def("log_async", [](psim::Simulation<psim::model> &self, std::string const &file, std::vector<std::string> const &fields, std::size_t decimation, std::size_t chunk, std::size_t capacity, std::string const &policy) { \
+        return self.log_async(file, fields, decimation, chunk, capacity, psim::AsyncTelemetryWriter::policy(policy)); \
+      }, py::arg("file"), py::arg("fields"), py::arg("decimation") = 1, py::arg("chunk") = 4096, py::arg("capacity") = 1024, py::arg("policy") = "block") \
+      .def("pyramid", [](psim::Simulation<psim::model> &self, std::vector<std::string> const &fields, std::size_t bucket, std::size_t factor, std::size_t levels, std::size_t decimation) { \
+        return self.pyramid(fields, bucket, factor, levels, decimation); \
+      }, py::arg("fields"), py::arg("bucket") = 16, py::arg("factor") = 4, py::arg("levels") = 6, py::arg("decimation") = 1) \
+      .def("detach", [](psim::Simulation<psim::model> &self, std::shared_ptr<psim::TelemetrySink> const &log) { \
+        self.detach(log); \
+      }) \
+      .def("lazy_statistics", [](psim::Simulation<psim::model> const &self) { \
+        return py_lazy_statistics(self); \
+      }) \
+      .def("checkpoint", [](psim::Simulation<psim::model> const &self) { \
+        return self.checkpoint(); \
+      }) \
+      .def("restore", [](psim::Simulation<psim::model> &self, psim::Checkpoint const &checkpoint) { \
+        self.restore(checkpoint); \
+      }) \
+      .def("fork", [](psim::Simulation<psim::model> const &self, PyConfiguration const &config) { \
+        return self.fork(config); \
+      }) \
+      .def("fork", [](psim::Simulation<psim::model> const &self, psim::Simulation<psim::model> &twin) { \
+        self.fork(twin); \
+      }) \
+      .def("reset", [](psim::Simulation<psim::model> &self, PyConfiguration const &overrides) { \
+        self.reset(overrides); \
+      }) \
+      .def("reset", [](psim::Simulation<psim::model> &self, std::map<std::string, PyVariant> const &overrides) { \
+        PyConfiguration config; \
+        for (auto const &pair : overrides) \
+          py_configure(config, pair.first, pair.second); \
+        self.reset(config); \
       })
 
+using PyOverrides = std::vector<std::map<std::string, PyVariant>>;
+
+/* Every ensemble member is configured as an overlay of the shared base
+ * configuration with one dictionary of overrides per member. Member simulations
+ * are returned by reference and kept alive by the ensemble.
+ */
+#define PY_ENSEMBLE(model) \
+    py::class_<psim::Ensemble<psim::model>>(m, #model "Ensemble") \
+      .def(py::init([](PyConfiguration const &config, PyOverrides const &overrides, std::size_t threads, py::object const &fields) { \
+        auto const prune = !fields.is_none(); \
+        auto const names = prune ? fields.cast<std::vector<std::string>>() : std::vector<std::string>(); \
+        py::gil_scoped_release release; \
+        std::vector<psim::Configuration> configs; \
+        configs.reserve(overrides.size()); \
+        for (auto const &override : overrides) { \
+          configs.push_back(psim::Configuration::overlay(config)); \
+          for (auto const &pair : override) \
+            py_configure(configs.back(), pair.first, pair.second); \
+        } \
+        if (prune) \
+          return new psim::Ensemble<psim::model>(configs, names, threads); \
+        return new psim::Ensemble<psim::model>(configs, threads); \
+      }), py::arg("config"), py::arg("overrides"), py::arg("threads") = 1, py::arg("fields") = py::none()) \
+      .def("__len__", [](psim::Ensemble<psim::model> const &self) { \
+        return self.size(); \
+      }) \
+      .def("__getitem__", [](psim::Ensemble<psim::model> &self, std::size_t i) -> psim::Simulation<psim::model> & { \
+        return self.at(i); \
+      }, py::return_value_policy::reference_internal) \
+      .def("step", [](psim::Ensemble<psim::model> &self, std::size_t n) { \
+        self.step(n); \
+      }, py::arg("n") = 1, py::call_guard<py::gil_scoped_release>()) \
+      .def("step_until", [](psim::Ensemble<psim::model> &self, std::vector<std::string> const &conditions) { \
+        return self.step_until(conditions); \
+      }, py::call_guard<py::gil_scoped_release>()) \
+      .def("record", [](psim::Ensemble<psim::model> &self, std::vector<std::string> const &fields, std::size_t decimation, std::size_t capacity) { \
+        return self.record(fields, decimation, capacity); \
+      }, py::arg("fields"), py::arg("decimation") = 1, py::arg("capacity") = 0) \
+      .def("gather", [](psim::Ensemble<psim::model> const &self, std::vector<std::string> const &fields) { \
+        return self.gather(fields); \
+      })
+
+void py_ensemble(py::module &m) {
+  PY_ENSEMBLE(AttitudeEstimatorTestGnc);
+  PY_ENSEMBLE(DetumblerTest);
+  PY_ENSEMBLE(SingleAttitudeOrbitGnc);
+  PY_ENSEMBLE(SingleOrbitGnc);
+  PY_ENSEMBLE(OrbOrbitEstimatorTest);
+  PY_ENSEMBLE(RelativeOrbitEstimatorTest);
+  PY_ENSEMBLE(OrbitControllerTest);
+  PY_ENSEMBLE(DualAttitudeOrbitGnc);
+  PY_ENSEMBLE(DualOrbitGnc);
+}
+
 void py_simulation(py::module &m) {
   PY_SIMULATION(AttitudeEstimatorTestGnc);
   PY_SIMULATION(DetumblerTest);
@@ -213,5 +581,12 @@ void py_simulation(py::module &m) {
 
 PYBIND11_MODULE(_psim, m) {
   py_configuration(m);
+  py_checkpoint(m);
+  py_profiler(m);
+  py_recorder(m);
+  py_telemetry(m);
+  py_pyramid(m);
+  py_field_set(m);
   py_simulation(m);
+  py_ensemble(m);
 }
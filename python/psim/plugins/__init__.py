@@ -9,6 +9,10 @@ from .plot import (
     Plotter,
 )
 
+from .profile import (
+    Profile,
+)
+
 from .snapshot import (
     Snapshot,
 )
@@ -5,6 +5,7 @@ classes.
 from psim.plugins import Plugin
 from psim.utilities import get_plotting_files
 
+from _psim import TelemetryReader
 from matplotlib import pyplot as plt
 
 import logging
@@ -39,8 +40,9 @@ class Plot(object):
         """
         return self._arrays
     
-    def plot(self, arrays):
-        """Displays the plot.
+    def plot(self, arrays, bounds=None):
+        """Displays the plot. If given, bounds maps array names to a pair of
+        minimum and maximum arrays drawn as an envelope around the array.
         """
         pass
 
@@ -58,13 +60,21 @@ class Plot2D(Plot):
 
         self._arrays = set(self._y).union({self._x})
     
-    def plot(self, arrays):
-        super(Plot2D, self).plot(arrays)
+    def _plot(self, ax, arrays, bounds):
+        """Draws each y array against x with its envelope if bounds are given.
+        """
+        for _y in self._y:
+            line, = ax.plot(arrays[self._x], arrays[_y], label=_y)
+            if bounds and _y in bounds:
+                ax.fill_between(arrays[self._x], bounds[_y][0], bounds[_y][1],
+                                color=line.get_color(), alpha=0.25, linewidth=0)
+
+    def plot(self, arrays, bounds=None):
+        super(Plot2D, self).plot(arrays, bounds)
 
         fg = plt.figure()
         ax = fg.add_subplot(111)
-        for _y in self._y:
-            ax.plot(arrays[self._x], arrays[_y], label=_y)
+        self._plot(ax, arrays, bounds)
         ax.legend()
         ax.set_xlabel(self._x)
         fg.show()
@@ -75,14 +85,13 @@ class Plot2DLog(Plot2D):
     def __init__(self, **kwargs):
         super(Plot2DLog, self).__init__(**kwargs)
     
-    def plot(self, arrays):
-        super(Plot2D, self).plot(arrays)
+    def plot(self, arrays, bounds=None):
+        super(Plot2D, self).plot(arrays, bounds)
 
         fg = plt.figure()
         ax = fg.add_subplot(111)
         ax.set(yscale='log')
-        for _y in self._y:
-            ax.plot(arrays[self._x], arrays[_y], label=_y)
+        self._plot(ax, arrays, bounds)
         ax.legend()
         ax.set_xlabel(self._x)
         fg.show()
@@ -102,8 +111,8 @@ class Plot3D(Plot):
 
         self._arrays = set(self._z).union({self._x, self._y})
 
-    def plot(self, arrays):
-        super(Plot3D, self).plot(arrays)
+    def plot(self, arrays, bounds=None):
+        super(Plot3D, self).plot(arrays, bounds)
 
         fg = plt.figure()
         ax = fg.add_subplot(111, projection='3d')
@@ -138,8 +147,8 @@ class PlotEstimate(Plot):
         self._arrays.add(self._e)
         self._arrays.add(self._s)
 
-    def plot(self, arrays):
-        super(PlotEstimate, self).plot(arrays)
+    def plot(self, arrays, bounds=None):
+        super(PlotEstimate, self).plot(arrays, bounds)
 
         fg = plt.figure()
         ax = fg.add_subplot(111)
@@ -153,13 +162,23 @@ class PlotEstimate(Plot):
 
 class Plotter(Plugin):
     """Logs telemetry to display in a set of plots upon simulation termination.
+
+    Telemetry is kept in memory unless a log file is given in which case it's
+    streamed to disk over the course of the simulation and memory mapped when
+    plotting. The latter is recommended for long duration simulations.
+
+    Alternatively, a maximum number of points per plot can be given in which
+    case telemetry is kept in a level of detail pyramid. Plots are then drawn
+    from bucket means with the minimum and maximum of each bucket shown as an
+    envelope so transients aren't lost to decimation.
     """
-    def __init__(self, plots=list(), step=1):
+    def __init__(self, plots=list(), step=1, file=None, points=None):
         super(Plotter, self).__init__()
 
         self._plots = plots if not plots or type(plots) == list else [plots]
         self._step = step
-        self._n = 0
+        self._file = file
+        self._points = points
 
     def arguments(self, parser):
         super(Plotter, self).arguments(parser)
@@ -174,6 +193,16 @@ class Plotter(Plugin):
             '-ps', '--plots-step', type = int, default = self._step,
             help = 'step interval at which data is recorded for plotting'
         )
+        parser.add_argument(
+            '-pl', '--plots-log', type = str, default = self._file,
+            help = 'telemetry file data is streamed to for plotting instead ' +
+            'of being kept in memory'
+        )
+        parser.add_argument(
+            '-pp', '--plots-points', type = int, default = self._points,
+            help = 'maximum number of points per plot; telemetry is reduced ' +
+            'to per bucket minimums, maximums, and means as it\'s recorded'
+        )
 
     def initialize(self, sim, args):
         """Parses the plotting configuration files and determines what state
@@ -218,27 +247,24 @@ class Plotter(Plugin):
         log.debug('Loading plots from the following configuration files: %s', _plots_files)
         self._plots = [plot for plot in _stream_plots(_plots_files)]
 
-        self._fields = dict()
+        fields = set()
         for _plot in self._plots:
             for _array in _plot.arrays:
-                _field = Plot._mangle_array(_array)
-                if not self._fields.get(_field, None):
-                    self._fields[_field] = list()
-
-    def poststep(self, sim):
-        """Periodically logs the necessary fields for plotting upon termination
-        of the simulation.
-        """
-        super(Plotter, self).poststep(sim)
-
-        if not self._plots:
-            return
-
-        self._n = self._n + 1
-        if self._step > 0 and self._n % self._step == 0:
-            self._n = 0
-            for k, v in self._fields.items():
-                v.append(sim[k])
+                fields.add(Plot._mangle_array(_array))
+
+        # Telemetry is logged by a recorder, telemetry log, or pyramid within
+        # the simulation itself
+        self._file = args.plots_log
+        self._points = args.plots_points
+        if self._points and self._points > 0:
+            log.info('Limiting plots to %d points', self._points)
+            self._file = None
+            self._telemetry = sim.pyramid(sorted(fields), decimation=self._step)
+        elif self._file:
+            log.info('Streaming plotting telemetry to %s', self._file)
+            self._telemetry = sim.log(self._file, sorted(fields), self._step)
+        else:
+            self._telemetry = sim.record(sorted(fields), self._step)
 
     def cleanup(self, sim):
         super(Plotter, self).cleanup(sim)
@@ -253,28 +279,34 @@ class Plotter(Plugin):
 
         log.info('Generating plots...')
 
+        # Telemetry logs are read back from the file without parsing
+        source = self._telemetry
+        if self._file:
+            self._telemetry.close()
+            source = TelemetryReader(self._file)
+
+        # Pyramids are drawn from the finest level with few enough buckets
+        bounds = None
+        if self._points and self._points > 0:
+            source.close()
+            level = source.select(len(source), self._points)
+            bounds = dict()
+
         # Generate direct data arrays for plotting
         arrays = dict()
         for _arrays in [plot.arrays for plot in self._plots]:
             for _array in _arrays:
-                if not arrays.get(_array, None):
-                    if _array.endswith('.x'):
-                        arrays[_array] = [x[0] for x in self._fields[Plot._mangle_array(_array)]]
-                    elif _array.endswith('.y'):
-                        arrays[_array] = [y[1] for y in self._fields[Plot._mangle_array(_array)]]
-                    elif _array.endswith('.z'):
-                        arrays[_array] = [z[2] for z in self._fields[Plot._mangle_array(_array)]]
-                    elif _array.endswith('.w'):
-                        arrays[_array] = [w[3] for w in self._fields[Plot._mangle_array(_array)]]
-                    else:
-                        arrays[_array] = [u for u in self._fields[Plot._mangle_array(_array)]]
-
-        # Dump the logged fields
-        del self._fields
+                if _array in arrays:
+                    continue
+                if bounds is None:
+                    arrays[_array] = source[_array]
+                else:
+                    arrays[_array] = source.mean(_array, level)
+                    bounds[_array] = (source.min(_array, level), source.max(_array, level))
 
         # Loop through plots
         for plot in self._plots:
-            plot.plot(arrays)
+            plot.plot(arrays, bounds)
 
         # Block on user input
         log.info('Plotting complete! Press [ENTER] to continue.')
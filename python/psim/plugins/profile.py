@@ -0,0 +1,52 @@
+"""Set of plugins used to profile where a simulation spends its time.
+"""
+
+from psim.plugins import Plugin
+
+from _psim import Profiler
+
+import logging
+
+log = logging.getLogger(__name__)
+
+
+class Profile(Plugin):
+    """Profiles every model step and lazy field evaluation while the simulation
+    runs. Upon termination, a summary is logged and the events are saved as a
+    Chrome trace which can be opened in Perfetto.
+    """
+    def __init__(self, trace=None):
+        super(Profile, self).__init__()
+
+        self._trace = trace
+
+    def arguments(self, parser):
+        super(Profile, self).arguments(parser)
+
+        parser.add_argument(
+            '--profile', type=str, help='enables the profiler and specifies ' +
+            'the output file for the Chrome trace upon simulation termination.'
+        )
+
+    def initialize(self, sim, args):
+        super(Profile, self).initialize(sim, args)
+
+        if args.profile:
+            self._trace = args.profile
+        if not self._trace:
+            return
+
+        log.info('Profiling the simulation; saving the trace to "%s" upon simulation termination.', self._trace)
+        Profiler.clear()
+        Profiler.enable()
+
+    def cleanup(self, sim):
+        super(Profile, self).cleanup(sim)
+
+        if not self._trace:
+            return
+
+        Profiler.disable()
+        log.info('Profile summary:\n%s', Profiler.report())
+        log.info('Saving profiler trace to "%s"', self._trace)
+        Profiler.save(self._trace)
@@ -3,7 +3,10 @@
 
 from . import utilities
 
-from _psim import Configuration
+from _psim import Checkpoint, Configuration, FieldSet, Profiler, \
+    TelemetryReader
+
+import _psim
 
 import argparse
 import logging
@@ -37,19 +40,26 @@ class Simulation(object):
 
     This is the recommended entrypoint if you're not interested in using the
     plugin system and don't want to use the simulation runner.
+
+    If 'fields' is given, models that don't contribute to those fields are
+    removed when the simulation is constructed. Only the listed fields, and
+    the fields they depend on, can be read afterwards which includes fields
+    recorded and used in stop conditions.
     """
-    def __init__(self, sim, config):
+    def __init__(self, sim, config, fields=None):
         super(Simulation, self).__init__()
 
-        self._sim = sim(config)
+        self._sim = sim(config) if fields is None else sim(config, fields)
 
     def __getitem__(self, name):
-        """Retrieves a state field from the underlying simulation.
+        """Retrieves a state field from the underlying simulation. The field
+        can be specified by either its name or index.
         """
         return self._sim[name]
 
     def __setitem__(self, name, value):
-        """Sets a state field in the underlying simulation.
+        """Sets a state field in the underlying simulation. The field can be
+        specified by either its name or index.
         """
         self._sim[name] = value
 
@@ -62,10 +72,207 @@ class Simulation(object):
         except RuntimeError:
             return None
 
-    def step(self):
-        """Steps the underlying simulation forward in time.
+    def index(self, name):
+        """Retrieves the index of a state field in the underlying simulation.
+        Indexing the simulation with the returned value avoids looking up the
+        field by name on each access.
+        """
+        return self._sim.index(name)
+
+    def field_set(self, fields):
+        """Resolves the given field names once into a field set that can be
+        passed to 'get_many' and 'set_many' repeatedly without looking the
+        fields up by name again.
+        """
+        return self._sim.field_set(list(fields))
+
+    def get_many(self, fields, as_dict=False):
+        """Reads many state fields at once into a single float64 numpy array
+        with vector fields flattened in place. If 'as_dict' is set, a
+        dictionary of numpy views into that array keyed by field name is
+        returned instead. The fields may be a list of names or a field set
+        from 'field_set'. A field set reuses its array on every call so copy
+        values that need to outlive the next read.
+        """
+        if not isinstance(fields, FieldSet):
+            fields = list(fields)
+        return self._sim.get_many(fields, as_dict)
+
+    def set_many(self, fields, values=None):
+        """Writes many state fields at once. Either a dictionary mapping field
+        names to values or a field set and a flat array of values laid out as
+        returned by 'get_many' can be given.
+        """
+        if values is None:
+            self._sim.set_many(dict(fields))
+        else:
+            self._sim.set_many(fields, values)
+
+    def record(self, fields, decimation=1, capacity=0):
+        """Attaches a recorder to the underlying simulation which logs the
+        given fields every 'decimation' steps. Recorded columns are accessible
+        as read only numpy arrays by indexing the returned recorder. The arrays
+        view the recorder's buffers without copying and remain valid as more
+        samples are recorded or the recorder is cleared.
+        """
+        return self._sim.record(fields, decimation, capacity)
+
+    def detach(self, recorder):
+        """Detaches a recorder or telemetry log from the underlying
+        simulation.
+        """
+        self._sim.detach(recorder)
+
+    def log(self, file, fields, decimation=1, chunk=4096):
+        """Attaches a telemetry log to the underlying simulation which streams
+        the given fields to 'file' every 'decimation' steps in chunks of
+        'chunk' samples. Memory use doesn't grow with the length of the run.
+        Once the returned log is closed, the file can be read back with a
+        'TelemetryReader'.
         """
-        self._sim.step()
+        return self._sim.log(file, fields, decimation, chunk)
+
+    def log_async(self, file, fields, decimation=1, chunk=4096, capacity=1024,
+                  policy='block'):
+        """Attaches a telemetry log to the underlying simulation which is
+        written by a background thread. Samples are queued in a ring buffer
+        holding 'capacity' samples and 'policy' decides what happens when it's
+        full: 'block' waits for the writer, 'drop_oldest' overwrites the oldest
+        queued sample, and 'decimate' drops samples at an increasing rate until
+        the writer catches up. The returned log's 'stats' reports queue depth,
+        drops, and stalls.
+        """
+        return self._sim.log_async(file, fields, decimation, chunk, capacity,
+                                   policy)
+
+    def pyramid(self, fields, bucket=16, factor=4, levels=6, decimation=1):
+        """Attaches a level of detail pyramid to the underlying simulation.
+        The minimum, maximum, and mean of each column are kept per bucket of
+        'bucket' samples on the finest level and each of the 'levels' levels
+        combines 'factor' buckets of the level below it. Use the pyramid's
+        'select' to pick the level for a window of samples and 'min', 'max',
+        and 'mean' to retrieve numpy arrays for a column and level. Closing the
+        pyramid flushes trailing samples that don't fill a complete bucket.
+        """
+        return self._sim.pyramid(fields, bucket, factor, levels, decimation)
+
+    def lazy_statistics(self):
+        """Returns a dictionary mapping the name of each memoized lazy field to
+        a tuple of its cache hit and miss counts.
+        """
+        return self._sim.lazy_statistics()
+
+    def checkpoint(self):
+        """Returns a binary checkpoint of the underlying simulation's state
+        and random number generators. Checkpoints can be saved to a file with
+        'save' and loaded again by constructing a 'Checkpoint' from the file.
+        """
+        return self._sim.checkpoint()
+
+    def restore(self, checkpoint):
+        """Restores the underlying simulation's state from a checkpoint taken
+        from a simulation of the same type. Parameters are not part of the
+        checkpoint and keep their current values.
+        """
+        self._sim.restore(checkpoint)
+
+    def fork(self, config):
+        """Returns a new simulation with a copy of the underlying simulation's
+        state. Parameters and random seeds are taken from the given
+        configuration which allows many variants to branch off a shared
+        history.
+        """
+        fork = Simulation.__new__(Simulation)
+        fork._sim = self._sim.fork(config)
+        return fork
+
+    def fork_into(self, twin):
+        """Copies the underlying simulation's state into an existing simulation
+        of the same type without constructing any models. The twin keeps its
+        own parameters so variants can be branched by resetting the twin with
+        each variant's overrides and then forking into it.
+
+        The state is copied by checkpointing and restoring every model, so the
+        cost grows with the number of models rather than being a single copy.
+        """
+        self._sim.fork(twin._sim)
+
+    def reset(self, overrides):
+        """Reinitializes the underlying simulation in place without
+        reallocating its models. The overrides, either a configuration or a
+        dictionary, are applied on top of the configuration the simulation was
+        constructed with. Attached recorders and resolved fields remain valid.
+        """
+        self._sim.reset(overrides)
+
+    def step(self, n=1):
+        """Steps the underlying simulation forward in time 'n' times. The
+        Python GIL is released while stepping more than once.
+        """
+        if n == 1:
+            self._sim.step()
+        else:
+            self._sim.step(n)
+
+    def step_until(self, *conditions):
+        """Steps the underlying simulation until any of the given conditions
+        is satisfied and returns the index of the first satisfied condition.
+        Each condition is a string of the form '<field> <op> <value>' (e.g.
+        'truth.t.ns >= 1000') and is evaluated in C++ after every step. The
+        Python GIL is released while stepping.
+        """
+        return self._sim.step_until(list(conditions))
+
+
+class Ensemble(object):
+    """Small wrapper around PSim ensembles used for Monte Carlo analysis.
+
+    Every member simulation is initialized from the shared configuration
+    overlaid with its own dictionary of overrides (e.g. a seed and perturbed
+    initial conditions). Members are stepped concurrently on 'threads' threads
+    with the Python GIL released and the results don't depend on the number of
+    threads used. Members can be pruned for the 'fields' that will be read as
+    with 'Simulation'.
+    """
+    def __init__(self, sim, config, overrides, threads=1, fields=None):
+        super(Ensemble, self).__init__()
+
+        self._ensemble = getattr(_psim, sim.__name__ + 'Ensemble')(
+            config, overrides, threads, fields)
+
+    def __len__(self):
+        """Returns the number of member simulations.
+        """
+        return len(self._ensemble)
+
+    def __getitem__(self, i):
+        """Retrieves a member simulation by index.
+        """
+        return self._ensemble[i]
+
+    def record(self, fields, decimation=1, capacity=0):
+        """Attaches a recorder to every member simulation and returns the list
+        of recorders in member order.
+        """
+        return self._ensemble.record(fields, decimation, capacity)
+
+    def gather(self, *fields):
+        """Gathers the current value of the given fields across all members
+        into a recorder holding one sample per member.
+        """
+        return self._ensemble.gather(list(fields))
+
+    def step(self, n=1):
+        """Steps every member simulation forward in time 'n' times.
+        """
+        self._ensemble.step(n)
+
+    def step_until(self, *conditions):
+        """Steps every member simulation until any of the given conditions is
+        satisfied and returns the index of the first satisfied condition for
+        each member. See 'Simulation.step_until' for more information.
+        """
+        return self._ensemble.step_until(list(conditions))
 
 
 class SimulationRunner(object):
@@ -144,6 +351,26 @@ class SimulationRunner(object):
         """
         return self._sim.get(name)
 
+    def index(self, name):
+        """Retrieves the index of a state field in the underlying simulation.
+        """
+        return self._sim.index(name)
+
+    def record(self, fields, decimation=1, capacity=0):
+        """Attaches a recorder to the underlying simulation.
+        """
+        return self._sim.record(fields, decimation, capacity)
+
+    def log(self, file, fields, decimation=1, chunk=4096):
+        """Attaches a telemetry log to the underlying simulation.
+        """
+        return self._sim.log(file, fields, decimation, chunk)
+
+    def pyramid(self, fields, bucket=16, factor=4, levels=6, decimation=1):
+        """Attaches a level of detail pyramid to the underlying simulation.
+        """
+        return self._sim.pyramid(fields, bucket, factor, levels, decimation)
+
     def should_stop(self):
         """Function available to plugins to allow them to signal the simulation
         should halt.
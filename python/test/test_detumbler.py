@@ -29,7 +29,8 @@ def test_detumbler():
     #  - https://github.com/pathfinder-for-autonomous-navigation/FlightSoftware/blob/2e3e133c49c44e8c792f3c7bef1b6e43ad2f3141/src/fsw/FCCode/MissionManager.cpp#L201-L215
     threshold = 1047 * 1.35e-5 * 0.33
 
-    sim.step()
-    while sim['truth.leader.attitude.L.norm'] > threshold:
-        assert sim['truth.t.ns'] < timeout, 'Spacecraft failed to detumble in alloted time'
-        sim.step()
+    i = sim.step_until(
+        'truth.leader.attitude.L.norm <= {}'.format(threshold),
+        'truth.t.ns >= {}'.format(timeout),
+    )
+    assert i == 0, 'Spacecraft failed to detumble in alloted time'
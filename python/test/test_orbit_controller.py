@@ -17,8 +17,8 @@ def test_orbit_controller():
     #The spacecrafts are given 30 days to rendezvous
     timeout = 30 * 24 * 3600 * 1000000000
     threshold = 0.5
-    sim.step()
-
-    while sim['truth.leader.hill.dr.norm'] > threshold:
-        assert sim['truth.t.ns'] < timeout , 'Spacecrafts failed to rendezvous in alloted time'
-        sim.step()
\ No newline at end of file
+    i = sim.step_until(
+        'truth.leader.hill.dr.norm <= {}'.format(threshold),
+        'truth.t.ns >= {}'.format(timeout),
+    )
+    assert i == 0, 'Spacecrafts failed to rendezvous in alloted time'
@@ -0,0 +1,33 @@
+from psim import Configuration, sims, Simulation
+
+import numpy as np
+import pytest
+
+
+def test_recorder_views():
+    """Test recorder columns are viewed in place.
+
+    Reads of a column share the recorder's buffer and stay valid, and
+    unchanged, as more samples are recorded and the recorder is cleared.
+    """
+    configs = ['sensors/base', 'truth/base', 'fc/base']
+    configs = ['config/parameters/' + f + '.txt' for f in configs]
+
+    config = Configuration(configs)
+    sim = Simulation(sims.OrbitControllerTest, config)
+
+    recorder = sim.record(['truth.t.ns', 'truth.leader.orbit.r'], capacity=4)
+    sim.step(4)
+
+    t = recorder['truth.t.ns']
+    x = recorder['truth.leader.orbit.r.x']
+    assert np.shares_memory(t, recorder['truth.t.ns'])
+    assert np.shares_memory(x, recorder['truth.leader.orbit.r.x'])
+    assert not t.flags.writeable
+
+    expected = t.copy()
+    sim.step(4)
+    recorder.clear()
+    sim.step(2)
+    assert len(recorder['truth.t.ns']) == 2
+    assert np.array_equal(t, expected)
@@ -8,12 +8,33 @@
 #include <cmath>
 
 namespace gnc {
+namespace {
+
+/* Calls an update function without a data pointer. The data pointer points to
+ * the update function itself. */
+template <typename T>
+void call(T t, T const *y, T *dy, void *ptr) {
+  (*static_cast<void (**)(T, T const *, T *)>(ptr))(t, y, dy);
+}
+
+}  // namespace
+
+template <typename T>
+int ode23(T ti, T tf, T const *yi, T *yf, unsigned int ne, T *bf, T h_min,
+    T rel_tol, T abs_tol, unsigned int max_iter, void (*const f)(T, T const *, T *)) {
+  void (*g)(T, T const *, T *) = f;
+  return ode23<T>(ti, tf, yi, yf, ne, bf, h_min, rel_tol, abs_tol, max_iter,
+      call<T>, &g);
+}
 
 // Reference:
 //  https://en.wikipedia.org/wiki/Bogacki–Shampine_method
+//  https://en.wikipedia.org/wiki/Cubic_Hermite_spline
 template <typename T>
 int ode23(T ti, T tf, T const *yi, T *yf, unsigned int ne, T *bf, T h_min,
-    T rel_tol, T abs_tol, unsigned int max_iter, void (*const f)(T, T const *, T *)) {
+    T rel_tol, T abs_tol, unsigned int max_iter,
+    void (*const f)(T, T const *, T *, void *), void *ptr, T *h_io,
+    T const *to, T *yo, unsigned int no) {
   // Table of values
   constexpr static T a21 = 1.0L / 2.0L, a32 = 3.0L / 4.0L, a41 = 2.0L / 9.0L,
       a42 = 1.0L / 3.0L, a43 = 4.0L / 9.0L;
@@ -30,8 +51,9 @@ int ode23(T ti, T tf, T const *yi, T *yf, unsigned int ne, T *bf, T h_min,
 
   // Initialize local variables
   int err = ODE_ERR_OK;
-  unsigned int iter = 0;
-  T h_next = (tf - ti) / static_cast<T>(10);
+  unsigned int iter = 0, o = 0;
+  T h_next = (h_io && *h_io > static_cast<T>(0)) ? *h_io : (tf - ti) / static_cast<T>(10);
+  T h_free = h_next;
   T t = ti;
   T delta_max;
   T h;
@@ -40,13 +62,21 @@ int ode23(T ti, T tf, T const *yi, T *yf, unsigned int ne, T *bf, T h_min,
   for (unsigned int i = 0; i < ne; i++) yf[i] = yi[i];
   if (ti >= tf) return err | ODE_ERR_BAD_INTERVAL;
 
+  // Prevent too large of an initial step. The step size suggested for a
+  // following call ignores steps that were shortened to land on tf.
+  bool clamped = h_next > tf - ti;
+  if (clamped) h_next = tf - ti;
+
   // Calculate the initial k1
-  f(t, yf, k1);
+  f(t, yf, k1, ptr);
 
   for (;;) {
 
     // Check iteration bound
-    if (iter++ > max_iter) return err | ODE_ERR_MAX_ITER;
+    if (iter++ > max_iter) {
+      if (h_io) *h_io = h_next;
+      return err | ODE_ERR_MAX_ITER;
+    }
 
     for (;;) {  // Start error checking loop
     
@@ -56,13 +86,13 @@ int ode23(T ti, T tf, T const *yi, T *yf, unsigned int ne, T *bf, T h_min,
       // Step forward
       for (unsigned int i = 0; i < ne; i++)
         ks[i] = yf[i] + h * a21 * k1[i];
-      f(t + c2 * h, ks, k2);
+      f(t + c2 * h, ks, k2, ptr);
       for (unsigned int i = 0; i < ne; i++)
         ks[i] = yf[i] + h * a32 * k2[i];
-      f(t + c3 * h, ks, k3);
+      f(t + c3 * h, ks, k3, ptr);
       for (unsigned int i = 0; i < ne; i++)  // Third order solution
         ks[i] = yf[i] + h * (a41 * k1[i] + a42 * k2[i] + a43 * k3[i]);
-      f(t + h, ks, k4);
+      f(t + h, ks, k4, ptr);
       for (unsigned int i = 0; i < ne; i++)  // Second order solution
         kz[i] = yf[i] + h * (bs1 * k1[i] + bs2 * k2[i] + bs3 * k3[i] + bs4 * k4[i]);
 
@@ -88,6 +118,13 @@ int ode23(T ti, T tf, T const *yi, T *yf, unsigned int ne, T *bf, T h_min,
       }
       // Large error (shrink step size, ensure it large enough, and continue)
       else if (delta_max > one) {
+        // Accept the step if it can't be shrunk any further
+        if (h <= h_min) {
+          err |= ODE_ERR_MIN_STEP;
+          h_next = h_min;
+          break;
+        }
+        clamped = false;
         h_next = h * one_third;
         if (h_next < h_min) {
           h_next = h_min;
@@ -105,12 +142,27 @@ int ode23(T ti, T tf, T const *yi, T *yf, unsigned int ne, T *bf, T h_min,
 
     }  // End errror checking loop
 
+    // Interpolate any output states within the step
+    for (; o < no && (to[o] <= t + h || t + h >= tf); o++) {
+      T const s = (to[o] - t) / h, r = static_cast<T>(1) - s;
+      T const h00 = (static_cast<T>(1) + static_cast<T>(2) * s) * r * r,
+          h10 = s * r * r, h01 = s * s * (static_cast<T>(3) - static_cast<T>(2) * s),
+          h11 = -s * s * r;
+      for (unsigned int i = 0; i < ne; i++)
+        yo[o * ne + i] = h00 * yf[i] + h10 * h * k1[i] + h01 * ks[i] + h11 * h * k4[i];
+    }
+
     // Step forward time, see if we're done, and prevent to large of a step
     t += h;
     for (unsigned int i = 0; i < ne; i++) yf[i] = ks[i];
     for (unsigned int i = 0; i < ne; i++) k1[i] = k4[i];
-    if (t >= tf) return err;
-    if (t + h_next >= tf) h_next = tf - t;
+    if (t >= tf) {
+      if (h_io) *h_io = clamped ? std::max(h_free, h_next) : h_next;
+      return err;
+    }
+    h_free = h_next;
+    clamped = t + h_next >= tf;
+    if (clamped) h_next = tf - t;
     
   }
 }
@@ -118,13 +170,24 @@ int ode23(T ti, T tf, T const *yi, T *yf, unsigned int ne, T *bf, T h_min,
 GNC_ODEXX_TEMPLATE(ode23, float);
 GNC_ODEXX_TEMPLATE(ode23, double);
 
+template <typename T>
+int ode45(T ti, T tf, T const *yi, T *yf, unsigned int ne, T *bf, T h_min,
+    T rel_tol, T abs_tol, unsigned int max_iter, void (*const f)(T, T const *, T *)) {
+  void (*g)(T, T const *, T *) = f;
+  return ode45<T>(ti, tf, yi, yf, ne, bf, h_min, rel_tol, abs_tol, max_iter,
+      call<T>, &g);
+}
+
 // Reference:
 //  https://en.wikipedia.org/wiki/Dormand–Prince_method
 //  Earl Kirkland example code and notes from AEP 4380
 //  Numerical Recipes 3rd Edition: The Art of Scientific Computing
+//  Hairer, Norsett, and Wanner: Solving Ordinary Differential Equations I
 template <typename T>
 int ode45(T ti, T tf, T const *yi, T *yf, unsigned int ne, T *bf, T h_min,
-    T rel_tol, T abs_tol, unsigned int max_iter, void (*const f)(T, T const *, T *)) {
+    T rel_tol, T abs_tol, unsigned int max_iter,
+    void (*const f)(T, T const *, T *, void *), void *ptr, T *h_io,
+    T const *to, T *yo, unsigned int no) {
   // Table of values
   constexpr static T a21 = 1.0 / 5.0,
       a31 = 3.0 / 40.0, a32 = 9.0 / 40.0,
@@ -140,6 +203,10 @@ int ode45(T ti, T tf, T const *yi, T *yf, unsigned int ne, T *bf, T h_min,
       bs6 = 187.0 / 2100.0, bs7 = 1.0 / 40.0;
   constexpr static T c2 = 1.0 / 5.0, c3 = 3.0 / 10.0, c4 = 4.0 / 5.0,
       c5 = 8.0 / 9.0;
+  constexpr static T d1 = -12715105075.0 / 11282082432.0,
+      d3 = 87487479700.0 / 32700410799.0, d4 = -10690763975.0 / 1880347072.0,
+      d5 = 701980252875.0 / 199316789632.0, d6 = -1453857185.0 / 822651844.0,
+      d7 = 69997945.0 / 29380423.0;
 
   // Setup scratch buffers
   T *const k1 = bf;
@@ -154,8 +221,9 @@ int ode45(T ti, T tf, T const *yi, T *yf, unsigned int ne, T *bf, T h_min,
 
   // Initialize local variables
   int err = ODE_ERR_OK;
-  unsigned int iter = 0;
-  T h_next = (tf - ti) / static_cast<T>(100);
+  unsigned int iter = 0, o = 0;
+  T h_next = (h_io && *h_io > static_cast<T>(0)) ? *h_io : (tf - ti) / static_cast<T>(100);
+  T h_free = h_next;
   T t = ti;
   T delta_max;
   T h;
@@ -164,13 +232,21 @@ int ode45(T ti, T tf, T const *yi, T *yf, unsigned int ne, T *bf, T h_min,
   for (unsigned int i = 0; i < ne; i++) yf[i] = yi[i];
   if (ti >= tf) return err | ODE_ERR_BAD_INTERVAL;
 
+  // Prevent too large of an initial step. The step size suggested for a
+  // following call ignores steps that were shortened to land on tf.
+  bool clamped = h_next > tf - ti;
+  if (clamped) h_next = tf - ti;
+
   // Calculate the initial k1
-  f(t, yf, k1);
+  f(t, yf, k1, ptr);
 
   for (;;) {
 
     // Check iteration bound
-    if (iter++ > max_iter) return err | ODE_ERR_MAX_ITER;
+    if (iter++ > max_iter) {
+      if (h_io) *h_io = h_next;
+      return err | ODE_ERR_MAX_ITER;
+    }
 
     for (;;) {  // Start error checking loop
 
@@ -180,22 +256,22 @@ int ode45(T ti, T tf, T const *yi, T *yf, unsigned int ne, T *bf, T h_min,
       // Step forward
       for (unsigned int i = 0; i < ne; i++)
         ks[i] = yf[i] + h * a21 * k1[i];
-      f(t + c2 * h, ks, k2);
+      f(t + c2 * h, ks, k2, ptr);
       for (unsigned int i = 0; i < ne; i++)
         ks[i] = yf[i] + h * (a31 * k1[i] + a32 * k2[i]);
-      f(t + c3 * h, ks, k3);
+      f(t + c3 * h, ks, k3, ptr);
       for (unsigned int i = 0; i < ne; i++)
         ks[i] = yf[i] + h * (a41 * k1[i] + a42 * k2[i] + a43 * k3[i]);
-      f(t + c4 * h, ks, k4);
+      f(t + c4 * h, ks, k4, ptr);
       for (unsigned int i = 0; i < ne; i++)
         ks[i] = yf[i] + h * (a51 * k1[i] + a52 * k2[i] + a53 * k3[i] + a54 * k4[i]);
-      f(t + c5 * h, ks, k5);
+      f(t + c5 * h, ks, k5, ptr);
       for (unsigned int i = 0; i < ne; i++)
         ks[i] = yf[i] + h * (a61 * k1[i] + a62 * k2[i] + a63 * k3[i] + a64 * k4[i] + a65 * k5[i]);
-      f(t + h, ks, k6);
+      f(t + h, ks, k6, ptr);
       for (unsigned int i = 0; i < ne; i++)
         ks[i] = yf[i] + h * (a71 * k1[i] + a73 * k3[i] + a74 * k4[i] + a75 * k5[i] + a76 * k6[i]);
-      f(t + h, ks, k7);
+      f(t + h, ks, k7, ptr);
       for (unsigned int i = 0; i < ne; i++)
         kz[i] = yf[i] +
             h * (bs1 * k1[i] + bs3 * k3[i] + bs4 * k4[i] + bs5 * k5[i] + bs6 * k6[i] + bs7 * k7[i]);
@@ -221,6 +297,13 @@ int ode45(T ti, T tf, T const *yi, T *yf, unsigned int ne, T *bf, T h_min,
       }
       // Large error (shrink step size, ensure it large enough, and continue)
       else if (delta_max > one) {
+        // Accept the step if it can't be shrunk any further
+        if (h <= h_min) {
+          err |= ODE_ERR_MIN_STEP;
+          h_next = h_min;
+          break;
+        }
+        clamped = false;
         h_next = h * one_fifth;
         if (h_next < h_min) {
           h_next = h_min;
@@ -238,12 +321,29 @@ int ode45(T ti, T tf, T const *yi, T *yf, unsigned int ne, T *bf, T h_min,
       
     }  // End error checking loop
 
+    // Interpolate any output states within the step
+    for (; o < no && (to[o] <= t + h || t + h >= tf); o++) {
+      T const s = (to[o] - t) / h, r = static_cast<T>(1) - s;
+      for (unsigned int i = 0; i < ne; i++) {
+        T const dy = ks[i] - yf[i];
+        T const b = h * k1[i] - dy;
+        T const c = dy - h * k7[i] - b;
+        T const d = h * (d1 * k1[i] + d3 * k3[i] + d4 * k4[i] + d5 * k5[i] + d6 * k6[i] + d7 * k7[i]);
+        yo[o * ne + i] = yf[i] + s * (dy + r * (b + s * (c + r * d)));
+      }
+    }
+
     // Step forward time, see if we're done, and prevent to large of a step
     t += h;
     for (unsigned int i = 0; i < ne; i++) yf[i] = ks[i];
     for (unsigned int i = 0; i < ne; i++) k1[i] = k7[i];
-    if (t >= tf) return err;
-    if (t + h_next >= tf) h_next = tf - t;
+    if (t >= tf) {
+      if (h_io) *h_io = clamped ? std::max(h_free, h_next) : h_next;
+      return err;
+    }
+    h_free = h_next;
+    clamped = t + h_next >= tf;
+    if (clamped) h_next = tf - t;
 
   }
 }
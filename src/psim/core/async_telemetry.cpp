@@ -0,0 +1,196 @@
+//
+// MIT License
+//
+// Copyright (c) 2020 Pathfinder for Autonomous Navigation (PAN)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/** @file psim/core/async_telemetry.cpp
+ *  @author Kyle Krol
+ */
+
+#include <psim/core/async_telemetry.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+namespace psim {
+
+/** @brief Maximum number of samples the writer thread pops at once.
+ */
+static constexpr std::size_t batch = 64;
+
+AsyncTelemetryWriter::AsyncTelemetryWriter(State const &state,
+    std::string const &file, std::vector<std::string> const &fields,
+    std::size_t decimation, std::size_t chunk, std::size_t capacity,
+    Policy policy)
+  : _writer(state, file, fields, decimation, chunk),
+    _ring(capacity, std::max<std::size_t>(_writer.columns().size(), 1)),
+    _row(_ring.width()), _policy(policy), _decimation(decimation), _n(0),
+    _factor(1), _skipped(0), _samples(0), _dropped(0), _stalls(0),
+    _stall_ns(0), _max_depth(0), _written(0), _failed(false), _stop(false),
+    _closed(false) {
+  _thread = std::thread([this]() { _drain(); });
+}
+
+AsyncTelemetryWriter::~AsyncTelemetryWriter() {
+  try {
+    close();
+  } catch (std::exception const &) {
+    // Errors can't be reported from a destructor
+  }
+}
+
+void AsyncTelemetryWriter::_drain() {
+  std::vector<TelemetryWriter::Value> rows(batch * _ring.width());
+
+  try {
+    while (true) {
+      auto const n = _ring.pop(rows.data(), batch);
+      for (std::size_t i = 0; i < n; i++)
+        _writer.append(rows.data() + i * _ring.width());
+      _written.fetch_add(n, std::memory_order_relaxed);
+
+      if (n > 0)
+        continue;
+      if (_stop.load(std::memory_order_acquire) && _ring.size() == 0)
+        break;
+
+      // The producer never takes the lock unless it's blocked so the queue is
+      // polled while idle
+      std::unique_lock<std::mutex> lock(_mutex);
+      _condition.wait_for(lock, std::chrono::milliseconds(1));
+    }
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _exception = std::current_exception();
+    _failed.store(true, std::memory_order_release);
+  }
+}
+
+void AsyncTelemetryWriter::_check() {
+  if (!_failed.load(std::memory_order_acquire))
+    return;
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  std::rethrow_exception(_exception);
+}
+
+void AsyncTelemetryWriter::step() {
+  if (++_n < _decimation)
+    return;
+
+  _n = 0;
+  record();
+}
+
+void AsyncTelemetryWriter::record() {
+  _check();
+  if (_closed)
+    throw std::runtime_error("Telemetry file already closed: " + file());
+
+  _samples++;
+  if (_policy == Policy::Decimate && ++_skipped < _factor) {
+    _dropped++;
+    return;
+  }
+  _skipped = 0;
+
+  _writer.sample(_row.data());
+
+  switch (_policy) {
+  case Policy::Block:
+    if (!_ring.push(_row.data())) {
+      auto const start = std::chrono::steady_clock::now();
+      _stalls++;
+      _condition.notify_one();
+      do {
+        _check();
+        std::this_thread::yield();
+      } while (!_ring.push(_row.data()));
+      _stall_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start).count();
+    }
+    break;
+
+  case Policy::DropOldest:
+    if (_ring.push_overwrite(_row.data()))
+      _dropped++;
+    break;
+
+  case Policy::Decimate:
+    if (!_ring.push(_row.data())) {
+      _dropped++;
+      _factor *= 2;
+    } else if (_factor > 1 && _ring.size() < _ring.capacity() / 4) {
+      _factor = 1;
+    }
+    break;
+  }
+
+  _max_depth = std::max(_max_depth, _ring.size());
+}
+
+void AsyncTelemetryWriter::close() {
+  if (_closed)
+    return;
+
+  _closed = true;
+  _stop.store(true, std::memory_order_release);
+  _condition.notify_one();
+  _thread.join();
+
+  _check();
+  _writer.close();
+}
+
+AsyncTelemetryWriter::Stats AsyncTelemetryWriter::stats() const {
+  Stats stats;
+  stats.samples = _samples;
+  stats.written = _written.load(std::memory_order_relaxed);
+  stats.dropped = _dropped;
+  stats.stalls = _stalls;
+  stats.stall_ns = _stall_ns;
+  stats.depth = _ring.size();
+  stats.max_depth = _max_depth;
+  return stats;
+}
+
+std::vector<std::string> const &AsyncTelemetryWriter::columns() const {
+  return _writer.columns();
+}
+
+std::string const &AsyncTelemetryWriter::file() const {
+  return _writer.file();
+}
+
+AsyncTelemetryWriter::Policy AsyncTelemetryWriter::policy(
+    std::string const &name) {
+  if (name == "block")
+    return Policy::Block;
+  if (name == "drop_oldest")
+    return Policy::DropOldest;
+  if (name == "decimate")
+    return Policy::Decimate;
+
+  throw std::runtime_error("Unknown telemetry backpressure policy: " + name);
+}
+} // namespace psim
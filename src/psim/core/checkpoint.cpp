@@ -0,0 +1,148 @@
+//
+// MIT License
+//
+// Copyright (c) 2020 Pathfinder for Autonomous Navigation (PAN)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/** @file psim/core/checkpoint.cpp
+ *  @author Kyle Krol
+ */
+
+#include <psim/core/checkpoint.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace psim {
+
+/** @brief Magic string every checkpoint file starts with.
+ */
+static constexpr char magic[8] = {'P', 'S', 'I', 'M', 'C', 'K', 'P', 'T'};
+
+/** @brief Layout hash of a checkpoint without any records.
+ */
+static constexpr std::uint64_t offset_basis = 14695981039346656037ull;
+
+constexpr std::uint32_t Checkpoint::version;
+
+/* The layout is an FNV-1a style hash over each record's name length, name, and
+ * size taken 64 bits at a time so folding long names stays cheap.
+ */
+std::uint64_t Checkpoint::_fold(
+    std::uint64_t layout, std::string const &name, std::size_t size) {
+  auto const fold = [&layout](std::uint64_t word) {
+    layout = (layout ^ word) * 1099511628211ull;
+  };
+
+  fold(static_cast<std::uint64_t>(name.size()));
+  std::size_t i = 0;
+  for (; i + sizeof(std::uint64_t) <= name.size(); i += sizeof(std::uint64_t)) {
+    std::uint64_t word;
+    std::memcpy(&word, name.data() + i, sizeof(word));
+    fold(word);
+  }
+  if (i < name.size()) {
+    std::uint64_t word = 0;
+    std::memcpy(&word, name.data() + i, name.size() - i);
+    fold(word);
+  }
+  fold(static_cast<std::uint64_t>(size));
+  return layout;
+}
+
+void Checkpoint::_write(
+    std::string const &name, void const *value, std::size_t size) {
+  _layout = _fold(_layout, name, size);
+  _data.append(static_cast<char const *>(value), size);
+}
+
+Checkpoint::Checkpoint() : _layout(offset_basis) {}
+
+Checkpoint::Checkpoint(std::string const &file) : _layout(offset_basis) {
+  std::ifstream ifs(file, std::ios::binary);
+  if (!ifs.is_open())
+    throw std::runtime_error("Failed to open checkpoint file: " + file);
+
+  char header[sizeof(magic)];
+  std::uint32_t file_version;
+  ifs.read(header, sizeof(header));
+  ifs.read(reinterpret_cast<char *>(&file_version), sizeof(file_version));
+  if (!ifs || std::memcmp(header, magic, sizeof(magic)) != 0)
+    throw std::runtime_error("Not a checkpoint file: " + file);
+  if (file_version != version)
+    throw std::runtime_error("Unsupported checkpoint version " +
+                             std::to_string(file_version) + " in " + file);
+
+  ifs.read(reinterpret_cast<char *>(&_layout), sizeof(_layout));
+  if (!ifs)
+    throw std::runtime_error("Not a checkpoint file: " + file);
+
+  _data.assign(std::istreambuf_iterator<char>(ifs),
+      std::istreambuf_iterator<char>());
+}
+
+void Checkpoint::save(std::string const &file) const {
+  std::ofstream ofs(file, std::ios::binary | std::ios::trunc);
+  if (!ofs.is_open())
+    throw std::runtime_error("Failed to open checkpoint file: " + file);
+
+  ofs.write(magic, sizeof(magic));
+  ofs.write(reinterpret_cast<char const *>(&version), sizeof(version));
+  ofs.write(reinterpret_cast<char const *>(&_layout), sizeof(_layout));
+  ofs.write(_data.data(), _data.size());
+  if (!ofs)
+    throw std::runtime_error("Failed to write checkpoint file: " + file);
+}
+
+std::size_t Checkpoint::size() const {
+  return _data.size();
+}
+
+std::uint64_t Checkpoint::layout() const {
+  return _layout;
+}
+
+void Checkpoint::clear() {
+  _data.clear();
+  _layout = offset_basis;
+}
+
+Checkpoint::Reader::Reader(Checkpoint const &checkpoint)
+  : _checkpoint(checkpoint), _offset(0), _layout(offset_basis) {}
+
+void Checkpoint::Reader::_read(
+    std::string const &name, void *value, std::size_t size) {
+  auto const &data = _checkpoint._data;
+  if (data.size() - _offset < size)
+    throw std::runtime_error("Checkpoint ended while reading record: " + name);
+
+  std::memcpy(value, data.data() + _offset, size);
+  _offset += size;
+  _layout = _fold(_layout, name, size);
+}
+
+bool Checkpoint::Reader::done() const {
+  return _offset == _checkpoint._data.size() &&
+         _layout == _checkpoint._layout;
+}
+} // namespace psim
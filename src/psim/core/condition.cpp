@@ -0,0 +1,191 @@
+//
+// MIT License
+//
+// Copyright (c) 2020 Pathfinder for Autonomous Navigation (PAN)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/** @file psim/core/condition.cpp
+ *  @author Kyle Krol
+ */
+
+#include <psim/core/condition.hpp>
+
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace psim {
+
+template <typename T>
+bool Condition::_compare(T const &lhs, T const &rhs) const {
+  switch (_comparison) {
+  case Comparison::Less:
+    return lhs < rhs;
+  case Comparison::LessEqual:
+    return lhs <= rhs;
+  case Comparison::Greater:
+    return lhs > rhs;
+  case Comparison::GreaterEqual:
+    return lhs >= rhs;
+  case Comparison::Equal:
+    return lhs == rhs;
+  case Comparison::NotEqual:
+    return lhs != rhs;
+  }
+  return false;
+}
+
+void Condition::_bind(State const &state, std::string const &name) {
+  auto const *field = state.get(name);
+  if (!field)
+    throw std::runtime_error("Condition field not found with name: " + name);
+
+  // Resolve the field's type once so evaluation doesn't require a cast.
+  _boolean_field = nullptr;
+  _integer_field = nullptr;
+  _real_field = nullptr;
+
+  _tag = field->tag();
+  switch (_tag) {
+  case TypeTag::Boolean:
+    _boolean_field = &field->cast<Boolean>();
+    break;
+  case TypeTag::Integer:
+    _integer_field = &field->cast<Integer>();
+    break;
+  case TypeTag::Real:
+    _real_field = &field->cast<Real>();
+    break;
+  default:
+    throw std::runtime_error("Condition field holds an unsupported type: " +
+                             field->name() + ":" + field->type());
+  }
+}
+
+Condition::Condition(State const &state, std::string const &field,
+    Comparison comparison, Integer value)
+  : _comparison(comparison), _integer(value), _real(value) {
+  _bind(state, field);
+}
+
+Condition::Condition(State const &state, std::string const &field,
+    Comparison comparison, Real value)
+  : _comparison(comparison), _integer(value), _real(value) {
+  _bind(state, field);
+  if (_tag == TypeTag::Integer && Real(_integer) != _real)
+    throw std::runtime_error(
+        "Condition on integer field '" + field + "' requires an integer value");
+}
+
+Condition::Condition(State const &state, std::string const &expression)
+  : _integer(0), _real(0.0) {
+  std::istringstream iss(expression);
+  std::vector<std::string> const tokens{
+      std::istream_iterator<std::string>{iss},
+      std::istream_iterator<std::string>{}};
+
+  if (tokens.size() != 3)
+    throw std::runtime_error("Condition expression must be of the form "
+                             "'<field> <op> <value>': " + expression);
+
+  auto const &op = tokens[1];
+  if (op == "<")
+    _comparison = Comparison::Less;
+  else if (op == "<=")
+    _comparison = Comparison::LessEqual;
+  else if (op == ">")
+    _comparison = Comparison::Greater;
+  else if (op == ">=")
+    _comparison = Comparison::GreaterEqual;
+  else if (op == "==")
+    _comparison = Comparison::Equal;
+  else if (op == "!=")
+    _comparison = Comparison::NotEqual;
+  else
+    throw std::runtime_error(
+        "Invalid comparison operator in condition expression: " + expression);
+
+  _bind(state, tokens[0]);
+
+  auto const &value = tokens[2];
+  try {
+    switch (_tag) {
+    case TypeTag::Boolean:
+      if (_comparison != Comparison::Equal &&
+          _comparison != Comparison::NotEqual)
+        throw std::runtime_error("Boolean fields only support '==' and '!=' "
+                                 "in condition expression: " + expression);
+      if (value == "true")
+        _integer = 1;
+      else if (value == "false")
+        _integer = 0;
+      else
+        throw std::runtime_error(
+            "Invalid boolean value in condition expression: " + expression);
+      break;
+
+    case TypeTag::Integer: {
+      std::size_t n;
+      _integer = std::stol(value, &n);
+      if (n != value.size())
+        throw std::runtime_error(
+            "Invalid integer value in condition expression: " + expression);
+      break;
+    }
+
+    case TypeTag::Real:
+      _real = std::stod(value);
+      break;
+
+    default:
+      break;
+    }
+  } catch (std::logic_error const &e) {
+    // Reinterpret errors potentially thrown by 'std::stod' and 'std::stol'.
+    throw std::runtime_error(
+        "Invalid value in condition expression: " + expression);
+  }
+}
+
+std::string Condition::field(std::string const &expression) {
+  std::istringstream iss(expression);
+  std::string name;
+  if (!(iss >> name))
+    throw std::runtime_error("Condition expression must be of the form "
+                             "'<field> <op> <value>': " + expression);
+
+  return name;
+}
+
+bool Condition::operator()() const {
+  switch (_tag) {
+  case TypeTag::Boolean:
+    return _compare<Integer>(_boolean_field->get(), _integer);
+  case TypeTag::Integer:
+    return _compare(_integer_field->get(), _integer);
+  case TypeTag::Real:
+    return _compare(_real_field->get(), _real);
+  default:
+    return false;
+  }
+}
+} // namespace psim
@@ -157,6 +157,52 @@ Configuration::Configuration(std::vector<std::string> const &files) {
     _parse(file);
 }
 
+Configuration Configuration::overlay(Configuration const &base) {
+  Configuration config;
+  config._base = &base;
+  return config;
+}
+
+Configuration Configuration::copy(Configuration const &config) {
+  Configuration copy;
+  copy.merge(config);
+  return copy;
+}
+
+void Configuration::merge(Configuration const &config) {
+  if (config._base)
+    merge(*config._base);
+
+  for (auto const &pair : config._parameters) {
+    auto const &name = pair.first;
+    auto const &parameter = *pair.second;
+
+    switch (parameter.tag()) {
+    case TypeTag::Boolean:
+      set(name, parameter.get<Boolean>());
+      break;
+    case TypeTag::Integer:
+      set(name, parameter.get<Integer>());
+      break;
+    case TypeTag::Real:
+      set(name, parameter.get<Real>());
+      break;
+    case TypeTag::Vector2:
+      set(name, parameter.get<Vector2>());
+      break;
+    case TypeTag::Vector3:
+      set(name, parameter.get<Vector3>());
+      break;
+    case TypeTag::Vector4:
+      set(name, parameter.get<Vector4>());
+      break;
+    default:
+      throw std::runtime_error(
+          "Parameter '" + name + "' holds an unsupported type.");
+    }
+  }
+}
+
 ParameterBase const &Configuration::operator[](std::string const &name) const {
   auto const &parameter_ptr = this->get(name);
   if (!parameter_ptr)
@@ -167,6 +213,9 @@ ParameterBase const &Configuration::operator[](std::string const &name) const {
 
 ParameterBase const *Configuration::get(std::string const &name) const {
   auto const iter = _parameters.find(name);
-  return (iter == _parameters.end() ? nullptr : iter->second.get());
+  if (iter != _parameters.end())
+    return iter->second.get();
+
+  return (_base ? _base->get(name) : nullptr);
 }
 } // namespace psim
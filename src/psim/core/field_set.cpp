@@ -0,0 +1,217 @@
+//
+// MIT License
+//
+// Copyright (c) 2020 Pathfinder for Autonomous Navigation (PAN)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/** @file psim/core/field_set.cpp
+ *  @author Kyle Krol
+ */
+
+#include <psim/core/field_set.hpp>
+
+#include <stdexcept>
+#include <unordered_set>
+
+namespace psim {
+
+FieldSet::FieldSet(State &state, std::vector<std::string> const &fields)
+  : _fields(fields), _size(0), _writable(true) {
+  std::unordered_set<std::string> names;
+
+  _entries.reserve(_fields.size());
+  for (auto const &name : _fields) {
+    if (!names.insert(name).second)
+      throw std::runtime_error("Duplicate field set field: " + name);
+
+    auto const *field = state.get(name);
+    if (!field)
+      throw std::runtime_error("Field set field not found with name: " + name);
+
+    std::size_t width;
+    switch (field->tag()) {
+    case TypeTag::Boolean:
+    case TypeTag::Integer:
+    case TypeTag::Real:
+      width = 1;
+      break;
+
+    case TypeTag::Vector2:
+      width = 2;
+      break;
+
+    case TypeTag::Vector3:
+      width = 3;
+      break;
+
+    case TypeTag::Vector4:
+      width = 4;
+      break;
+
+    default:
+      throw std::runtime_error("Field set field holds an unsupported type: " +
+                               field->name() + ":" + field->type());
+    }
+
+    auto *writable = state.get_writable(name);
+    _writable = _writable && writable;
+    _entries.push_back({field, writable, field->tag(), _size, width});
+    _size += width;
+  }
+}
+
+FieldSet::Entry const &FieldSet::_at(std::size_t i) const {
+  if (i >= _entries.size())
+    throw std::runtime_error("Field set index out of bounds: " +
+                             std::to_string(i));
+
+  return _entries[i];
+}
+
+void FieldSet::_get(Entry const &entry, Real *v) {
+  switch (entry.tag) {
+  case TypeTag::Boolean:
+    v[0] = entry.field->get<Boolean>() ? 1.0 : 0.0;
+    break;
+
+  case TypeTag::Integer:
+    v[0] = static_cast<Real>(entry.field->get<Integer>());
+    break;
+
+  case TypeTag::Real:
+    v[0] = entry.field->get<Real>();
+    break;
+
+  case TypeTag::Vector2: {
+    auto const &x = entry.field->get<Vector2>();
+    for (lin::size_t j = 0; j < 2; j++)
+      v[j] = x(j);
+    break;
+  }
+
+  case TypeTag::Vector3: {
+    auto const &x = entry.field->get<Vector3>();
+    for (lin::size_t j = 0; j < 3; j++)
+      v[j] = x(j);
+    break;
+  }
+
+  case TypeTag::Vector4: {
+    auto const &x = entry.field->get<Vector4>();
+    for (lin::size_t j = 0; j < 4; j++)
+      v[j] = x(j);
+    break;
+  }
+
+  default:
+    break;
+  }
+}
+
+void FieldSet::_set(Entry const &entry, Real const *v) {
+  switch (entry.tag) {
+  case TypeTag::Boolean:
+    entry.writable->get<Boolean>() = (v[0] != 0.0);
+    break;
+
+  case TypeTag::Integer:
+    entry.writable->get<Integer>() = static_cast<Integer>(v[0]);
+    break;
+
+  case TypeTag::Real:
+    entry.writable->get<Real>() = v[0];
+    break;
+
+  case TypeTag::Vector2: {
+    auto &x = entry.writable->get<Vector2>();
+    for (lin::size_t j = 0; j < 2; j++)
+      x(j) = v[j];
+    break;
+  }
+
+  case TypeTag::Vector3: {
+    auto &x = entry.writable->get<Vector3>();
+    for (lin::size_t j = 0; j < 3; j++)
+      x(j) = v[j];
+    break;
+  }
+
+  case TypeTag::Vector4: {
+    auto &x = entry.writable->get<Vector4>();
+    for (lin::size_t j = 0; j < 4; j++)
+      x(j) = v[j];
+    break;
+  }
+
+  default:
+    break;
+  }
+}
+
+std::vector<std::string> const &FieldSet::fields() const {
+  return _fields;
+}
+
+std::size_t FieldSet::size() const {
+  return _size;
+}
+
+std::size_t FieldSet::offset(std::size_t i) const {
+  return _at(i).offset;
+}
+
+std::size_t FieldSet::width(std::size_t i) const {
+  return _at(i).width;
+}
+
+TypeTag FieldSet::tag(std::size_t i) const {
+  return _at(i).tag;
+}
+
+bool FieldSet::writable() const {
+  return _writable;
+}
+
+void FieldSet::get(Real *values) const {
+  for (auto const &entry : _entries)
+    _get(entry, values + entry.offset);
+}
+
+void FieldSet::set(Real const *values) {
+  if (!_writable)
+    for (auto const &entry : _entries)
+      if (!entry.writable)
+        throw std::runtime_error("Field set field is not writable: " +
+                                 entry.field->name());
+
+  for (auto const &entry : _entries)
+    _set(entry, values + entry.offset);
+}
+
+void FieldSet::set(std::size_t i, Real const *values) {
+  auto const &entry = _at(i);
+  if (!entry.writable)
+    throw std::runtime_error("Field set field is not writable: " +
+                             entry.field->name());
+
+  _set(entry, values);
+}
+} // namespace psim
@@ -28,14 +28,69 @@
 
 #include <psim/core/model.hpp>
 
+#include <string>
+
 namespace psim {
 
-Model::Model(RandomsGenerator &randoms) : _randoms(randoms) { }
+/* Record name of the epoch kept so checkpointing doesn't build a string per
+ * model.
+ */
+static std::string const epoch = "epoch";
+
+Model::Model(RandomsGenerator &randoms)
+  : _period(1), _phase(0), _parent(nullptr), _randoms(randoms), _epoch(0) { }
 
 void Model::add_fields(State &state) {}
 
 void Model::get_fields(State &state) {}
 
-void Model::step() {}
+void Model::schedule(std::size_t period, std::size_t phase) {
+  if (period == 0)
+    throw std::runtime_error("Model period must be greater than zero");
+  if (phase >= period)
+    throw std::runtime_error("Model phase must be less than its period");
+
+  _period = period;
+  _phase = phase;
+}
+
+std::size_t Model::period() const {
+  return _period;
+}
+
+std::size_t Model::phase() const {
+  return _phase;
+}
+
+std::size_t Model::ticks() const {
+  return _period * (_parent ? _parent->ticks() : 1);
+}
+
+std::string Model::label() const {
+  return "";
+}
+
+void Model::step() {
+  _epoch++;
+}
+
+bool Model::draws_randoms() const {
+  return false;
+}
+
+void Model::parallelize(ThreadPool &pool) {}
+
+void Model::prune(
+    State &state, std::vector<StateFieldBase const *> const &fields) {}
+
+void Model::checkpoint(Checkpoint &checkpoint) const {
+  checkpoint.write(epoch, _epoch);
+}
+
+void Model::restore(Checkpoint::Reader &reader) {
+  reader.read(epoch, _epoch);
+}
+
+void Model::configure(Configuration const &config) {}
 
 } // namespace psim
@@ -0,0 +1,254 @@
+//
+// MIT License
+//
+// Copyright (c) 2020 Pathfinder for Autonomous Navigation (PAN)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/** @file psim/core/model_graph.cpp
+ *  @author Kyle Krol
+ */
+
+#include <psim/core/model_graph.hpp>
+
+#include <psim/core/profiler.hpp>
+
+#include <algorithm>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+namespace psim {
+
+/** @brief Placeholder resource for the simulation's random number generator.
+ */
+static char const randoms = 0;
+
+/** @return True if the two sorted sets share an element.
+ */
+static bool intersects(
+    std::set<void const *> const &a, std::set<void const *> const &b) {
+  auto i = a.begin();
+  auto j = b.begin();
+  while (i != a.end() && j != b.end()) {
+    if (*i < *j)
+      i++;
+    else if (*j < *i)
+      j++;
+    else
+      return true;
+  }
+  return false;
+}
+
+ModelGraph::ModelGraph()
+  : _pool(nullptr), _tick(0), _scheduled(false), _pending(0), _failed(false) {}
+
+void ModelGraph::build(std::vector<Model *> const &models,
+    std::vector<Footprint> const &footprints) {
+  if (models.size() != footprints.size())
+    throw std::runtime_error(
+        "Model graph requires exactly one footprint per model");
+
+  auto const n = models.size();
+
+  // Owners of all fields added by the models
+  std::unordered_map<StateFieldBase const *, std::size_t> owners;
+  for (std::size_t i = 0; i < n; i++)
+    for (auto const *field : footprints[i].adds)
+      owners[field] = i;
+
+  // Everything each model may write to and access
+  std::vector<std::set<void const *>> writes(n), accesses(n);
+  for (std::size_t i = 0; i < n; i++) {
+    auto const &footprint = footprints[i];
+    writes[i].insert(footprint.adds.begin(), footprint.adds.end());
+    writes[i].insert(footprint.writes.begin(), footprint.writes.end());
+    if (models[i]->draws_randoms())
+      writes[i].insert(&randoms);
+
+    accesses[i] = writes[i];
+    accesses[i].insert(footprint.reads.begin(), footprint.reads.end());
+  }
+
+  // Reading another model's lazy field accesses whatever that model accesses
+  for (bool changed = true; changed;) {
+    changed = false;
+    for (std::size_t i = 0; i < n; i++) {
+      auto const size = accesses[i].size();
+      auto const draws = writes[i].count(&randoms);
+      for (auto const &owner : owners) {
+        if (owner.second == i || !accesses[i].count(owner.first) ||
+            !dynamic_cast<StateFieldLazyBase const *>(owner.first))
+          continue;
+
+        auto const j = owner.second;
+        accesses[i].insert(accesses[j].begin(), accesses[j].end());
+        if (writes[j].count(&randoms))
+          writes[i].insert(&randoms);
+      }
+      changed |= (accesses[i].size() != size);
+      changed |= (writes[i].count(&randoms) != draws);
+    }
+  }
+
+  _nodes.clear();
+  _roots.clear();
+  _lazies.clear();
+  for (std::size_t i = 0; i < n; i++) {
+    _nodes.push_back(std::make_unique<Node>());
+    _nodes[i]->graph = this;
+    _nodes[i]->model = models[i];
+    _nodes[i]->predecessors = 0;
+  }
+
+  // Edges between conflicting models. Candidate predecessors are visited
+  // latest first and skipped if already transitively ordered, which keeps
+  // the number of edges small.
+  std::vector<std::vector<bool>> ancestors(n, std::vector<bool>(n, false));
+  for (std::size_t j = 0; j < n; j++) {
+    for (std::size_t k = j; k > 0; k--) {
+      auto const i = k - 1;
+      if (ancestors[j][i])
+        continue;
+      if (!intersects(writes[i], accesses[j]) &&
+          !intersects(writes[j], accesses[i]))
+        continue;
+
+      _nodes[i]->successors.push_back(_nodes[j].get());
+      _nodes[j]->predecessors++;
+      ancestors[j][i] = true;
+      for (std::size_t l = 0; l < i; l++)
+        if (ancestors[i][l])
+          ancestors[j][l] = true;
+    }
+  }
+
+  for (auto const &node : _nodes)
+    if (node->predecessors == 0)
+      _roots.push_back(node.get());
+
+  // Lazy fields accessed by more than one model. Fields are owned by the
+  // models, which aren't const, so casting away const here is safe.
+  for (auto const &owner : owners) {
+    auto const *lazy = dynamic_cast<StateFieldLazyBase const *>(owner.first);
+    if (!lazy)
+      continue;
+
+    auto const readers = std::count_if(accesses.begin(), accesses.end(),
+        [&owner](std::set<void const *> const &access) {
+          return access.count(owner.first) > 0;
+        });
+    if (readers > 1)
+      _lazies.push_back(const_cast<StateFieldLazyBase *>(lazy));
+  }
+}
+
+std::size_t ModelGraph::size() const {
+  return _nodes.size();
+}
+
+bool ModelGraph::precedes(std::size_t i, std::size_t j) const {
+  if (i >= _nodes.size() || j >= _nodes.size())
+    throw std::runtime_error("Model graph index out of bounds");
+
+  auto const &successors = _nodes[i]->successors;
+  return std::find(successors.begin(), successors.end(), _nodes[j].get()) !=
+         successors.end();
+}
+
+void ModelGraph::share() {
+  for (auto *lazy : _lazies)
+    lazy->share();
+}
+
+void ModelGraph::_run(void *data) {
+  auto *node = static_cast<Node *>(data);
+  auto &graph = *node->graph;
+
+  while (node) {
+    auto const skip =
+        graph._scheduled && !node->model->scheduled(graph._tick);
+    if (!graph._failed && !skip) {
+      try {
+        Profiler::Scope const profile(*node->model);
+        node->model->step();
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(graph._exception_mutex);
+        if (!graph._exception)
+          graph._exception = std::current_exception();
+        graph._failed = true;
+      }
+    }
+
+    // Continue with the first successor made ready and hand the rest to the
+    // pool.
+    Node *next = nullptr;
+    for (auto *successor : node->successors) {
+      if (successor->remaining.fetch_sub(1) != 1)
+        continue;
+      if (!next)
+        next = successor;
+      else
+        graph._pool->submit({&ModelGraph::_run, successor});
+    }
+
+    graph._pending--;
+    node = next;
+  }
+}
+
+void ModelGraph::step(ThreadPool &pool) {
+  _scheduled = false;
+  _step(pool);
+}
+
+void ModelGraph::step(ThreadPool &pool, std::size_t tick) {
+  _tick = tick;
+  _scheduled = true;
+  _step(pool);
+}
+
+void ModelGraph::_step(ThreadPool &pool) {
+  if (_nodes.empty())
+    return;
+
+  _pool = &pool;
+  _pending = _nodes.size();
+  for (auto const &node : _nodes)
+    node->remaining = node->predecessors;
+
+  for (auto *root : _roots)
+    pool.submit({&ModelGraph::_run, root});
+
+  while (_pending > 0)
+    if (!pool.help())
+      std::this_thread::yield();
+
+  _pool = nullptr;
+  if (_failed) {
+    auto exception = _exception;
+    _exception = nullptr;
+    _failed = false;
+    std::rethrow_exception(exception);
+  }
+}
+} // namespace psim
@@ -28,28 +28,202 @@
 
 #include <psim/core/model_list.hpp>
 
+#include <psim/core/profiler.hpp>
+#include <psim/core/state_field.hpp>
+
+#include <algorithm>
+
 namespace psim {
 
-ModelList::ModelList(RandomsGenerator &randoms) : Model(randoms) { }
+ModelList::ModelList(RandomsGenerator &randoms)
+  : Model(randoms), _pool(nullptr) { }
+
+void ModelList::_build() {
+  _graph.build(_models, _footprints);
+}
+
+bool ModelList::_require(std::unordered_set<StateFieldBase const *> &fields) {
+  auto const needs = [&fields](std::vector<StateFieldBase const *> const &v) {
+    return std::any_of(v.begin(), v.end(),
+        [&fields](StateFieldBase const *field) { return fields.count(field); });
+  };
+
+  _needed.resize(_models.size(), false);
+  for (std::size_t i = 0; i < _models.size(); i++) {
+    // Nested model lists are pruned model by model
+    auto *list = dynamic_cast<ModelList *>(_models[i]);
+    if (list) {
+      _needed[i] = list->_require(fields);
+      continue;
+    }
+
+    auto const &footprint = _footprints[i];
+    if (!_needed[i])
+      _needed[i] = _models[i]->draws_randoms() || needs(footprint.adds) ||
+                   needs(footprint.writes);
+    if (_needed[i]) {
+      fields.insert(footprint.reads.begin(), footprint.reads.end());
+      fields.insert(footprint.writes.begin(), footprint.writes.end());
+
+      // Models writing to the model's writable fields, such as actuators,
+      // affect how it steps
+      for (auto const *field : footprint.adds)
+        if (dynamic_cast<StateFieldWritableBase const *>(field))
+          fields.insert(field);
+    }
+  }
+
+  return std::find(_needed.begin(), _needed.end(), true) != _needed.end();
+}
+
+void ModelList::_prune(
+    State &state, std::unordered_set<StateFieldBase const *> &removed) {
+  std::size_t j = 0;
+  for (std::size_t i = 0; i < _models.size(); i++) {
+    if (!_needed[i]) {
+      for (auto const *field : _footprints[i].adds) {
+        state.remove(field);
+        removed.insert(field);
+      }
+
+      // Models owned by a derived model list are left alone
+      auto *model = _models[i];
+      _owned.erase(std::remove_if(_owned.begin(), _owned.end(),
+          [model](std::unique_ptr<Model> const &owned) {
+            return owned.get() == model;
+          }), _owned.end());
+      continue;
+    }
+
+    auto *list = dynamic_cast<ModelList *>(_models[i]);
+    if (list)
+      list->_prune(state, removed);
+
+    // Self move assignment would empty the footprint's vectors
+    if (i != j) {
+      _models[j] = _models[i];
+      _footprints[j] = std::move(_footprints[i]);
+    }
+    j++;
+  }
+  _models.resize(j);
+  _footprints.resize(j);
+  _needed.clear();
+
+  // Forget fields removed from within nested model lists
+  auto const forget = [&removed](std::vector<StateFieldBase const *> &v) {
+    v.erase(std::remove_if(v.begin(), v.end(),
+        [&removed](StateFieldBase const *field) {
+          return removed.count(field);
+        }), v.end());
+  };
+  for (auto &footprint : _footprints) {
+    forget(footprint.adds);
+    forget(footprint.reads);
+    forget(footprint.writes);
+  }
+
+  _build();
+}
 
 void ModelList::add_fields(State &state) {
   this->Model::add_fields(state);
 
-  for (auto const &model : _models)
-    model->add_fields(state);
+  _footprints.resize(_models.size());
+  for (std::size_t i = 0; i < _models.size(); i++) {
+    State::Trace const trace(state);
+    _models[i]->add_fields(state);
+    _footprints[i].adds = trace.adds;
+  }
 }
 
 void ModelList::get_fields(State &state) {
   this->Model::get_fields(state);
 
-  for (auto const &model : _models)
-    model->get_fields(state);
+  for (std::size_t i = 0; i < _models.size(); i++) {
+    State::Trace const trace(state);
+    _models[i]->get_fields(state);
+    _footprints[i].reads = trace.reads;
+    _footprints[i].writes = trace.writes;
+  }
+
+  _build();
 }
 
 void ModelList::step() {
+  auto const tick = _epoch;
   this->Model::step();
 
-  for (auto const &model : _models)
+  if (_pool) {
+    _graph.step(*_pool, tick);
+    return;
+  }
+
+  for (auto const &model : _models) {
+    if (!model->scheduled(tick))
+      continue;
+
+    Profiler::Scope const profile(*model);
     model->step();
+  }
+}
+
+bool ModelList::draws_randoms() const {
+  for (auto const &model : _models)
+    if (model->draws_randoms())
+      return true;
+
+  return false;
+}
+
+void ModelList::parallelize(ThreadPool &pool) {
+  _graph.share();
+  _pool = &pool;
+}
+
+void ModelList::prune(
+    State &state, std::vector<StateFieldBase const *> const &fields) {
+  this->Model::prune(state, fields);
+
+  // Grow the set of needed fields until no more models are marked
+  std::unordered_set<StateFieldBase const *> needed(
+      fields.begin(), fields.end());
+  std::size_t size;
+  do {
+    size = needed.size();
+    _require(needed);
+  } while (size != needed.size());
+
+  std::unordered_set<StateFieldBase const *> removed;
+  _prune(state, removed);
+}
+
+void ModelList::checkpoint(Checkpoint &checkpoint) const {
+  this->Model::checkpoint(checkpoint);
+
+  for (auto const &model : _models)
+    model->checkpoint(checkpoint);
+}
+
+void ModelList::restore(Checkpoint::Reader &reader) {
+  this->Model::restore(reader);
+
+  for (auto const &model : _models)
+    model->restore(reader);
+}
+
+void ModelList::configure(Configuration const &config) {
+  this->Model::configure(config);
+
+  for (auto const &model : _models)
+    model->configure(config);
+}
+
+std::vector<Model *> const &ModelList::models() const {
+  return _models;
+}
+
+ModelGraph const &ModelList::graph() const {
+  return _graph;
 }
 } // namespace psim
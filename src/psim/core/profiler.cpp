@@ -0,0 +1,248 @@
+//
+// MIT License
+//
+// Copyright (c) 2020 Pathfinder for Autonomous Navigation (PAN)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/** @file psim/core/profiler.cpp
+ *  @author Kyle Krol
+ */
+
+#include <psim/core/profiler.hpp>
+
+#include <psim/core/model.hpp>
+
+#include <cxxabi.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
+#include <typeinfo>
+#include <utility>
+
+namespace psim {
+namespace {
+
+/** @brief Events recorded by a single thread.
+ *
+ *  The mutex is only contended while events are being read or cleared.
+ */
+struct Buffer {
+  std::mutex mutex;
+  std::size_t thread;
+  std::vector<Profiler::Event> events;
+
+  /** @brief Time spent in nested events for each open event.
+   */
+  std::vector<std::int64_t> children;
+};
+} // namespace
+
+/** @brief Buffers of every thread that has recorded an event.
+ *
+ *  Buffers are shared so their events outlive the threads that recorded them.
+ */
+static std::mutex buffers_mutex;
+static std::vector<std::shared_ptr<Buffer>> buffers;
+
+/** @brief Time the profiler was last cleared.
+ */
+static std::atomic<std::chrono::steady_clock::rep> origin(
+    std::chrono::steady_clock::now().time_since_epoch().count());
+
+static std::int64_t now() {
+  auto const t = std::chrono::steady_clock::now().time_since_epoch().count() -
+                 origin.load(std::memory_order_relaxed);
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::duration(t))
+      .count();
+}
+
+static Buffer &buffer() {
+  thread_local std::shared_ptr<Buffer> buffer;
+  if (!buffer) {
+    buffer = std::make_shared<Buffer>();
+
+    std::lock_guard<std::mutex> lock(buffers_mutex);
+    buffer->thread = buffers.size();
+    buffers.push_back(buffer);
+  }
+  return *buffer;
+}
+
+static std::string demangle(char const *name) {
+  int status = 0;
+  std::unique_ptr<char, void (*)(void *)> demangled(
+      abi::__cxa_demangle(name, nullptr, nullptr, &status), std::free);
+  return status == 0 ? std::string(demangled.get()) : std::string(name);
+}
+
+/** @brief Escapes a string for use in JSON.
+ */
+static std::string escape(std::string const &str) {
+  std::string escaped;
+  for (auto const c : str) {
+    if (c == '"' || c == '\\')
+      escaped += '\\';
+    escaped += c;
+  }
+  return escaped;
+}
+
+std::atomic<bool> Profiler::_enabled(false);
+
+std::int64_t Profiler::_enter() {
+  buffer().children.push_back(0);
+  return now();
+}
+
+void Profiler::_exit(char const *category, std::string const &name,
+    void const *instance, std::int64_t begin) {
+  auto const duration = now() - begin;
+
+  auto &buffer = psim::buffer();
+  auto const children = buffer.children.back();
+  buffer.children.pop_back();
+  if (!buffer.children.empty())
+    buffer.children.back() += duration;
+
+  std::lock_guard<std::mutex> lock(buffer.mutex);
+  buffer.events.push_back({category, name, instance, buffer.thread,
+      buffer.children.size(), begin, duration, duration - children});
+}
+
+std::string const &Profiler::_model_name(Model const &model) {
+  // A model is never stepped concurrently with itself
+  if (model._profile_name.empty()) {
+    auto const label = model.label();
+    model._profile_name = demangle(typeid(model).name());
+    if (!label.empty())
+      model._profile_name += " (" + label + ")";
+  }
+  return model._profile_name;
+}
+
+void Profiler::enable() {
+  _enabled.store(true);
+}
+
+void Profiler::disable() {
+  _enabled.store(false);
+}
+
+void Profiler::clear() {
+  std::lock_guard<std::mutex> lock(buffers_mutex);
+  for (auto const &buffer : buffers) {
+    std::lock_guard<std::mutex> lock(buffer->mutex);
+    buffer->events.clear();
+  }
+  origin.store(std::chrono::steady_clock::now().time_since_epoch().count());
+}
+
+std::vector<Profiler::Event> Profiler::events() {
+  std::vector<Event> events;
+
+  std::lock_guard<std::mutex> lock(buffers_mutex);
+  for (auto const &buffer : buffers) {
+    std::lock_guard<std::mutex> lock(buffer->mutex);
+    events.insert(events.end(), buffer->events.begin(), buffer->events.end());
+  }
+  return events;
+}
+
+std::vector<Profiler::Summary> Profiler::summary() {
+  std::map<std::tuple<std::string, std::string, void const *>, Summary>
+      summaries;
+  for (auto const &event : events()) {
+    auto &summary =
+        summaries[std::make_tuple(event.category, event.name, event.instance)];
+    summary.category = event.category;
+    summary.name = event.name;
+    summary.calls++;
+    summary.total += event.duration;
+    summary.self += event.self;
+  }
+
+  std::vector<Summary> summary;
+  summary.reserve(summaries.size());
+  for (auto &entry : summaries)
+    summary.push_back(std::move(entry.second));
+
+  std::stable_sort(summary.begin(), summary.end(),
+      [](Summary const &a, Summary const &b) { return a.self > b.self; });
+  return summary;
+}
+
+std::string Profiler::report() {
+  auto const summary = Profiler::summary();
+
+  std::int64_t total = 0;
+  for (auto const &entry : summary)
+    total += entry.self;
+
+  char line[256];
+  std::snprintf(line, sizeof(line), "%-10s %10s %12s %12s %10s %6s  %s\n",
+      "category", "calls", "total [ms]", "self [ms]", "mean [us]", "self%",
+      "name");
+
+  std::string report(line);
+  for (auto const &entry : summary) {
+    std::snprintf(line, sizeof(line),
+        "%-10s %10zu %12.3f %12.3f %10.3f %5.1f%%  ", entry.category,
+        entry.calls, entry.total * 1.0e-6, entry.self * 1.0e-6,
+        entry.total * 1.0e-3 / entry.calls,
+        total > 0 ? 100.0 * entry.self / total : 0.0);
+    report += line + entry.name + "\n";
+  }
+  return report;
+}
+
+void Profiler::save(std::string const &file) {
+  std::ofstream ofs(file);
+  if (!ofs.is_open())
+    throw std::runtime_error("Failed to open trace file: " + file);
+
+  // Complete events with microsecond timestamps per the Trace Event Format
+  ofs << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+  char times[64];
+  bool first = true;
+  for (auto const &event : events()) {
+    std::snprintf(times, sizeof(times), "\"ts\":%.3f,\"dur\":%.3f",
+        event.begin * 1.0e-3, event.duration * 1.0e-3);
+    ofs << (first ? "\n" : ",\n") << "{\"name\":\"" << escape(event.name)
+        << "\",\"cat\":\"" << event.category << "\",\"ph\":\"X\",\"pid\":0"
+        << ",\"tid\":" << event.thread << "," << times << "}";
+    first = false;
+  }
+  ofs << "\n]}\n";
+
+  if (!ofs)
+    throw std::runtime_error("Failed to write trace file: " + file);
+}
+} // namespace psim
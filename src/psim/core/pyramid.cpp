@@ -0,0 +1,306 @@
+//
+// MIT License
+//
+// Copyright (c) 2020 Pathfinder for Autonomous Navigation (PAN)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/** @file psim/core/pyramid.cpp
+ *  @author Kyle Krol
+ */
+
+#include <psim/core/pyramid.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace psim {
+
+Pyramid::Pyramid(State const &state, std::vector<std::string> const &fields,
+    std::size_t bucket, std::size_t factor, std::size_t levels,
+    std::size_t decimation)
+  : _decimation(decimation), _n(0), _factor(factor), _size(0),
+    _closed(false) {
+  static char const *const suffixes[] = {".x", ".y", ".z", ".w"};
+
+  if (_decimation == 0)
+    throw std::runtime_error("Pyramid decimation must be greater than zero");
+  if (bucket == 0 || levels == 0)
+    throw std::runtime_error(
+        "Pyramid bucket size and number of levels must be greater than zero");
+  if (_factor < 2)
+    throw std::runtime_error("Pyramid factor must be at least two");
+
+  auto const add_column = [this](std::string const &name) {
+    if (_locations.count(name))
+      throw std::runtime_error("Duplicate pyramid column: " + name);
+
+    _locations[name] = _columns.size();
+    _columns.push_back(name);
+  };
+
+  for (auto const &name : fields) {
+    auto const *field = state.get(name);
+    if (!field)
+      throw std::runtime_error("Pyramid field not found with name: " + name);
+
+    std::size_t components;
+    switch (field->tag()) {
+    case TypeTag::Boolean:
+    case TypeTag::Integer:
+    case TypeTag::Real:
+      components = 0;
+      break;
+
+    case TypeTag::Vector2:
+      components = 2;
+      break;
+
+    case TypeTag::Vector3:
+      components = 3;
+      break;
+
+    case TypeTag::Vector4:
+      components = 4;
+      break;
+
+    default:
+      throw std::runtime_error("Pyramid field holds an unsupported type: " +
+                               field->name() + ":" + field->type());
+    }
+
+    _entries.push_back({field, field->tag(), _columns.size()});
+    if (components == 0)
+      add_column(name);
+    for (std::size_t i = 0; i < components; i++)
+      add_column(name + suffixes[i]);
+  }
+
+  auto const n = _columns.size();
+  _levels.resize(levels);
+  for (std::size_t i = 0; i < levels; i++) {
+    auto &level = _levels[i];
+    level.bucket = i ? _levels[i - 1].bucket * _factor : bucket;
+    level.count = 0;
+    level.pending.resize(n);
+    level.min.resize(n);
+    level.max.resize(n);
+    level.mean.resize(n);
+  }
+  _sample.resize(n);
+}
+
+void Pyramid::_add(std::size_t i, std::vector<Bucket> const &buckets,
+    std::size_t inputs) {
+  auto &level = _levels[i];
+  auto const n = _columns.size();
+
+  if (level.count == 0) {
+    level.pending = buckets;
+  } else {
+    for (std::size_t j = 0; j < n; j++) {
+      auto &pending = level.pending[j];
+      pending.min = std::min(pending.min, buckets[j].min);
+      pending.max = std::max(pending.max, buckets[j].max);
+      pending.sum += buckets[j].sum;
+    }
+  }
+
+  if (++level.count < inputs)
+    return;
+
+  level.count = 0;
+  for (std::size_t j = 0; j < n; j++) {
+    auto const &pending = level.pending[j];
+    level.min[j].push_back(pending.min);
+    level.max[j].push_back(pending.max);
+    level.mean[j].push_back(pending.sum / level.bucket);
+  }
+
+  if (i + 1 < _levels.size())
+    _add(i + 1, level.pending, _factor);
+}
+
+std::size_t Pyramid::_column(std::string const &name) const {
+  auto const it = _locations.find(name);
+  if (it == _locations.end())
+    throw std::runtime_error("Pyramid column not found with name: " + name);
+
+  return it->second;
+}
+
+Pyramid::Level const &Pyramid::_level(std::size_t level) const {
+  if (level >= _levels.size())
+    throw std::runtime_error("Pyramid level out of bounds: " +
+                             std::to_string(level));
+
+  return _levels[level];
+}
+
+void Pyramid::step() {
+  if (++_n < _decimation)
+    return;
+
+  _n = 0;
+  record();
+}
+
+void Pyramid::close() {
+  if (_closed)
+    return;
+
+  _closed = true;
+
+  /* The samples outside of a level's complete buckets are covered by its
+   * pending bucket together with the partial bucket flushed from the level
+   * below it.
+   */
+  auto const n = _columns.size();
+  std::vector<Bucket> partial;
+  for (auto &level : _levels) {
+    auto const remaining = _size % level.bucket;
+    if (remaining == 0) {
+      partial.clear();
+      continue;
+    }
+
+    if (level.count > 0 && !partial.empty()) {
+      for (std::size_t j = 0; j < n; j++) {
+        auto &pending = level.pending[j];
+        pending.min = std::min(pending.min, partial[j].min);
+        pending.max = std::max(pending.max, partial[j].max);
+        pending.sum += partial[j].sum;
+      }
+    }
+    if (level.count > 0)
+      partial = level.pending;
+
+    level.count = 0;
+    for (std::size_t j = 0; j < n; j++) {
+      level.min[j].push_back(partial[j].min);
+      level.max[j].push_back(partial[j].max);
+      level.mean[j].push_back(partial[j].sum / remaining);
+    }
+  }
+}
+
+void Pyramid::record() {
+  if (_closed)
+    throw std::runtime_error("Pyramid already closed");
+
+  auto const set = [this](std::size_t column, Real value) {
+    _sample[column] = {value, value, value};
+  };
+
+  for (auto const &entry : _entries) {
+    auto const i = entry.column;
+
+    switch (entry.tag) {
+    case TypeTag::Boolean:
+      set(i, entry.field->get<Boolean>() ? 1.0 : 0.0);
+      break;
+
+    case TypeTag::Integer:
+      set(i, static_cast<Real>(entry.field->get<Integer>()));
+      break;
+
+    case TypeTag::Real:
+      set(i, entry.field->get<Real>());
+      break;
+
+    case TypeTag::Vector2: {
+      auto const &v = entry.field->get<Vector2>();
+      for (lin::size_t j = 0; j < 2; j++)
+        set(i + j, v(j));
+      break;
+    }
+
+    case TypeTag::Vector3: {
+      auto const &v = entry.field->get<Vector3>();
+      for (lin::size_t j = 0; j < 3; j++)
+        set(i + j, v(j));
+      break;
+    }
+
+    case TypeTag::Vector4: {
+      auto const &v = entry.field->get<Vector4>();
+      for (lin::size_t j = 0; j < 4; j++)
+        set(i + j, v(j));
+      break;
+    }
+
+    default:
+      break;
+    }
+  }
+
+  _add(0, _sample, _levels.front().bucket);
+  _size++;
+}
+
+std::size_t Pyramid::size() const {
+  return _size;
+}
+
+std::vector<std::string> const &Pyramid::columns() const {
+  return _columns;
+}
+
+bool Pyramid::has(std::string const &name) const {
+  return _locations.count(name) != 0;
+}
+
+std::size_t Pyramid::levels() const {
+  return _levels.size();
+}
+
+std::size_t Pyramid::bucket(std::size_t level) const {
+  return _level(level).bucket;
+}
+
+std::size_t Pyramid::size(std::size_t level) const {
+  auto const &l = _level(level);
+  return l.min.empty() ? _buckets(_size, l.bucket) : l.min.front().size();
+}
+
+std::size_t Pyramid::_buckets(std::size_t samples, std::size_t bucket) const {
+  return samples / bucket + (_closed && samples % bucket ? 1 : 0);
+}
+
+std::size_t Pyramid::select(std::size_t samples, std::size_t points) const {
+  for (std::size_t i = 0; i < _levels.size(); i++)
+    if (_buckets(samples, _levels[i].bucket) <= points)
+      return i;
+
+  return _levels.size() - 1;
+}
+
+Real const *Pyramid::min(std::string const &name, std::size_t level) const {
+  return _level(level).min[_column(name)].data();
+}
+
+Real const *Pyramid::max(std::string const &name, std::size_t level) const {
+  return _level(level).max[_column(name)].data();
+}
+
+Real const *Pyramid::mean(std::string const &name, std::size_t level) const {
+  return _level(level).mean[_column(name)].data();
+}
+} // namespace psim
@@ -0,0 +1,144 @@
+//
+// MIT License
+//
+// Copyright (c) 2020 Pathfinder for Autonomous Navigation (PAN)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/** @file psim/core/random_stream.cpp
+ *  @author Kyle Krol
+ */
+
+#include <psim/core/random_stream.hpp>
+
+#include <cmath>
+
+namespace psim {
+
+/** @brief Philox multipliers and Weyl sequence constants.
+ */
+static constexpr std::uint32_t M0 = 0xD2511F53;
+static constexpr std::uint32_t M1 = 0xCD9E8D57;
+static constexpr std::uint32_t W0 = 0x9E3779B9;
+static constexpr std::uint32_t W1 = 0xBB67AE85;
+
+/** @brief Hashes a string into a running 64-bit FNV-1a hash.
+ */
+static std::uint64_t fnv1a(std::uint64_t hash, std::string const &str) {
+  for (auto const c : str) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 0x100000001B3ull;
+  }
+  return hash;
+}
+
+/** @brief Splitmix64 finalizer used to mix the seed into the key.
+ */
+static std::uint64_t mix(std::uint64_t x) {
+  x += 0x9E3779B97F4A7C15ull;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+  return x ^ (x >> 31);
+}
+
+/** @return Uniformly distributed random number in (0, 1) from 64 bits.
+ */
+static Real uniform(std::uint32_t hi, std::uint32_t lo) {
+  auto const bits = ((static_cast<std::uint64_t>(hi) << 32) | lo) >> 11;
+  return (static_cast<Real>(bits) + 0.5) / 9007199254740992.0;
+}
+
+static RandomStream::Key key(
+    Integer seed, std::string const &model, std::string const &name) {
+  auto hash = fnv1a(0xCBF29CE484222325ull, model);
+  hash = fnv1a(hash * 0x100000001B3ull, name);
+  hash = mix(hash ^ mix(static_cast<std::uint64_t>(seed)));
+
+  return {{static_cast<std::uint32_t>(hash),
+      static_cast<std::uint32_t>(hash >> 32)}};
+}
+
+RandomStream::RandomStream(Integer seed, std::string const &model,
+    std::string const &name, std::size_t const *epoch)
+  : _key(key(seed, model, name)), _epoch(epoch), _step(0), _draws(0) {}
+
+RandomStream::Block RandomStream::philox(Key key, Block counter) {
+  for (std::size_t i = 0; i < 10; i++) {
+    if (i > 0) {
+      key[0] += W0;
+      key[1] += W1;
+    }
+
+    auto const p0 = static_cast<std::uint64_t>(M0) * counter[0];
+    auto const p1 = static_cast<std::uint64_t>(M1) * counter[2];
+    counter = {{static_cast<std::uint32_t>(p1 >> 32) ^ counter[1] ^ key[0],
+        static_cast<std::uint32_t>(p1),
+        static_cast<std::uint32_t>(p0 >> 32) ^ counter[3] ^ key[1],
+        static_cast<std::uint32_t>(p0)}};
+  }
+  return counter;
+}
+
+RandomStream::Block RandomStream::_next() {
+  auto const step = _epoch ? *_epoch : 0;
+  if (step != _step) {
+    _step = step;
+    _draws = 0;
+  }
+
+  auto const draw = _draws++;
+  auto const epoch = static_cast<std::uint64_t>(_step);
+  return philox(_key, {{static_cast<std::uint32_t>(draw),
+      static_cast<std::uint32_t>(draw >> 32),
+      static_cast<std::uint32_t>(epoch),
+      static_cast<std::uint32_t>(epoch >> 32)}});
+}
+
+void RandomStream::reseed(
+    Integer seed, std::string const &model, std::string const &name) {
+  _key = key(seed, model, name);
+  _step = _epoch ? *_epoch : 0;
+  _draws = 0;
+}
+
+void RandomStream::checkpoint(
+    Checkpoint &checkpoint, std::string const &name) const {
+  checkpoint.write(name + ".step", _step);
+  checkpoint.write(name + ".draws", _draws);
+}
+
+void RandomStream::restore(Checkpoint::Reader &reader, std::string const &name) {
+  reader.read(name + ".step", _step);
+  reader.read(name + ".draws", _draws);
+}
+
+Real RandomStream::rand() {
+  auto const block = _next();
+  return uniform(block[0], block[1]);
+}
+
+Real RandomStream::gaussian() {
+  // Box-Muller transform
+  auto const block = _next();
+  auto const u = uniform(block[0], block[1]);
+  auto const v = uniform(block[2], block[3]);
+  return std::sqrt(-2.0 * std::log(u)) * std::cos(6.283185307179586 * v);
+}
+} // namespace psim
@@ -0,0 +1,282 @@
+//
+// MIT License
+//
+// Copyright (c) 2020 Pathfinder for Autonomous Navigation (PAN)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/** @file psim/core/recorder.cpp
+ *  @author Kyle Krol
+ */
+
+#include <psim/core/recorder.hpp>
+
+#include <stdexcept>
+
+namespace psim {
+
+/** @brief Appends a sample to a column.
+ *
+ *  A full buffer that's also held outside the recorder is left as is and the
+ *  column moves to a new buffer with twice the capacity.
+ */
+template <typename T>
+static void push(std::shared_ptr<std::vector<T>> &column, T value) {
+  if (column->size() == column->capacity() && column.use_count() > 1) {
+    auto buffer = std::make_shared<std::vector<T>>();
+    buffer->reserve(2 * column->capacity() + 1);
+    buffer->assign(column->begin(), column->end());
+    column = std::move(buffer);
+  }
+  column->push_back(value);
+}
+
+/** @brief Empties a column without touching a buffer held outside the
+ *         recorder.
+ */
+template <typename T>
+static void clear(std::shared_ptr<std::vector<T>> &column) {
+  if (column.use_count() > 1) {
+    auto buffer = std::make_shared<std::vector<T>>();
+    buffer->reserve(column->capacity());
+    column = std::move(buffer);
+  } else {
+    column->clear();
+  }
+}
+
+void Recorder::_add_column(std::string const &name, bool is_integer) {
+  if (_locations.count(name))
+    throw std::runtime_error("Duplicate recorder column: " + name);
+
+  if (is_integer) {
+    _locations[name] = {true, _integers.size()};
+    _integers.push_back(std::make_shared<std::vector<Integer>>());
+  } else {
+    _locations[name] = {false, _reals.size()};
+    _reals.push_back(std::make_shared<std::vector<Real>>());
+  }
+  _columns.push_back(name);
+}
+
+Recorder::Recorder(State const &state, std::vector<std::string> const &fields,
+    std::size_t decimation, std::size_t capacity)
+  : _decimation(decimation), _n(0), _size(0) {
+  static char const *const suffixes[] = {".x", ".y", ".z", ".w"};
+
+  if (_decimation == 0)
+    throw std::runtime_error("Recorder decimation must be greater than zero");
+
+  for (auto const &name : fields) {
+    auto const *field = state.get(name);
+    if (!field)
+      throw std::runtime_error("Recorder field not found with name: " + name);
+
+    std::size_t components;
+    switch (field->tag()) {
+    case TypeTag::Integer:
+      _entries.push_back({field, TypeTag::Integer, _integers.size()});
+      _add_column(name, true);
+      continue;
+
+    case TypeTag::Boolean:
+    case TypeTag::Real:
+      components = 0;
+      break;
+
+    case TypeTag::Vector2:
+      components = 2;
+      break;
+
+    case TypeTag::Vector3:
+      components = 3;
+      break;
+
+    case TypeTag::Vector4:
+      components = 4;
+      break;
+
+    default:
+      throw std::runtime_error("Recorder field holds an unsupported type: " +
+                               field->name() + ":" + field->type());
+    }
+
+    _entries.push_back({field, field->tag(), _reals.size()});
+    if (components == 0)
+      _add_column(name, false);
+    for (std::size_t i = 0; i < components; i++)
+      _add_column(name + suffixes[i], false);
+  }
+
+  for (auto &column : _reals)
+    column->reserve(capacity);
+  for (auto &column : _integers)
+    column->reserve(capacity);
+}
+
+void Recorder::step() {
+  if (++_n < _decimation)
+    return;
+
+  _n = 0;
+  record();
+}
+
+void Recorder::_record(Entry const &entry, StateFieldBase const *field) {
+  auto const i = entry.column;
+
+  switch (entry.tag) {
+  case TypeTag::Boolean:
+    push(_reals[i], field->get<Boolean>() ? 1.0 : 0.0);
+    break;
+
+  case TypeTag::Integer:
+    push(_integers[i], field->get<Integer>());
+    break;
+
+  case TypeTag::Real:
+    push(_reals[i], field->get<Real>());
+    break;
+
+  case TypeTag::Vector2: {
+    auto const &v = field->get<Vector2>();
+    for (lin::size_t j = 0; j < 2; j++)
+      push(_reals[i + j], v(j));
+    break;
+  }
+
+  case TypeTag::Vector3: {
+    auto const &v = field->get<Vector3>();
+    for (lin::size_t j = 0; j < 3; j++)
+      push(_reals[i + j], v(j));
+    break;
+  }
+
+  case TypeTag::Vector4: {
+    auto const &v = field->get<Vector4>();
+    for (lin::size_t j = 0; j < 4; j++)
+      push(_reals[i + j], v(j));
+    break;
+  }
+
+  default:
+    break;
+  }
+}
+
+void Recorder::record() {
+  for (auto const &entry : _entries)
+    _record(entry, entry.field);
+  _size++;
+}
+
+void Recorder::record(State const &state) {
+  // Look up every field before recording anything so a failure doesn't leave
+  // the columns with mismatched lengths
+  std::vector<StateFieldBase const *> fields;
+  fields.reserve(_entries.size());
+  for (auto const &entry : _entries) {
+    auto const &name = entry.field->name();
+    auto const *field = state.get(name);
+    if (!field)
+      throw std::runtime_error("Recorder field not found with name: " + name);
+    if (field->tag() != entry.tag)
+      throw std::runtime_error("Recorder field type mismatch: " + name + ":" +
+                               field->type());
+
+    fields.push_back(field);
+  }
+
+  for (std::size_t i = 0; i < _entries.size(); i++)
+    _record(_entries[i], fields[i]);
+  _size++;
+}
+
+void Recorder::clear() {
+  for (auto &column : _reals)
+    psim::clear(column);
+  for (auto &column : _integers)
+    psim::clear(column);
+  _n = 0;
+  _size = 0;
+}
+
+std::size_t Recorder::size() const {
+  return _size;
+}
+
+std::size_t Recorder::decimation() const {
+  return _decimation;
+}
+
+std::vector<std::string> const &Recorder::columns() const {
+  return _columns;
+}
+
+bool Recorder::has(std::string const &name) const {
+  return _locations.count(name);
+}
+
+bool Recorder::is_integer(std::string const &name) const {
+  auto const iter = _locations.find(name);
+  if (iter == _locations.end())
+    throw std::runtime_error("Recorder column not found with name: " + name);
+
+  return iter->second.is_integer;
+}
+
+Real const *Recorder::reals(std::string const &name) const {
+  auto const iter = _locations.find(name);
+  if (iter == _locations.end() || iter->second.is_integer)
+    throw std::runtime_error(
+        "Real valued recorder column not found with name: " + name);
+
+  return _reals[iter->second.column]->data();
+}
+
+Integer const *Recorder::integers(std::string const &name) const {
+  auto const iter = _locations.find(name);
+  if (iter == _locations.end() || !iter->second.is_integer)
+    throw std::runtime_error(
+        "Integer valued recorder column not found with name: " + name);
+
+  return _integers[iter->second.column]->data();
+}
+
+std::shared_ptr<std::vector<Real> const> Recorder::real_buffer(
+    std::string const &name) const {
+  auto const iter = _locations.find(name);
+  if (iter == _locations.end() || iter->second.is_integer)
+    throw std::runtime_error(
+        "Real valued recorder column not found with name: " + name);
+
+  return _reals[iter->second.column];
+}
+
+std::shared_ptr<std::vector<Integer> const> Recorder::integer_buffer(
+    std::string const &name) const {
+  auto const iter = _locations.find(name);
+  if (iter == _locations.end() || !iter->second.is_integer)
+    throw std::runtime_error(
+        "Integer valued recorder column not found with name: " + name);
+
+  return _integers[iter->second.column];
+}
+} // namespace psim
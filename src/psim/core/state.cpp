@@ -28,7 +28,9 @@
 
 #include <psim/core/state.hpp>
 
+#include <algorithm>
 #include <stdexcept>
+#include <string>
 
 namespace psim {
 
@@ -40,7 +42,14 @@ bool State::has_writable(std::string const &name) const {
   return _writable_fields.count(name);
 }
 
+void State::_check_not_frozen(StateFieldBase const *field) const {
+  if (_frozen)
+    throw std::runtime_error("State is frozen. Cannot add '" + field->name() +
+                             ":" + field->type() + "'");
+}
+
 void State::add_writable(StateFieldWritableBase *field) {
+  _check_not_frozen(field);
   {
     // Check if we have a name collision with existing readable fields
     auto const iter = _readable_fields.find(field->name());
@@ -65,10 +74,17 @@ void State::add_writable(StateFieldWritableBase *field) {
   }
 
   // Add the field
+  for (auto *trace : _traces)
+    trace->adds.push_back(field);
+
   _writable_fields[field->name()] = field;
+  _indices[field->name()] = _fields.size();
+  _fields.push_back(field);
+  _fields_writable.push_back(field);
 }
 
 void State::add(StateFieldBase const *field) {
+  _check_not_frozen(field);
   {
     // Check if we have a name collision with existing readable fields
     auto const iter = _readable_fields.find(field->name());
@@ -93,27 +109,66 @@ void State::add(StateFieldBase const *field) {
   }
 
   // Add the field
+  for (auto *trace : _traces)
+    trace->adds.push_back(field);
+
   _readable_fields[field->name()] = field;
+  _indices[field->name()] = _fields.size();
+  _fields.push_back(field);
+  _fields_writable.push_back(nullptr);
+}
+
+void State::remove(StateFieldBase const *field) {
+  if (_frozen)
+    throw std::runtime_error("State is frozen. Cannot remove '" +
+                             field->name() + ":" + field->type() + "'");
+
+  auto const iter = _indices.find(field->name());
+  if (iter == _indices.end() || _fields[iter->second] != field)
+    throw std::runtime_error("'" + field->name() + ":" + field->type() +
+                             "' isn't registered with the state");
+
+  auto const i = iter->second;
+  _indices.erase(iter);
+  _readable_fields.erase(field->name());
+  _writable_fields.erase(field->name());
+  _fields.erase(_fields.begin() + i);
+  _fields_writable.erase(_fields_writable.begin() + i);
+
+  for (auto &index : _indices)
+    if (index.second > i)
+      index.second--;
 }
 
 StateFieldWritableBase *State::get_writable(std::string const &name) {
   auto const iter = _writable_fields.find(name);
-  return (iter != _writable_fields.end() ? iter->second : nullptr);
+  if (iter == _writable_fields.end())
+    return nullptr;
+
+  for (auto *trace : _traces)
+    trace->writes.push_back(iter->second);
+
+  return iter->second;
 }
 
 StateFieldBase const *State::get(std::string const &name) const {
+  StateFieldBase const *field_ptr = nullptr;
   {
     auto const iter = _readable_fields.find(name);
     if (iter != _readable_fields.end())
-      return iter->second;
+      field_ptr = iter->second;
   }
-  {
+  if (!field_ptr) {
     auto const iter = _writable_fields.find(name);
     if (iter != _writable_fields.end())
-      return iter->second;
+      field_ptr = iter->second;
   }
 
-  return nullptr;
+  if (field_ptr)
+    for (auto *trace : _traces)
+      trace->reads.push_back(field_ptr);
+
+  return field_ptr;
 }
 
 StateFieldBase const &State::operator[](std::string const &name) const {
@@ -123,4 +178,56 @@ StateFieldBase const &State::operator[](std::string const &name) const {
 
   return *field_ptr;
 }
+
+void State::freeze() {
+  _fields.shrink_to_fit();
+  _fields_writable.shrink_to_fit();
+  _frozen = true;
+}
+
+bool State::is_frozen() const {
+  return _frozen;
+}
+
+std::size_t State::size() const {
+  return _fields.size();
+}
+
+std::size_t State::index(std::string const &name) const {
+  if (!_frozen)
+    throw std::runtime_error(
+        "State must be frozen before retrieving the index of: " + name);
+
+  auto const iter = _indices.find(name);
+  if (iter == _indices.end())
+    throw std::runtime_error("State field not found with name: " + name);
+
+  return iter->second;
+}
+
+StateFieldBase const &State::at(std::size_t i) const {
+  if (i >= _fields.size())
+    throw std::runtime_error(
+        "State field index out of bounds: " + std::to_string(i));
+
+  return *_fields[i];
+}
+
+StateFieldWritableBase *State::at_writable(std::size_t i) {
+  if (i >= _fields_writable.size())
+    throw std::runtime_error(
+        "State field index out of bounds: " + std::to_string(i));
+
+  return _fields_writable[i];
+}
+
+State::Trace::Trace(State &state) : _state(state) {
+  _state._traces.push_back(this);
+}
+
+State::Trace::~Trace() {
+  _state._traces.erase(
+      std::remove(_state._traces.begin(), _state._traces.end(), this),
+      _state._traces.end());
+}
 } // namespace psim
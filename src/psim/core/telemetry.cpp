@@ -0,0 +1,468 @@
+//
+// MIT License
+//
+// Copyright (c) 2020 Pathfinder for Autonomous Navigation (PAN)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/** @file psim/core/telemetry.cpp
+ *  @author Kyle Krol
+ */
+
+#include <psim/core/telemetry.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <stdexcept>
+
+namespace psim {
+
+/** @brief Magic string every telemetry file starts with.
+ */
+static constexpr char magic[8] = {'P', 'S', 'I', 'M', 'T', 'L', 'O', 'G'};
+
+/** @brief Magic string every closed telemetry file ends with.
+ */
+static constexpr char index_magic[8] = {'P', 'S', 'I', 'M', 'T', 'I', 'D', 'X'};
+
+constexpr std::uint32_t TelemetryWriter::version;
+
+void TelemetryWriter::_write(void const *data, std::size_t size) {
+  _ofs.write(static_cast<char const *>(data), size);
+  if (!_ofs)
+    throw std::runtime_error("Failed to write telemetry file: " + _file);
+
+  _offset += size;
+}
+
+TelemetryWriter::TelemetryWriter(State const &state, std::string const &file,
+    std::vector<std::string> const &fields, std::size_t decimation,
+    std::size_t chunk)
+  : _file(file), _decimation(decimation), _n(0), _capacity(chunk), _rows(0),
+    _size(0), _offset(0), _closed(false) {
+  static char const *const suffixes[] = {".x", ".y", ".z", ".w"};
+
+  if (_decimation == 0)
+    throw std::runtime_error("Telemetry decimation must be greater than zero");
+  if (_capacity == 0)
+    throw std::runtime_error("Telemetry chunk size must be greater than zero");
+
+  auto const add_column = [this](std::string const &name, bool is_integer) {
+    for (auto const &column : _columns)
+      if (column == name)
+        throw std::runtime_error("Duplicate telemetry column: " + name);
+
+    _columns.push_back(name);
+    _integers.push_back(is_integer);
+  };
+
+  for (auto const &name : fields) {
+    auto const *field = state.get(name);
+    if (!field)
+      throw std::runtime_error("Telemetry field not found with name: " + name);
+
+    std::size_t components;
+    switch (field->tag()) {
+    case TypeTag::Integer:
+      _entries.push_back({field, TypeTag::Integer, _columns.size()});
+      add_column(name, true);
+      continue;
+
+    case TypeTag::Boolean:
+    case TypeTag::Real:
+      components = 0;
+      break;
+
+    case TypeTag::Vector2:
+      components = 2;
+      break;
+
+    case TypeTag::Vector3:
+      components = 3;
+      break;
+
+    case TypeTag::Vector4:
+      components = 4;
+      break;
+
+    default:
+      throw std::runtime_error("Telemetry field holds an unsupported type: " +
+                               field->name() + ":" + field->type());
+    }
+
+    _entries.push_back({field, field->tag(), _columns.size()});
+    if (components == 0)
+      add_column(name, false);
+    for (std::size_t i = 0; i < components; i++)
+      add_column(name + suffixes[i], false);
+  }
+
+  _chunk.resize(_columns.size() * _capacity);
+
+  _ofs.open(_file, std::ios::binary | std::ios::trunc);
+  if (!_ofs.is_open())
+    throw std::runtime_error("Failed to open telemetry file: " + _file);
+
+  auto const columns = static_cast<std::uint32_t>(_columns.size());
+  auto const capacity = static_cast<std::uint64_t>(_capacity);
+  _write(magic, sizeof(magic));
+  _write(&version, sizeof(version));
+  _write(&columns, sizeof(columns));
+  _write(&capacity, sizeof(capacity));
+  for (std::size_t i = 0; i < _columns.size(); i++) {
+    auto const is_integer = static_cast<std::uint8_t>(_integers[i]);
+    auto const length = static_cast<std::uint32_t>(_columns[i].size());
+    _write(&is_integer, sizeof(is_integer));
+    _write(&length, sizeof(length));
+    _write(_columns[i].data(), _columns[i].size());
+  }
+
+  // Keeps the samples of every chunk aligned when the file is mapped
+  char const padding[8] = {0};
+  _write(padding, (8 - _offset % 8) % 8);
+  _ofs.flush();
+}
+
+TelemetryWriter::~TelemetryWriter() {
+  try {
+    close();
+  } catch (std::exception const &) {
+    // Errors can't be reported from a destructor
+  }
+}
+
+void TelemetryWriter::step() {
+  if (++_n < _decimation)
+    return;
+
+  _n = 0;
+  record();
+}
+
+void TelemetryWriter::_sample(Value *v, std::size_t stride) const {
+  for (auto const &entry : _entries) {
+    auto *const w = v + entry.column * stride;
+
+    switch (entry.tag) {
+    case TypeTag::Boolean:
+      w->real = entry.field->get<Boolean>() ? 1.0 : 0.0;
+      break;
+
+    case TypeTag::Integer:
+      w->integer = entry.field->get<Integer>();
+      break;
+
+    case TypeTag::Real:
+      w->real = entry.field->get<Real>();
+      break;
+
+    case TypeTag::Vector2: {
+      auto const &x = entry.field->get<Vector2>();
+      for (lin::size_t j = 0; j < 2; j++)
+        w[j * stride].real = x(j);
+      break;
+    }
+
+    case TypeTag::Vector3: {
+      auto const &x = entry.field->get<Vector3>();
+      for (lin::size_t j = 0; j < 3; j++)
+        w[j * stride].real = x(j);
+      break;
+    }
+
+    case TypeTag::Vector4: {
+      auto const &x = entry.field->get<Vector4>();
+      for (lin::size_t j = 0; j < 4; j++)
+        w[j * stride].real = x(j);
+      break;
+    }
+
+    default:
+      break;
+    }
+  }
+}
+
+void TelemetryWriter::_advance() {
+  _size++;
+  if (++_rows == _capacity)
+    flush();
+}
+
+void TelemetryWriter::record() {
+  if (_closed)
+    throw std::runtime_error("Telemetry file already closed: " + _file);
+
+  _sample(_chunk.data() + _rows, _capacity);
+  _advance();
+}
+
+void TelemetryWriter::sample(Value *row) const {
+  _sample(row, 1);
+}
+
+void TelemetryWriter::append(Value const *row) {
+  if (_closed)
+    throw std::runtime_error("Telemetry file already closed: " + _file);
+
+  for (std::size_t i = 0; i < _columns.size(); i++)
+    _chunk[i * _capacity + _rows] = row[i];
+  _advance();
+}
+
+void TelemetryWriter::flush() {
+  if (_closed || _rows == 0)
+    return;
+
+  Chunk const chunk = {_offset, static_cast<std::uint64_t>(_rows)};
+  _write(&chunk.size, sizeof(chunk.size));
+  for (std::size_t i = 0; i < _columns.size(); i++)
+    _write(_chunk.data() + i * _capacity, _rows * sizeof(Value));
+
+  // Hands the chunk to the OS so it survives the process being interrupted
+  _ofs.flush();
+  if (!_ofs)
+    throw std::runtime_error("Failed to write telemetry file: " + _file);
+
+  _index.push_back(chunk);
+  _rows = 0;
+}
+
+void TelemetryWriter::close() {
+  if (_closed)
+    return;
+
+  flush();
+  _closed = true;
+
+  auto const chunks = static_cast<std::uint64_t>(_index.size());
+  _write(_index.data(), _index.size() * sizeof(Chunk));
+  _write(&chunks, sizeof(chunks));
+  _write(index_magic, sizeof(index_magic));
+
+  _ofs.close();
+  if (!_ofs)
+    throw std::runtime_error("Failed to close telemetry file: " + _file);
+}
+
+std::size_t TelemetryWriter::size() const {
+  return _size;
+}
+
+std::vector<std::string> const &TelemetryWriter::columns() const {
+  return _columns;
+}
+
+std::string const &TelemetryWriter::file() const {
+  return _file;
+}
+
+TelemetryReader::TelemetryReader(std::string const &file)
+  : _data(nullptr), _bytes(0), _size(0) {
+  auto const fd = ::open(file.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw std::runtime_error("Failed to open telemetry file: " + file);
+
+  struct stat st;
+  if (::fstat(fd, &st) != 0 || st.st_size == 0) {
+    ::close(fd);
+    throw std::runtime_error("Not a telemetry file: " + file);
+  }
+
+  _bytes = static_cast<std::size_t>(st.st_size);
+  auto *const data = ::mmap(nullptr, _bytes, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED)
+    throw std::runtime_error("Failed to map telemetry file: " + file);
+
+  _data = static_cast<unsigned char const *>(data);
+
+  // The mapping is released by the destructor which won't run if the
+  // constructor throws
+  try {
+    std::size_t offset = 0;
+    auto const take = [&](void *dst, std::size_t n) {
+      if (_bytes - offset < n)
+        throw std::runtime_error("Truncated telemetry file: " + file);
+
+      std::memcpy(dst, _data + offset, n);
+      offset += n;
+    };
+
+    char header[sizeof(magic)];
+    std::uint32_t file_version, columns;
+    std::uint64_t capacity;
+    take(header, sizeof(header));
+    if (std::memcmp(header, magic, sizeof(magic)) != 0)
+      throw std::runtime_error("Not a telemetry file: " + file);
+    take(&file_version, sizeof(file_version));
+    if (file_version != TelemetryWriter::version)
+      throw std::runtime_error("Unsupported telemetry version " +
+                               std::to_string(file_version) + " in " + file);
+    take(&columns, sizeof(columns));
+    take(&capacity, sizeof(capacity));
+
+    for (std::uint32_t i = 0; i < columns; i++) {
+      std::uint8_t is_integer;
+      std::uint32_t length;
+      take(&is_integer, sizeof(is_integer));
+      take(&length, sizeof(length));
+      if (_bytes - offset < length)
+        throw std::runtime_error("Truncated telemetry file: " + file);
+
+      _columns.emplace_back(
+          reinterpret_cast<char const *>(_data + offset), length);
+      _locations[_columns.back()] = {i, is_integer != 0};
+      offset += length;
+    }
+    offset += (8 - offset % 8) % 8;
+
+    auto const row = std::uint64_t(columns) * sizeof(std::uint64_t);
+    auto const trailer = sizeof(std::uint64_t) + sizeof(index_magic);
+
+    // Use the chunk index if the file was closed
+    if (_bytes >= offset + trailer &&
+        std::memcmp(_data + _bytes - sizeof(index_magic), index_magic,
+            sizeof(index_magic)) == 0) {
+      std::uint64_t chunks;
+      std::memcpy(&chunks, _data + _bytes - trailer, sizeof(chunks));
+      if (chunks > (_bytes - offset - trailer) / sizeof(Chunk))
+        throw std::runtime_error("Corrupt telemetry index: " + file);
+
+      _chunks.resize(chunks);
+      std::memcpy(_chunks.data(),
+          _data + _bytes - trailer - chunks * sizeof(Chunk),
+          chunks * sizeof(Chunk));
+      for (auto const &chunk : _chunks)
+        if (chunk.offset < offset || chunk.size > capacity ||
+            chunk.offset + sizeof(std::uint64_t) + chunk.size * row > _bytes)
+          throw std::runtime_error("Corrupt telemetry index: " + file);
+    }
+    // Otherwise walk the chunks stopping at the first incomplete one
+    else {
+      while (_bytes - offset >= sizeof(std::uint64_t)) {
+        Chunk chunk = {offset, 0};
+        std::memcpy(&chunk.size, _data + offset, sizeof(chunk.size));
+        if (chunk.size == 0 || chunk.size > capacity ||
+            (row && (_bytes - offset - sizeof(std::uint64_t)) / row <
+                        chunk.size))
+          break;
+
+        _chunks.push_back(chunk);
+        offset += sizeof(std::uint64_t) + chunk.size * row;
+      }
+    }
+
+    for (auto const &chunk : _chunks)
+      _size += chunk.size;
+  } catch (...) {
+    ::munmap(const_cast<unsigned char *>(_data), _bytes);
+    throw;
+  }
+}
+
+TelemetryReader::~TelemetryReader() {
+  ::munmap(const_cast<unsigned char *>(_data), _bytes);
+}
+
+TelemetryReader::Column const &TelemetryReader::_column(
+    std::string const &name) const {
+  auto const it = _locations.find(name);
+  if (it == _locations.end())
+    throw std::runtime_error("Telemetry column not found with name: " + name);
+
+  return it->second;
+}
+
+void const *TelemetryReader::_samples(
+    Column const &column, std::size_t chunk) const {
+  if (chunk >= _chunks.size())
+    throw std::runtime_error("Telemetry chunk index out of bounds: " +
+                             std::to_string(chunk));
+
+  auto const &c = _chunks[chunk];
+  return _data + c.offset + sizeof(std::uint64_t) +
+         column.index * c.size * sizeof(std::uint64_t);
+}
+
+std::size_t TelemetryReader::size() const {
+  return _size;
+}
+
+std::vector<std::string> const &TelemetryReader::columns() const {
+  return _columns;
+}
+
+bool TelemetryReader::has(std::string const &name) const {
+  return _locations.count(name) != 0;
+}
+
+bool TelemetryReader::is_integer(std::string const &name) const {
+  return _column(name).is_integer;
+}
+
+std::size_t TelemetryReader::chunks() const {
+  return _chunks.size();
+}
+
+std::size_t TelemetryReader::chunk_size(std::size_t chunk) const {
+  if (chunk >= _chunks.size())
+    throw std::runtime_error("Telemetry chunk index out of bounds: " +
+                             std::to_string(chunk));
+
+  return _chunks[chunk].size;
+}
+
+Real const *TelemetryReader::reals(
+    std::string const &name, std::size_t chunk) const {
+  auto const &column = _column(name);
+  if (column.is_integer)
+    throw std::runtime_error("Telemetry column holds integers: " + name);
+
+  return static_cast<Real const *>(_samples(column, chunk));
+}
+
+Integer const *TelemetryReader::integers(
+    std::string const &name, std::size_t chunk) const {
+  auto const &column = _column(name);
+  if (!column.is_integer)
+    throw std::runtime_error("Telemetry column holds reals: " + name);
+
+  return static_cast<Integer const *>(_samples(column, chunk));
+}
+
+void TelemetryReader::read(std::string const &name, Real *values) const {
+  for (std::size_t i = 0; i < _chunks.size(); i++) {
+    std::memcpy(values, reals(name, i), _chunks[i].size * sizeof(Real));
+    values += _chunks[i].size;
+  }
+}
+
+void TelemetryReader::read(std::string const &name, Integer *values) const {
+  for (std::size_t i = 0; i < _chunks.size(); i++) {
+    std::memcpy(values, integers(name, i), _chunks[i].size * sizeof(Integer));
+    values += _chunks[i].size;
+  }
+}
+} // namespace psim
@@ -0,0 +1,144 @@
+//
+// MIT License
+//
+// Copyright (c) 2020 Pathfinder for Autonomous Navigation (PAN)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/** @file psim/core/thread_pool.cpp
+ *  @author Kyle Krol
+ */
+
+#include <psim/core/thread_pool.hpp>
+
+namespace psim {
+
+/** @brief Number of times an idle worker looks for a task before sleeping.
+ */
+static constexpr std::size_t spins = 1024;
+
+thread_local ThreadPool const *ThreadPool::_current = nullptr;
+
+thread_local std::size_t ThreadPool::_current_index = 0;
+
+ThreadPool::ThreadPool(std::size_t workers)
+  : _queued(0), _sleeping(0), _stop(false) {
+  _queues.reserve(workers + 1);
+  for (std::size_t i = 0; i < workers + 1; i++)
+    _queues.push_back(std::make_unique<Queue>());
+
+  _workers.reserve(workers);
+  for (std::size_t i = 0; i < workers; i++)
+    _workers.emplace_back(&ThreadPool::_work, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stop = true;
+  }
+  _condition.notify_all();
+
+  for (auto &worker : _workers)
+    worker.join();
+}
+
+std::size_t ThreadPool::size() const {
+  return _workers.size();
+}
+
+bool ThreadPool::_take(std::size_t i, bool back, Task &task) {
+  auto &queue = *_queues[i];
+  std::lock_guard<std::mutex> lock(queue.mutex);
+  if (queue.tasks.empty())
+    return false;
+
+  if (back) {
+    task = queue.tasks.back();
+    queue.tasks.pop_back();
+  } else {
+    task = queue.tasks.front();
+    queue.tasks.pop_front();
+  }
+  _queued--;
+  return true;
+}
+
+bool ThreadPool::_find(std::size_t i, Task &task) {
+  if (_queued == 0)
+    return false;
+  if (_take(i, true, task))
+    return true;
+
+  for (std::size_t j = 1; j < _queues.size(); j++)
+    if (_take((i + j) % _queues.size(), false, task))
+      return true;
+
+  return false;
+}
+
+void ThreadPool::_work(std::size_t i) {
+  _current = this;
+  _current_index = i;
+
+  std::size_t idle = 0;
+  while (!_stop) {
+    Task task;
+    if (_find(i, task)) {
+      task.function(task.data);
+      idle = 0;
+    } else if (++idle < spins) {
+      std::this_thread::yield();
+    } else {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _sleeping++;
+      _condition.wait(lock, [this]() { return _stop || _queued > 0; });
+      _sleeping--;
+      idle = 0;
+    }
+  }
+}
+
+void ThreadPool::submit(Task task) {
+  auto const i = (_current == this ? _current_index : _workers.size());
+  {
+    auto &queue = *_queues[i];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(task);
+    _queued++;
+  }
+
+  if (_sleeping > 0) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _condition.notify_one();
+  }
+}
+
+bool ThreadPool::help() {
+  auto const i = (_current == this ? _current_index : _workers.size());
+
+  Task task;
+  if (!_find(i, task))
+    return false;
+
+  task.function(task.data);
+  return true;
+}
+} // namespace psim
@@ -87,6 +87,20 @@ void AttitudeEstimator::step() {
   _set_attitude_outputs();
 }
 
+void AttitudeEstimator::checkpoint(Checkpoint &checkpoint) const {
+  this->Super::checkpoint(checkpoint);
+  checkpoint.write("AttitudeEstimator._attitude_state", _attitude_state);
+  checkpoint.write("AttitudeEstimator._attitude_data", _attitude_data);
+  checkpoint.write("AttitudeEstimator._attitude_estimate", _attitude_estimate);
+}
+
+void AttitudeEstimator::restore(Checkpoint::Reader &reader) {
+  this->Super::restore(reader);
+  reader.read("AttitudeEstimator._attitude_state", _attitude_state);
+  reader.read("AttitudeEstimator._attitude_data", _attitude_data);
+  reader.read("AttitudeEstimator._attitude_estimate", _attitude_estimate);
+}
+
 Vector4 AttitudeEstimator::fc_satellite_attitude_q_body_eci_error() const {
   auto const &truth_q_eci_body = truth_satellite_attitude_q_eci_body->get();
   auto const &q_body_eci = Super::fc_satellite_attitude_q_body_eci.get();
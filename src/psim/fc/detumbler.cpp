@@ -53,4 +53,14 @@ void Detumbler::step() {
     m_body = lin::zeros<Vector3>();
   }
 }
+
+void Detumbler::checkpoint(Checkpoint &checkpoint) const {
+  this->Super::checkpoint(checkpoint);
+  checkpoint.write("Detumbler._detumbler", _detumbler);
+}
+
+void Detumbler::restore(Checkpoint::Reader &reader) {
+  this->Super::restore(reader);
+  reader.read("Detumbler._detumbler", _detumbler);
+}
 } // namespace psim
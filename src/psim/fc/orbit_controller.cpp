@@ -117,7 +117,7 @@ void OrbitController::step() {
 
     if (lin::all(lin::isfinite(actuation.J_ecef))) {
       //get random noise
-      Vector3 random_noise = lin::gaussians<Vector3>(_randoms);
+      Vector3 random_noise = fc_satellite_thruster_noise.gaussians<Vector3>();
 
       // apply radius scaling
       random_noise = random_noise * thruster_noise_sigma;
@@ -131,4 +131,20 @@ void OrbitController::step() {
     }
   }
 }
+
+void OrbitController::checkpoint(Checkpoint &checkpoint) const {
+  this->Super::checkpoint(checkpoint);
+  checkpoint.write("OrbitController._orbit_controller", _orbit_controller);
+  checkpoint.write("OrbitController.last_firing", last_firing);
+  checkpoint.write("OrbitController.prev_dr_ecef", prev_dr_ecef);
+  checkpoint.write("OrbitController.prev_dv_ecef", prev_dv_ecef);
+}
+
+void OrbitController::restore(Checkpoint::Reader &reader) {
+  this->Super::restore(reader);
+  reader.read("OrbitController._orbit_controller", _orbit_controller);
+  reader.read("OrbitController.last_firing", last_firing);
+  reader.read("OrbitController.prev_dr_ecef", prev_dr_ecef);
+  reader.read("OrbitController.prev_dv_ecef", prev_dv_ecef);
+}
 } // namespace psim
\ No newline at end of file
@@ -58,7 +58,7 @@ void OrbOrbitEstimator::step() {
   constexpr auto sqrtR = lin::diag(lin::consts<Vector<6>>(5.0)).eval();
 
   auto const &t = truth_t_s->get();
-  auto const &dt = truth_dt_ns->get();
+  auto const dt = truth_dt_ns->get() * Integer(ticks());
   auto const &r = sensors_satellite_gps_r->get();
   auto const &v = sensors_satellite_gps_v->get();
 
@@ -80,6 +80,16 @@ void OrbOrbitEstimator::step() {
   _set_orbit_outputs();
 }
 
+void OrbOrbitEstimator::checkpoint(Checkpoint &checkpoint) const {
+  this->Super::checkpoint(checkpoint);
+  checkpoint.write("OrbOrbitEstimator.estimate", estimate);
+}
+
+void OrbOrbitEstimator::restore(Checkpoint::Reader &reader) {
+  this->Super::restore(reader);
+  reader.read("OrbOrbitEstimator.estimate", estimate);
+}
+
 Vector3 OrbOrbitEstimator::fc_satellite_orbit_r_error() const {
   auto const &r = Super::fc_satellite_orbit_r.get();
   auto const &truth_r = truth_satellite_orbit_r_ecef->get();
@@ -68,7 +68,7 @@ void RelativeOrbitEstimator::step() {
   static constexpr auto sqrtR =
       lin::diag(lin::consts<Vector<3>>(1.0e-2)).eval();
 
-  auto const &dt = truth_dt_ns->get();
+  auto const dt = truth_dt_ns->get() * Integer(ticks());
   auto const &w_earth = truth_earth_w->get();
   auto const &r_ecef = fc_satellite_orbit_r->get();
   auto const &v_ecef = fc_satellite_orbit_v->get();
@@ -117,6 +117,21 @@ void RelativeOrbitEstimator::step() {
   _set_relative_orbit_outputs();
 }
 
+void RelativeOrbitEstimator::checkpoint(Checkpoint &checkpoint) const {
+  this->Super::checkpoint(checkpoint);
+  checkpoint.write("RelativeOrbitEstimator.previous_dr", previous_dr);
+  checkpoint.write("RelativeOrbitEstimator.estimate", estimate);
+  checkpoint.write(
+      "RelativeOrbitEstimator.cycles_without_rtk", cycles_without_rtk);
+}
+
+void RelativeOrbitEstimator::restore(Checkpoint::Reader &reader) {
+  this->Super::restore(reader);
+  reader.read("RelativeOrbitEstimator.previous_dr", previous_dr);
+  reader.read("RelativeOrbitEstimator.estimate", estimate);
+  reader.read("RelativeOrbitEstimator.cycles_without_rtk", cycles_without_rtk);
+}
+
 Vector3 RelativeOrbitEstimator::fc_satellite_relative_orbit_dr_error() const {
   auto const &fc_dr = fc_satellite_relative_orbit_dr.get();
   auto const &truth_r_ecef = truth_satellite_orbit_r_ecef->get();
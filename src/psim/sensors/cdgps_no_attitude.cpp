@@ -75,7 +75,8 @@ Vector3 CdgpsNoAttitude::sensors_satellite_cdgps_dr_error() const {
   auto const &sigma = sensors_satellite_cdgps_dr_sigma.get();
 
   if (valid)
-    return lin::multiply(sigma, lin::gaussians<Vector3>(_randoms));
+    return lin::multiply(
+        sigma, sensors_satellite_cdgps_dr_noise.gaussians<Vector3>());
   else
     return lin::nans<Vector3>();
 }
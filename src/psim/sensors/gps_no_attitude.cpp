@@ -51,7 +51,8 @@ Vector3 GpsNoAttitude::sensors_satellite_gps_r_error() const {
   auto const &sigma = sensors_satellite_gps_r_sigma.get();
 
   if (valid)
-    return lin::multiply(sigma, lin::gaussians<Vector3>(_randoms));
+    return lin::multiply(
+        sigma, sensors_satellite_gps_r_noise.gaussians<Vector3>());
   else
     return lin::nans<Vector3>();
 }
@@ -68,7 +69,8 @@ Vector3 GpsNoAttitude::sensors_satellite_gps_v_error() const {
   auto const &sigma = sensors_satellite_gps_v_sigma.get();
 
   if (valid)
-    return lin::multiply(sigma, lin::gaussians<Vector3>(_randoms));
+    return lin::multiply(
+        sigma, sensors_satellite_gps_v_noise.gaussians<Vector3>());
   else
     return lin::nans<Vector3>();
 }
@@ -37,12 +37,14 @@ void Gyroscope::step() {
   this->Super::step();
 
   auto const &bias_sigma = sensors_satellite_gyroscope_w_bias_sigma.get();
-  auto const &dt = truth_dt_s->get();
+  auto const dt = truth_dt_s->get() * Real(ticks());
 
   auto &bias = sensors_satellite_gyroscope_w_bias.get();
 
-  bias =
-      bias + dt * lin::multiply(bias_sigma, lin::gaussians<Vector3>(_randoms));
+  auto const noise =
+      sensors_satellite_gyroscope_w_bias_noise.gaussians<Vector3>();
+
+  bias = bias + dt * lin::multiply(bias_sigma, noise);
 }
 
 Boolean Gyroscope::sensors_satellite_gyroscope_valid() const {
@@ -64,7 +66,8 @@ Vector3 Gyroscope::sensors_satellite_gyroscope_w_error() const {
   auto const &sigma = sensors_satellite_gyroscope_w_sigma.get();
 
   if (valid)
-    return bias + lin::multiply(sigma, lin::gaussians<Vector3>(_randoms));
+    return bias + lin::multiply(
+        sigma, sensors_satellite_gyroscope_w_noise.gaussians<Vector3>());
   else
     return lin::nans<Vector3>();
 }
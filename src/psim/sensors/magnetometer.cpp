@@ -51,7 +51,8 @@ Vector3 Magnetometer::sensors_satellite_magnetometer_b_error() const {
   auto const &sigma = sensors_satellite_magnetometer_b_sigma.get();
 
   if (valid)
-    return lin::multiply(sigma, lin::gaussians<Vector3>(_randoms));
+    return lin::multiply(
+        sigma, sensors_satellite_magnetometer_b_noise.gaussians<Vector3>());
   else
     return lin::nans<Vector3>();
 }
@@ -91,8 +91,9 @@ Vector3 SunSensors::sensors_satellite_sun_sensors_s() const {
   /* 2. Generate sensors noise values in spherical coordinates centered about
    *    the x axis.
    */
-  auto const phi = sigma(0) * _randoms.gaussian();
-  auto const theta = gnc::constant::pi / 2.0 + sigma(1) * _randoms.gaussian();
+  auto &noise = sensors_satellite_sun_sensors_s_noise;
+  auto const phi = sigma(0) * noise.gaussian();
+  auto const theta = gnc::constant::pi / 2.0 + sigma(1) * noise.gaussian();
 
   /* 3. Reconstruct the measured sun vector relative to the x axis (which is the
    *    true sun vector given step 1).
@@ -28,32 +28,25 @@
 
 #include <psim/simulations/dual_orbit.hpp>
 
-#include <psim/sensors/cdgps_no_attitude.hpp>
-#include <psim/sensors/satellite_sensors.hpp>
-#include <psim/truth/earth.hpp>
-#include <psim/truth/hill_frame.hpp>
-#include <psim/truth/satellite_truth.hpp>
-#include <psim/truth/time.hpp>
-#include <psim/utilities/norm_vector3.hpp>
+#include <tuple>
 
 namespace psim {
 
 DualOrbitGnc::DualOrbitGnc(
     RandomsGenerator &randoms, Configuration const &config)
-  : ModelList(randoms) {
-  // Truth model
-  add<Time>(randoms, config);
-  add<EarthGnc>(randoms, config);
-  add<SatelliteTruthNoAttitudeGnc>(randoms, config, "leader");
-  add<SatelliteTruthNoAttitudeGnc>(randoms, config, "follower");
-  add<HillFrameEci>(randoms, config, "leader", "follower");
-  add<HillFrameEci>(randoms, config, "follower", "leader");
-  add<NormVector3>(randoms, config, "truth.leader.hill.dr");
-  add<NormVector3>(randoms, config, "truth.leader.hill.dv");
-  // Sensors model
-  add<SatelliteSensorsNoAttitude>(randoms, config, "leader");
-  add<SatelliteSensorsNoAttitude>(randoms, config, "follower");
-  add<CdgpsNoAttitude>(randoms, config, "leader", "follower");
-  add<CdgpsNoAttitude>(randoms, config, "follower", "leader");
-}
+  : StaticModelList(randoms,
+        // Truth model
+        std::forward_as_tuple(randoms, config),
+        std::forward_as_tuple(randoms, config),
+        std::forward_as_tuple(randoms, config, "leader"),
+        std::forward_as_tuple(randoms, config, "follower"),
+        std::forward_as_tuple(randoms, config, "leader", "follower"),
+        std::forward_as_tuple(randoms, config, "follower", "leader"),
+        std::forward_as_tuple(randoms, config, "truth.leader.hill.dr"),
+        std::forward_as_tuple(randoms, config, "truth.leader.hill.dv"),
+        // Sensors model
+        std::forward_as_tuple(randoms, config, "leader"),
+        std::forward_as_tuple(randoms, config, "follower"),
+        std::forward_as_tuple(randoms, config, "leader", "follower"),
+        std::forward_as_tuple(randoms, config, "follower", "leader")) {}
 } // namespace psim
@@ -28,21 +28,17 @@
 
 #include <psim/simulations/single_orbit.hpp>
 
-#include <psim/sensors/satellite_sensors.hpp>
-#include <psim/truth/earth.hpp>
-#include <psim/truth/satellite_truth.hpp>
-#include <psim/truth/time.hpp>
+#include <tuple>
 
 namespace psim {
 
 SingleOrbitGnc::SingleOrbitGnc(
     RandomsGenerator &randoms, Configuration const &config)
-  : ModelList(randoms) {
-  // Truth model
-  add<Time>(randoms, config);
-  add<EarthGnc>(randoms, config);
-  add<SatelliteTruthNoAttitudeGnc>(randoms, config, "leader");
-  // Sensors model
-  add<SatelliteSensorsNoAttitude>(randoms, config, "leader");
-}
+  : StaticModelList(randoms,
+        // Truth model
+        std::forward_as_tuple(randoms, config),
+        std::forward_as_tuple(randoms, config),
+        std::forward_as_tuple(randoms, config, "leader"),
+        // Sensors model
+        std::forward_as_tuple(randoms, config, "leader")) {}
 } // namespace psim
@@ -38,11 +38,28 @@
 #include <psim/truth/attitude_utilities.hpp>
 #include <psim/truth/orbit_utilities.hpp>
 
+#include <stdexcept>
+
 namespace psim {
 
 AttitudeOrbitNoFuelEcef::AttitudeOrbitNoFuelEcef(RandomsGenerator &randoms,
     Configuration const &config, std::string const &satellite)
-  : Super(randoms, config, satellite, "ecef") {}
+  : Super(randoms, config, satellite, "ecef"), satellite(satellite) {
+  configure_integrator(config);
+}
+
+void AttitudeOrbitNoFuelEcef::configure(Configuration const &config) {
+  this->Super::configure(config);
+  configure_integrator(config);
+}
+
+void AttitudeOrbitNoFuelEcef::configure_integrator(
+    Configuration const &config) {
+  Real rel_tol, abs_tol;
+  adaptive = orbit::tolerances(config, satellite, rel_tol, abs_tol);
+  grid = orbit::gravity_grid(config);
+  if (adaptive) adaptive_ode = gnc::Ode45<Real, 16>(rel_tol, abs_tol);
+}
 
 void AttitudeOrbitNoFuelEcef::step() {
   this->Super::step();
@@ -52,6 +69,7 @@ void AttitudeOrbitNoFuelEcef::step() {
     Real const &S;
     Vector3 const &earth_w;
     Vector3 const &earth_w_dot;
+    GravityGrid const *grid;
     Vector3 const &J_body;
     Real const &wheels_J_body;
     Vector3 const &wheels_t_body;
@@ -59,7 +77,7 @@ void AttitudeOrbitNoFuelEcef::step() {
     Vector3 const &b_eci;
   };
 
-  auto const &dt = truth_dt_s->get();
+  auto const dt = truth_dt_s->get() * Real(ticks());
   auto const &earth_w = truth_earth_w->get();
   auto const &earth_w_dot = truth_earth_w_dot->get();
   auto const &q_eci_ecef = truth_earth_q_eci_ecef->get();
@@ -94,90 +112,94 @@ void AttitudeOrbitNoFuelEcef::step() {
   lin::ref<Vector4>(x, 6, 0) = q_body_eci;
   lin::ref<Vector3>(x, 10, 0) = w_body;
   lin::ref<Vector3>(x, 13, 0) = wheels_w_body;
-  IntegratorData data{m, S, earth_w, earth_w_dot, J_body, wheels_J_body,
+  IntegratorData data{m, S, earth_w, earth_w_dot, grid, J_body, wheels_J_body,
       wheels_t_body, m_body, b_eci};
 
   // Simulate dynamics.
-  x = ode(Real(0.0), dt, x, &data,
-      [](Real t, Vector<16> const &x, void *ptr) -> Vector<16> {
-        auto const *data = static_cast<IntegratorData *>(ptr);
-
-        auto const &m = data->m;
-        auto const &S = data->S;
-        auto const earth_w = (data->earth_w + t * data->earth_w_dot).eval();
-        auto const &earth_w_dot = data->earth_w_dot;
-        auto const &J_body = data->J_body;
-        auto const &wheels_J_body = data->wheels_J_body;
-        auto const &wheels_t_body = data->wheels_t_body;
-        auto const &m_body = data->m_body;
-
-        auto const r_ecef = lin::ref<Vector3>(x, 0, 0);
-        auto const v_ecef = lin::ref<Vector3>(x, 3, 0);
-        auto const q_body_eci = lin::ref<Vector4>(x, 6, 0);
-        auto const w_body = lin::ref<Vector3>(x, 10, 0);
-        auto const wheels_w_body = lin::ref<Vector3>(x, 13, 0);
-        auto const b_body = [&q_body_eci](Vector3 const &b_eci) {
-          Vector3 b_body;
-          gnc::utl::rotate_frame(q_body_eci.eval(), b_eci, b_body);
-          return b_body;
-        }(data->b_eci);
-
-        Vector<16> dx;
-
-        // Orbital dynamics
-        {
-          Vector3 const a_ecef = orbit::acceleration(
-              earth_w, earth_w_dot, r_ecef.eval(), v_ecef.eval(), S, m);
-
-          lin::ref<Vector3>(dx, 0, 0) = v_ecef;
-          lin::ref<Vector3>(dx, 3, 0) = a_ecef;
-        }
-
-        // Attitude dynamics - quaternion
-        {
-          Vector4 dq_body_eci;
-          Vector4 const dq = {
-              0.5 * w_body(0), 0.5 * w_body(1), 0.5 * w_body(2), 0.0};
-          gnc::utl::quat_cross_mult(dq, q_body_eci.eval(), dq_body_eci);
-
-          lin::ref<Vector4>(dx, 6, 0) = dq_body_eci;
-        }
-
-        // Attitude dynamics - angular rate
-        {
-          /* The total angular momentum of the spacecraft is given by:
-           *
-           *   H = J * w + J_wheels * w_wheels
-           *
-           * which allows us to represent Euler's rotation equation as:
-           *
-           *   J alpha = mu x b - tau_wheels - w x H.
-           * 
-           * Recall that the torque commanded to the wheels exerts the opposite
-           * of that on the spacecraft itself.
-           *
-           * Reference(s):
-           *  - https://en.wikipedia.org/wiki/Euler%27s_equations_(rigid_body_dynamics)
-           *  - https://en.wikipedia.org/wiki/Magnetic_moment
-           */
-          Vector3 const H_body =
-              lin::multiply(J_body, w_body) + wheels_J_body * wheels_w_body;
-          Vector3 const t_body = lin::cross(m_body, b_body) - wheels_t_body -
-                                 lin::cross(w_body, H_body);
-          Vector3 const dw_body = lin::divide(t_body, J_body);
-
-          lin::ref<Vector3>(dx, 10, 0) = dw_body;
-        }
-
-        // Attitude dynamics - reaction wheel rates
-        {
-          Vector3 const dwheels_w_body = wheels_t_body / wheels_J_body;
-
-          lin::ref<Vector3>(dx, 13, 0) = dwheels_w_body;
-        }
-
-        return dx;
-      });
+  auto const dx = [](Real t, Vector<16> const &x, void *ptr) -> Vector<16> {
+    auto const *data = static_cast<IntegratorData *>(ptr);
+
+    auto const &m = data->m;
+    auto const &S = data->S;
+    auto const earth_w = (data->earth_w + t * data->earth_w_dot).eval();
+    auto const &earth_w_dot = data->earth_w_dot;
+    auto const &J_body = data->J_body;
+    auto const &wheels_J_body = data->wheels_J_body;
+    auto const &wheels_t_body = data->wheels_t_body;
+    auto const &m_body = data->m_body;
+
+    auto const r_ecef = lin::ref<Vector3>(x, 0, 0);
+    auto const v_ecef = lin::ref<Vector3>(x, 3, 0);
+    auto const q_body_eci = lin::ref<Vector4>(x, 6, 0);
+    auto const w_body = lin::ref<Vector3>(x, 10, 0);
+    auto const wheels_w_body = lin::ref<Vector3>(x, 13, 0);
+    auto const b_body = [&q_body_eci](Vector3 const &b_eci) {
+      Vector3 b_body;
+      gnc::utl::rotate_frame(q_body_eci.eval(), b_eci, b_body);
+      return b_body;
+    }(data->b_eci);
+
+    Vector<16> dx;
+
+    // Orbital dynamics
+    {
+      Vector3 const a_ecef = orbit::acceleration(earth_w, earth_w_dot,
+          r_ecef.eval(), v_ecef.eval(), S, m, data->grid);
+
+      lin::ref<Vector3>(dx, 0, 0) = v_ecef;
+      lin::ref<Vector3>(dx, 3, 0) = a_ecef;
+    }
+
+    // Attitude dynamics - quaternion
+    {
+      Vector4 dq_body_eci;
+      Vector4 const dq = {
+          0.5 * w_body(0), 0.5 * w_body(1), 0.5 * w_body(2), 0.0};
+      gnc::utl::quat_cross_mult(dq, q_body_eci.eval(), dq_body_eci);
+
+      lin::ref<Vector4>(dx, 6, 0) = dq_body_eci;
+    }
+
+    // Attitude dynamics - angular rate
+    {
+      /* The total angular momentum of the spacecraft is given by:
+       *
+       *   H = J * w + J_wheels * w_wheels
+       *
+       * which allows us to represent Euler's rotation equation as:
+       *
+       *   J alpha = mu x b - tau_wheels - w x H.
+       * 
+       * Recall that the torque commanded to the wheels exerts the opposite
+       * of that on the spacecraft itself.
+       *
+       * Reference(s):
+       *  - https://en.wikipedia.org/wiki/Euler%27s_equations_(rigid_body_dynamics)
+       *  - https://en.wikipedia.org/wiki/Magnetic_moment
+       */
+      Vector3 const H_body =
+          lin::multiply(J_body, w_body) + wheels_J_body * wheels_w_body;
+      Vector3 const t_body = lin::cross(m_body, b_body) - wheels_t_body -
+                             lin::cross(w_body, H_body);
+      Vector3 const dw_body = lin::divide(t_body, J_body);
+
+      lin::ref<Vector3>(dx, 10, 0) = dw_body;
+    }
+
+    // Attitude dynamics - reaction wheel rates
+    {
+      Vector3 const dwheels_w_body = wheels_t_body / wheels_J_body;
+
+      lin::ref<Vector3>(dx, 13, 0) = dwheels_w_body;
+    }
+
+    return dx;
+  };
+  x = adaptive ? adaptive_ode(Real(0.0), dt, x, &data, dx)
+               : ode(Real(0.0), dt, x, &data, dx);
+  if (adaptive && (adaptive_ode.error() & gnc::ODE_ERR_MAX_ITER))
+    throw std::runtime_error("Adaptive integration of '" + satellite +
+                             "' exceeded the maximum number of steps.");
 
   // Write back to our state fields
   r_ecef = lin::ref<Vector3>(x, 0, 0);
@@ -196,7 +218,7 @@ Real AttitudeOrbitNoFuelEcef::truth_satellite_orbit_altitude() const {
 Vector3 AttitudeOrbitNoFuelEcef::truth_satellite_orbit_a_gravity() const {
   auto const &r_ecef = truth_satellite_orbit_r.get();
 
-  return orbit::gravity(r_ecef);
+  return orbit::gravity(r_ecef, grid);
 }
 
 Vector3 AttitudeOrbitNoFuelEcef::truth_satellite_orbit_a_drag() const {
@@ -239,7 +261,7 @@ Real AttitudeOrbitNoFuelEcef::truth_satellite_orbit_U() const {
   auto const &m = truth_satellite_m.get();
 
   Real U;
-  orbit::gravity(r_ecef, U);
+  orbit::gravity(r_ecef, U, grid);
 
   return m * U;
 }
@@ -0,0 +1,274 @@
+//
+// MIT License
+//
+// Copyright (c) 2020 Pathfinder for Autonomous Navigation (PAN)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/** @file psim/truth/gravity_grid.cpp
+ *  @author Kyle Krol
+ */
+
+#include <psim/truth/gravity_grid.hpp>
+
+#include <psim/truth/orbit_utilities.hpp>
+
+#include <gnc/constants.hpp>
+#include <orb/Orbit.h>
+
+#include <lin/core.hpp>
+#include <lin/math.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace psim {
+
+/** @brief Magic string every gravity grid cache file starts with.
+ */
+static constexpr char magic[8] = {'P', 'S', 'I', 'M', 'G', 'R', 'A', 'V'};
+
+/** @brief Degree of the spherical harmonic model the grid samples.
+ */
+static constexpr std::uint32_t degree = 11;
+
+/** @brief Size of the cache file's header in bytes.
+ */
+static constexpr std::size_t header = 48;
+
+/** @brief Number of nodes along each dimension.
+ *
+ *  One node is added before the first interval and two after the last so the
+ *  interpolation stencil never leaves the grid.
+ */
+static constexpr std::size_t nr = GravityGrid::shells + 3;
+static constexpr std::size_t nt = GravityGrid::colatitudes + 3;
+static constexpr std::size_t nl = GravityGrid::longitudes + 3;
+
+/** @brief Number of values in the grid.
+ */
+static constexpr std::size_t size = nr * nt * nl * GravityGrid::width;
+
+/** @brief Spacing of the angular dimensions (rad).
+ */
+static constexpr Real ht = gnc::constant::pi / GravityGrid::colatitudes;
+static constexpr Real hl = gnc::constant::two_pi / GravityGrid::longitudes;
+
+constexpr std::uint32_t GravityGrid::version;
+constexpr std::size_t GravityGrid::shells;
+constexpr std::size_t GravityGrid::colatitudes;
+constexpr std::size_t GravityGrid::longitudes;
+constexpr std::size_t GravityGrid::width;
+
+/** @brief Writes the cache file header.
+ */
+static void write_header(std::ostream &os, Real r_min, Real r_max) {
+  std::uint32_t const fields[] = {GravityGrid::version, degree,
+      GravityGrid::shells, GravityGrid::colatitudes, GravityGrid::longitudes,
+      GravityGrid::width};
+  os.write(magic, sizeof(magic));
+  os.write(reinterpret_cast<char const *>(fields), sizeof(fields));
+  os.write(reinterpret_cast<char const *>(&r_min), sizeof(r_min));
+  os.write(reinterpret_cast<char const *>(&r_max), sizeof(r_max));
+}
+
+/** @brief Creates every missing parent directory of a file.
+ */
+static void make_parents(std::string const &file) {
+  for (auto i = file.find('/', 1); i != std::string::npos;
+       i = file.find('/', i + 1))
+    ::mkdir(file.substr(0, i).c_str(), 0755);
+}
+
+/** @brief Cubic Lagrange weights for nodes at -1, 0, 1, and 2 evaluated at t.
+ */
+static void weights(Real t, Real (&w)[4]) {
+  auto const a = t + 1.0, b = t - 1.0, c = t - 2.0;
+  w[0] = -t * b * c / 6.0;
+  w[1] = a * b * c / 2.0;
+  w[2] = -a * t * c / 2.0;
+  w[3] = a * t * b / 6.0;
+}
+
+GravityGrid::GravityGrid(std::string const &file)
+  : _data(nullptr), _bytes(0), _values(nullptr),
+    _r_min(orb::MINORBITRADIUS), _r_max(orb::MAXORBITRADIUS), _file(file) {
+  if (_map()) return;
+
+  auto values = _build();
+
+  // Write to a temporary file first so concurrent processes never map a
+  // partially written grid
+  auto const tmp = _file + "." + std::to_string(::getpid());
+  make_parents(_file);
+  {
+    std::ofstream ofs(tmp, std::ios::binary | std::ios::trunc);
+    write_header(ofs, _r_min, _r_max);
+    ofs.write(reinterpret_cast<char const *>(values.data()),
+        values.size() * sizeof(Real));
+    ofs.close();
+    if (ofs && std::rename(tmp.c_str(), _file.c_str()) == 0 && _map()) return;
+  }
+  std::remove(tmp.c_str());
+
+  _owned = std::move(values);
+  _values = _owned.data();
+}
+
+GravityGrid::~GravityGrid() {
+  if (_data) ::munmap(const_cast<unsigned char *>(_data), _bytes);
+}
+
+bool GravityGrid::_map() {
+  auto const fd = ::open(_file.c_str(), O_RDONLY);
+  if (fd < 0) return false;
+
+  struct stat st;
+  if (::fstat(fd, &st) != 0 ||
+      static_cast<std::size_t>(st.st_size) != header + size * sizeof(Real)) {
+    ::close(fd);
+    return false;
+  }
+
+  _bytes = static_cast<std::size_t>(st.st_size);
+  auto *const data = ::mmap(nullptr, _bytes, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) return false;
+
+  // Only map grids built with the same layout and band
+  std::ostringstream expected;
+  write_header(expected, _r_min, _r_max);
+  if (std::memcmp(data, expected.str().data(), header) != 0) {
+    ::munmap(data, _bytes);
+    return false;
+  }
+
+  _data = static_cast<unsigned char const *>(data);
+  _values = reinterpret_cast<Real const *>(_data + header);
+  return true;
+}
+
+std::vector<Real> GravityGrid::_build() const {
+  auto const hr = (_r_max - _r_min) / shells;
+
+  std::vector<Real> values(size);
+  auto *value = values.data();
+  for (std::size_t i = 0; i < nr; i++) {
+    auto const r = _r_min + (Real(i) - 1.0) * hr;
+
+    // Nodes beyond the poles are physical points on the opposite meridian
+    for (std::size_t j = 0; j < nt; j++) {
+      auto const t = (Real(j) - 1.0) * ht;
+      auto const st = std::sin(t), ct = std::cos(t);
+
+      for (std::size_t k = 0; k < nl; k++) {
+        auto const l = -gnc::constant::pi + (Real(k) - 1.0) * hl;
+        Vector3 const r_ecef = {
+            r * st * std::cos(l), r * st * std::sin(l), r * ct};
+
+        Real U;
+        auto const g = orbit::gravity(r_ecef, U);
+        auto const k_pm = gnc::constant::mu_earth / (r * r * r);
+
+        *value++ = U - gnc::constant::mu_earth / r;
+        for (lin::size_t n = 0; n < 3; n++)
+          *value++ = g(n) + k_pm * r_ecef(n);
+      }
+    }
+  }
+  return values;
+}
+
+GravityGrid const &GravityGrid::instance() {
+  static GravityGrid const grid(default_file());
+  return grid;
+}
+
+std::string GravityGrid::default_file() {
+  if (auto const *file = std::getenv("PSIM_GRAVITY_GRID")) return file;
+  if (auto const *home = std::getenv("HOME"))
+    return std::string(home) + "/.cache/psim/gravity_grid.bin";
+  return "gravity_grid.bin";
+}
+
+std::string const &GravityGrid::file() const {
+  return _file;
+}
+
+bool GravityGrid::mapped() const {
+  return _data != nullptr;
+}
+
+bool GravityGrid::covers(Vector3 const &r_ecef) const {
+  auto const r2 = lin::fro(r_ecef);
+  return r2 >= _r_min * _r_min && r2 <= _r_max * _r_max;
+}
+
+Vector3 GravityGrid::gravity(Vector3 const &r_ecef, Real &U) const {
+  if (!covers(r_ecef)) return orbit::gravity(r_ecef, U);
+
+  auto const rho2 = r_ecef(0) * r_ecef(0) + r_ecef(1) * r_ecef(1);
+  auto const r = lin::norm(r_ecef);
+  auto const hr = (_r_max - _r_min) / shells;
+
+  // Locates the interval containing x and the offset within it
+  auto const locate = [](Real x, std::size_t n, Real (&w)[4]) {
+    auto const i = std::min(std::size_t(std::max(x, 0.0)), n - 1);
+    weights(x - Real(i), w);
+    return i;
+  };
+
+  Real wr[4], wt[4], wl[4];
+  auto const i = locate((r - _r_min) / hr, shells, wr);
+  auto const j = locate(std::atan2(std::sqrt(rho2), r_ecef(2)) / ht,
+      colatitudes, wt);
+  auto const l = std::atan2(r_ecef(1), r_ecef(0)) + gnc::constant::pi;
+  auto const k = locate(l / hl, longitudes, wl);
+
+  // The stencil of interval i starts at node i because of the padding
+  Real sum[width] = {0.0, 0.0, 0.0, 0.0};
+  for (std::size_t a = 0; a < 4; a++) {
+    for (std::size_t b = 0; b < 4; b++) {
+      auto const *node = _values + ((i + a) * nt + j + b) * nl * width +
+                         k * width;
+      auto const w = wr[a] * wt[b];
+
+      for (std::size_t c = 0; c < 4; c++, node += width)
+        for (std::size_t n = 0; n < width; n++)
+          sum[n] += w * wl[c] * node[n];
+    }
+  }
+
+  auto const k_pm = gnc::constant::mu_earth / (r * r * r);
+  U = gnc::constant::mu_earth / r + sum[0];
+  return {sum[1] - k_pm * r_ecef(0), sum[2] - k_pm * r_ecef(1),
+      sum[3] - k_pm * r_ecef(2)};
+}
+} // namespace psim
@@ -39,11 +39,27 @@
 
 #include <psim/truth/orbit_utilities.hpp>
 
+#include <stdexcept>
+
 namespace psim {
 
 OrbitEcef::OrbitEcef(RandomsGenerator &randoms, Configuration const &config,
     std::string const &satellite)
-  : Super(randoms, config, satellite, "ecef") {}
+  : Super(randoms, config, satellite, "ecef"), satellite(satellite) {
+  configure_integrator(config);
+}
+
+void OrbitEcef::configure(Configuration const &config) {
+  this->Super::configure(config);
+  configure_integrator(config);
+}
+
+void OrbitEcef::configure_integrator(Configuration const &config) {
+  Real rel_tol, abs_tol;
+  adaptive = orbit::tolerances(config, satellite, rel_tol, abs_tol);
+  grid = orbit::gravity_grid(config);
+  if (adaptive) adaptive_ode = gnc::Ode45<Real, 6>(rel_tol, abs_tol);
+}
 
 void OrbitEcef::step() {
   this->Super::step();
@@ -53,9 +69,10 @@ void OrbitEcef::step() {
     Real const &S;
     Vector3 const &earth_w;
     Vector3 const &earth_w_dot;
+    GravityGrid const *grid;
   };
 
-  auto const &dt = truth_dt_s->get();
+  auto const dt = truth_dt_s->get() * Real(ticks());
   auto const &earth_w = truth_earth_w->get();
   auto const &earth_w_dot = truth_earth_w_dot->get();
   auto const &S = truth_satellite_S.get();
@@ -74,30 +91,34 @@ void OrbitEcef::step() {
   Vector<6> x;
   lin::ref<Vector3>(x, 0, 0) = r_ecef;
   lin::ref<Vector3>(x, 3, 0) = v_ecef;
-  IntegratorData data = {m, S, earth_w, earth_w_dot};
+  IntegratorData data = {m, S, earth_w, earth_w_dot, grid};
 
   // Simulate dynamics
-  x = ode(Real(0.0), dt, x, &data,
-      [](Real t, Vector<6> const &x, void *ptr) -> Vector<6> {
-        auto const *data = static_cast<IntegratorData *>(ptr);
+  auto const dx = [](Real t, Vector<6> const &x, void *ptr) -> Vector<6> {
+    auto const *data = static_cast<IntegratorData *>(ptr);
 
-        auto const &m = data->m;
-        auto const &S = data->S;
-        auto const earth_w = (data->earth_w + t * data->earth_w_dot).eval();
-        auto const &earth_w_dot = data->earth_w_dot;
+    auto const &m = data->m;
+    auto const &S = data->S;
+    auto const earth_w = (data->earth_w + t * data->earth_w_dot).eval();
+    auto const &earth_w_dot = data->earth_w_dot;
 
-        auto const r_ecef = lin::ref<Vector3>(x, 0, 0);
-        auto const v_ecef = lin::ref<Vector3>(x, 3, 0);
+    auto const r_ecef = lin::ref<Vector3>(x, 0, 0);
+    auto const v_ecef = lin::ref<Vector3>(x, 3, 0);
 
-        Vector3 const a_ecef = orbit::acceleration(
-            earth_w, earth_w_dot, r_ecef.eval(), v_ecef.eval(), S, m);
+    Vector3 const a_ecef = orbit::acceleration(earth_w, earth_w_dot,
+        r_ecef.eval(), v_ecef.eval(), S, m, data->grid);
 
-        Vector<6> dx;
-        lin::ref<Vector3>(dx, 0, 0) = v_ecef;
-        lin::ref<Vector3>(dx, 3, 0) = a_ecef;
+    Vector<6> dx;
+    lin::ref<Vector3>(dx, 0, 0) = v_ecef;
+    lin::ref<Vector3>(dx, 3, 0) = a_ecef;
 
-        return dx;
-      });
+    return dx;
+  };
+  x = adaptive ? adaptive_ode(Real(0.0), dt, x, &data, dx)
+               : ode(Real(0.0), dt, x, &data, dx);
+  if (adaptive && (adaptive_ode.error() & gnc::ODE_ERR_MAX_ITER))
+    throw std::runtime_error("Adaptive integration of '" + satellite +
+                             "' exceeded the maximum number of steps.");
 
   // Write back to our state fields
   r_ecef = lin::ref<Vector3>(x, 0, 0);
@@ -113,7 +134,7 @@ Real OrbitEcef::truth_satellite_orbit_altitude() const {
 Vector3 OrbitEcef::truth_satellite_orbit_a_gravity() const {
   auto const &r_ecef = truth_satellite_orbit_r.get();
 
-  return orbit::gravity(r_ecef);
+  return orbit::gravity(r_ecef, grid);
 }
 
 Vector3 OrbitEcef::truth_satellite_orbit_a_drag() const {
@@ -156,7 +177,7 @@ Real OrbitEcef::truth_satellite_orbit_U() const {
   auto const &m = truth_satellite_m.get();
 
   Real U;
-  orbit::gravity(r_ecef, U);
+  orbit::gravity(r_ecef, U, grid);
 
   return m * U;
 }
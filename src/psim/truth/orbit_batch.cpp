@@ -0,0 +1,210 @@
+//
+// MIT License
+//
+// Copyright (c) 2020 Pathfinder for Autonomous Navigation (PAN)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/** @file psim/truth/orbit_batch.cpp
+ *  @author Kyle Krol
+ */
+
+#include <psim/truth/orbit_batch.hpp>
+
+#include <psim/truth/orbit_utilities.hpp>
+
+#include <lin/core.hpp>
+#include <lin/math.hpp>
+
+#include <algorithm>
+
+namespace psim {
+
+constexpr std::size_t OrbitEcefBatch::_chunk;
+
+OrbitEcefBatch::OrbitEcefBatch(std::size_t n)
+  : _size(n), _m(n, 0.0), _S(n, 0.0), _drag(n, 0.0) {
+  for (auto *columns : {&_x, &_ks, &_k1, &_k2, &_k3, &_k4})
+    for (auto &column : *columns)
+      column.resize(n, 0.0);
+}
+
+std::size_t OrbitEcefBatch::size() const {
+  return _size;
+}
+
+void OrbitEcefBatch::set(std::size_t i, Vector3 const &r_ecef,
+    Vector3 const &v_ecef, Real m, Real S) {
+  for (std::size_t j = 0; j < 3; j++) {
+    _x[j][i] = r_ecef(j);
+    _x[j + 3][i] = v_ecef(j);
+  }
+  _m[i] = m;
+  _S[i] = S;
+}
+
+Vector3 OrbitEcefBatch::r(std::size_t i) const {
+  return {_x[0][i], _x[1][i], _x[2][i]};
+}
+
+Vector3 OrbitEcefBatch::v(std::size_t i) const {
+  return {_x[3][i], _x[4][i], _x[5][i]};
+}
+
+Real const *OrbitEcefBatch::column(std::size_t j) const {
+  return _x[j].data();
+}
+
+void OrbitEcefBatch::impulse(std::size_t i, Vector3 const &J_ecef) {
+  for (std::size_t j = 0; j < 3; j++)
+    _x[j + 3][i] = _x[j + 3][i] + J_ecef(j) / _m[i];
+}
+
+void OrbitEcefBatch::parallelize(ThreadPool &pool) {
+  _pool = &pool;
+}
+
+void OrbitEcefBatch::_derivative(Real t, Vector3 const &earth_w,
+    Vector3 const &earth_w_dot, Columns const &x, Columns &dx,
+    std::size_t begin, std::size_t end) {
+  static constexpr Real half = 0.5;
+  static constexpr Real two = 2.0;
+  static constexpr Real Cd = orbit::drag_coefficient;
+
+  /* Gravity and drag are evaluated one satellite at a time with gravity being
+   * stashed in the acceleration columns. The drag factor matches the ordering
+   * of operations in `orbit::drag`.
+   */
+  for (std::size_t i = begin; i < end; i++) {
+    Vector3 const r_ecef = {x[0][i], x[1][i], x[2][i]};
+    Vector3 const v_ecef = {x[3][i], x[4][i], x[5][i]};
+    auto const g_ecef = orbit::gravity(r_ecef);
+    dx[3][i] = g_ecef(0);
+    dx[4][i] = g_ecef(1);
+    dx[5][i] = g_ecef(2);
+    _drag[i] = -half * Cd * _S[i] * orbit::density(r_ecef) *
+               lin::norm(v_ecef) / _m[i];
+  }
+
+  auto const wx = earth_w(0) + t * earth_w_dot(0);
+  auto const wy = earth_w(1) + t * earth_w_dot(1);
+  auto const wz = earth_w(2) + t * earth_w_dot(2);
+  auto const dwx = earth_w_dot(0);
+  auto const dwy = earth_w_dot(1);
+  auto const dwz = earth_w_dot(2);
+
+  Real const *const rx = x[0].data();
+  Real const *const ry = x[1].data();
+  Real const *const rz = x[2].data();
+  Real const *const vx = x[3].data();
+  Real const *const vy = x[4].data();
+  Real const *const vz = x[5].data();
+  Real const *const drag = _drag.data();
+  Real *const ax = dx[3].data();
+  Real *const ay = dx[4].data();
+  Real *const az = dx[5].data();
+
+  /* Rotating frame terms and the total acceleration as loops across the
+   * batch. The operations are ordered exactly as in `orbit::acceleration` to
+   * reproduce the scalar propagator's rounding. Each component is computed in
+   * its own loop to limit the number of columns a loop touches, otherwise the
+   * compiler gives up on checking the columns don't alias.
+   */
+  for (std::size_t i = begin; i < end; i++) {
+    auto const cy = wz * rx[i] - wx * rz[i];
+    auto const cz = wx * ry[i] - wy * rx[i];
+    auto const rot = -(two * (wy * vz[i] - wz * vy[i]) + (wy * cz - wz * cy) +
+                       (dwy * rz[i] - dwz * ry[i]));
+    ax[i] = (rot + vx[i] * drag[i]) + ax[i];
+  }
+  for (std::size_t i = begin; i < end; i++) {
+    auto const cx = wy * rz[i] - wz * ry[i];
+    auto const cz = wx * ry[i] - wy * rx[i];
+    auto const rot = -(two * (wz * vx[i] - wx * vz[i]) + (wz * cx - wx * cz) +
+                       (dwz * rx[i] - dwx * rz[i]));
+    ay[i] = (rot + vy[i] * drag[i]) + ay[i];
+  }
+  for (std::size_t i = begin; i < end; i++) {
+    auto const cx = wy * rz[i] - wz * ry[i];
+    auto const cy = wz * rx[i] - wx * rz[i];
+    auto const rot = -(two * (wx * vy[i] - wy * vx[i]) + (wx * cy - wy * cx) +
+                       (dwx * ry[i] - dwy * rx[i]));
+    az[i] = (rot + vz[i] * drag[i]) + az[i];
+  }
+
+  for (std::size_t j = 0; j < 3; j++)
+    std::copy(x[j + 3].begin() + begin, x[j + 3].begin() + end,
+        dx[j].begin() + begin);
+}
+
+void OrbitEcefBatch::_step(Real dt, Vector3 const &earth_w,
+    Vector3 const &earth_w_dot, std::size_t begin, std::size_t end) {
+  // Same table of integration constants as gnc::Ode4
+  static constexpr Real
+      c2 = 1.0 / 2.0, a21 = 1.0 / 2.0,
+      c3 = 1.0 / 2.0,                  a32 = 1.0 / 2.0,
+
+                      b1  = 1.0 / 6.0, b2  = 1.0 / 3.0, b3 = 1.0 / 3.0, b4 = 1.0 / 6.0;
+
+  auto const stage = [&](Real a, Columns const &k) {
+    for (std::size_t j = 0; j < 6; j++) {
+      Real const *const xj = _x[j].data();
+      Real const *const kj = k[j].data();
+      Real *const ksj = _ks[j].data();
+      for (std::size_t i = begin; i < end; i++)
+        ksj[i] = xj[i] + a * kj[i];
+    }
+  };
+
+  _derivative(0.0, earth_w, earth_w_dot, _x, _k1, begin, end);
+  stage(a21 * dt, _k1);
+  _derivative(c2 * dt, earth_w, earth_w_dot, _ks, _k2, begin, end);
+  stage(a32 * dt, _k2);
+  _derivative(c3 * dt, earth_w, earth_w_dot, _ks, _k3, begin, end);
+  stage(dt, _k3);
+  _derivative(dt, earth_w, earth_w_dot, _ks, _k4, begin, end);
+
+  for (std::size_t j = 0; j < 6; j++) {
+    Real *const xj = _x[j].data();
+    Real const *const k1 = _k1[j].data();
+    Real const *const k2 = _k2[j].data();
+    Real const *const k3 = _k3[j].data();
+    Real const *const k4 = _k4[j].data();
+    for (std::size_t i = begin; i < end; i++)
+      xj[i] = xj[i] + dt * (b1 * k1[i] + b2 * k2[i] + b3 * k3[i] + b4 * k4[i]);
+  }
+}
+
+void OrbitEcefBatch::step(
+    Real dt, Vector3 const &earth_w, Vector3 const &earth_w_dot) {
+  auto const chunks = (_size + _chunk - 1) / _chunk;
+  auto const step = [&](std::size_t i) {
+    auto const begin = i * _chunk;
+    _step(dt, earth_w, earth_w_dot, begin, std::min(begin + _chunk, _size));
+  };
+
+  if (_pool) {
+    _pool->for_each(chunks, step);
+  } else {
+    for (std::size_t i = 0; i < chunks; i++)
+      step(i);
+  }
+}
+} // namespace psim
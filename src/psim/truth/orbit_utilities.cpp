@@ -36,15 +36,19 @@
 #include <GGM05S.hpp>
 #include <geograv.hpp>
 
+#include <stdexcept>
+
 namespace psim {
 namespace orbit {
 
-Vector3 gravity(Vector3 const &r_ecef) {
+Vector3 gravity(Vector3 const &r_ecef, GravityGrid const *grid) {
   Real _;
-  return gravity(r_ecef, _);
+  return gravity(r_ecef, _, grid);
 }
 
-Vector3 gravity(Vector3 const &r_ecef, Real &U) {
+Vector3 gravity(Vector3 const &r_ecef, Real &U, GravityGrid const *grid) {
+  if (grid) return grid->gravity(r_ecef, U);
+
   static constexpr auto order = 11;
   static constexpr auto grav = static_cast<geograv::Coeff<order>>(GGM05S);
 
@@ -89,13 +93,7 @@ Real density(Vector3 const &r_ecef) {
 
 Vector3 drag(Vector3 const &r_ecef, Vector3 const &v_ecef, Real S, Real m) {
   static constexpr Real half = 0.5;
-
-  /* Drag coefficient pulled from "An Evaluation of CubeSat Orbital Decay" by
-   * Oltrogge and Leveque.
-   *
-   * https://digitalcommons.usu.edu/cgi/viewcontent.cgi?article=1144&context=smallsat
-   */
-  static constexpr Real Cd = 2.2;
+  static constexpr Real Cd = drag_coefficient;
 
   /* Section 10.3.3 of "Fundamental of Spacecraft Attitude Determination and
    * Control" by Markley and Crassidis gives force due to atmospheric drag as:
@@ -125,17 +123,42 @@ Vector3 rotational(Vector3 const &earth_w, Vector3 const &earth_w_dot,
 }
 
 Vector3 acceleration(Vector3 const &earth_w, Vector3 const &earth_w_dot,
-    Vector3 const &r_ecef, Vector3 const &v_ecef, Real S, Real m) {
+    Vector3 const &r_ecef, Vector3 const &v_ecef, Real S, Real m,
+    GravityGrid const *grid) {
   /* Numerically, starting with the smaller forces first like fake forces and
    * drag will reduce rounding errors. Therefore, we included the force of
    * gravity last here.
    */
   auto const a_drag_ecef = drag(r_ecef, v_ecef, S, m);
-  auto const a_grav_ecef = gravity(r_ecef);
+  auto const a_grav_ecef = gravity(r_ecef, grid);
   auto const a_rot_ecef = rotational(earth_w, earth_w_dot, r_ecef, v_ecef);
 
   return (a_rot_ecef + a_drag_ecef) + a_grav_ecef;
 //  return a_rot_ecef + a_grav_ecef;
 }
+
+bool tolerances(Configuration const &config, std::string const &satellite,
+    Real &rel_tol, Real &abs_tol) {
+  auto const prefix = "truth." + satellite + ".orbit.";
+  auto const *rel = config.get(prefix + "rel_tol");
+  auto const *abs = config.get(prefix + "abs_tol");
+
+  if (!rel && !abs) return false;
+  if (!rel || !abs)
+    throw std::runtime_error("Adaptive integration of '" + satellite +
+                             "' requires both '" + prefix + "rel_tol' and '" +
+                             prefix + "abs_tol'.");
+
+  rel_tol = rel->get<Real>();
+  abs_tol = abs->get<Real>();
+  return true;
+}
+
+GravityGrid const *gravity_grid(Configuration const &config) {
+  auto const *grid = config.get("truth.gravity.grid");
+  if (!grid || !grid->get<Boolean>()) return nullptr;
+
+  return &GravityGrid::instance();
+}
 } // namespace orbit
 } // namespace psim
@@ -29,11 +29,24 @@
 #ifndef PSIM_TRUTH_ORBIT_UTILITIES_HPP_
 #define PSIM_TRUTH_ORBIT_UTILITIES_HPP_
 
+#include <psim/core/configuration.hpp>
 #include <psim/core/types.hpp>
+#include <psim/truth/gravity_grid.hpp>
+
+#include <string>
 
 namespace psim {
 namespace orbit {
 
+/** @brief Drag coefficient used by the drag model.
+ *
+ *  Pulled from "An Evaluation of CubeSat Orbital Decay" by Oltrogge and
+ *  Leveque.
+ *
+ *  https://digitalcommons.usu.edu/cgi/viewcontent.cgi?article=1144&context=smallsat
+ */
+constexpr Real drag_coefficient = 2.2;
+
 /** @brief Calculates total orbital acceleration in ECEF.
  *
  *  @param[in] earth_w     Earth's angular rate in ECEF (rad/s).
@@ -43,11 +56,13 @@ namespace orbit {
  *  @param[in] v_ecef      Velocity in ECEF (m/s).
  *  @param[in] S           Area projected along the direction of travel (m^2).
  *  @param[in] m           Satellite mass (kg).
+ *  @param[in] grid        Optional gravity grid.
  *
  *  @return Acceleration in ECEF (m/s^2).
  */
 Vector3 acceleration(Vector3 const &earth_w, Vector3 const &earth_w_dot,
-    Vector3 const &r_ecef, Vector3 const &v_ecef, Real S, Real m);
+    Vector3 const &r_ecef, Vector3 const &v_ecef, Real S, Real m,
+    GravityGrid const *grid = nullptr);
 
 /** @brief Calculate atmospheric density.
  *
@@ -71,19 +86,26 @@ Vector3 drag(Vector3 const &r_ecef, Vector3 const &v_ecef, Real S, Real m);
 /** @brief Calculate gravitational acceleration.
  *
  *  @param[in]  r_ecef Position in ECEF (m).
+ *  @param[in]  grid   Optional gravity grid.
  *
  *  @return g_ecef Gravitational accelerating in ECEF (m/s^2).
+ *
+ *  The spherical harmonic model is evaluated directly unless a grid is given.
  */
-Vector3 gravity(Vector3 const &r_ecef);
+Vector3 gravity(Vector3 const &r_ecef, GravityGrid const *grid = nullptr);
 
 /** @brief Calculate gravitational acceleration and potential.
  *
  *  @param[in]  r_ecef Position in ECEF (m).
  *  @param[out] U      Gravitational potential (J/kg).
+ *  @param[in]  grid   Optional gravity grid.
  *
  *  @return g_ecef Gravitational accelerating in ECEF (m/s^2).
+ *
+ *  The spherical harmonic model is evaluated directly unless a grid is given.
  */
-Vector3 gravity(Vector3 const &r_ecef, Real &U);
+Vector3 gravity(
+    Vector3 const &r_ecef, Real &U, GravityGrid const *grid = nullptr);
 
 /** @brief Calculates acceleration due to the rotating frame in ECEF.
  *
@@ -98,6 +120,32 @@ Vector3 gravity(Vector3 const &r_ecef, Real &U);
 Vector3 rotational(Vector3 const &earth_w, Vector3 const &earth_w_dot,
     Vector3 const &r_ecef, Vector3 const &v_ecef);
 
+/** @brief Reads the optional adaptive integration tolerances of a satellite.
+ *
+ *  @param[in]  config    Simulation configuration.
+ *  @param[in]  satellite Satellite name.
+ *  @param[out] rel_tol   Relative tolerance.
+ *  @param[out] abs_tol   Absolute tolerance.
+ *
+ *  @return True if the satellite's truth dynamics should be integrated with a
+ *          variable step size.
+ *
+ *  Adaptive integration is requested by setting both the
+ *  `truth.{satellite}.orbit.rel_tol` and `truth.{satellite}.orbit.abs_tol`
+ *  parameters. If only one of them is set, a runtime error will be thrown.
+ */
+bool tolerances(Configuration const &config, std::string const &satellite,
+    Real &rel_tol, Real &abs_tol);
+
+/** @brief Reads the optional gravity backend of a simulation.
+ *
+ *  @param[in] config Simulation configuration.
+ *
+ *  @return Shared gravity grid if the `truth.gravity.grid` parameter is set to
+ *          true and nullptr otherwise.
+ */
+GravityGrid const *gravity_grid(Configuration const &config);
+
 } // namespace orbit
 } // namespace psim
 
@@ -29,7 +29,7 @@ namespace psim {
 void Time::step() {
   this->Super::step();
 
-  this->truth_t_ns.get() += this->truth_dt_ns.get();
+  this->truth_t_ns.get() += this->truth_dt_ns.get() * Integer(ticks());
 }
 
 Real Time::truth_t_s() const {
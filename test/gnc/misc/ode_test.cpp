@@ -9,6 +9,7 @@
 #include <gnc/ode2.hpp>
 #include <gnc/ode3.hpp>
 #include <gnc/ode4.hpp>
+#include <gnc/ode45.hpp>
 
 #include <cmath>
 
@@ -24,6 +25,12 @@ static void fsho(double t, double const *y, double *dy) {
   dy[1] = -y[0];
 }
 
+static void fsho_ptr(double t, double const *y, double *dy, void *ptr) {
+  double const w = *static_cast<double *>(ptr);
+  dy[0] = y[1];
+  dy[1] = -w * w * y[0];
+}
+
 void test_ode_ode1_sho() {
   // Values were comapred to MATLAB's ode2 implementation
   auto const dx = [](double t, lin::Vector2d const &x, void *) -> lin::Vector2d {
@@ -138,6 +145,60 @@ void test_ode_ode45_sho() {
   TEST_ASSERT_DOUBLE_WITHIN(2e-3, std::cos(7.5), yf[0]);
 }
 
+void test_ode_ode23_dense() {
+  PAN_GNC_ODEXX_TEST_VARS(6);
+  double w = 2.0, h = 0.0;
+  double const to[4] = { 0.3, 1.1, 2.5, 3.0 };
+  double yo[4 * ne];
+  int code;
+  // Check the final state, output states, and suggested step size
+  code = gnc::ode23(ti, 3.0, yi, yf, ne, bf, 1e-6, 1e-8, 1e-8, 100000,
+      fsho_ptr, &w, &h, to, yo, 4);
+  TEST_ASSERT_EQUAL_INT(gnc::ODE_ERR_OK, code);
+  TEST_ASSERT_DOUBLE_WITHIN(1e-6, std::cos(6.0), yf[0]);
+  for (unsigned int i = 0; i < 4; i++) {
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, std::cos(2.0 * to[i]), yo[i * ne]);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, -2.0 * std::sin(2.0 * to[i]), yo[i * ne + 1]);
+  }
+  TEST_ASSERT_TRUE(h > 0.0);
+}
+
+void test_ode_ode45_dense() {
+  PAN_GNC_ODEXX_TEST_VARS(9);
+  double w = 2.0, h = 0.0;
+  double const to[4] = { 0.3, 1.1, 2.5, 3.0 };
+  double yo[4 * ne];
+  int code;
+  // Output states between steps are interpolated to the same accuracy
+  code = gnc::ode45(ti, 3.0, yi, yf, ne, bf, 1e-6, 1e-10, 1e-10, 100000,
+      fsho_ptr, &w, &h, to, yo, 4);
+  TEST_ASSERT_EQUAL_INT(gnc::ODE_ERR_OK, code);
+  TEST_ASSERT_DOUBLE_WITHIN(1e-8, std::cos(6.0), yf[0]);
+  for (unsigned int i = 0; i < 4; i++) {
+    TEST_ASSERT_DOUBLE_WITHIN(1e-8, std::cos(2.0 * to[i]), yo[i * ne]);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-8, -2.0 * std::sin(2.0 * to[i]), yo[i * ne + 1]);
+  }
+  // Continuing with the suggested step size gives the same accuracy
+  code = gnc::ode45(3.0, 6.0, yf, yf, ne, bf, 1e-6, 1e-10, 1e-10, 100000,
+      fsho_ptr, &w, &h);
+  TEST_ASSERT_EQUAL_INT(gnc::ODE_ERR_OK, code);
+  TEST_ASSERT_DOUBLE_WITHIN(1e-8, std::cos(12.0), yf[0]);
+}
+
+void test_ode_ode45_large_step() {
+  // Stepping with large timesteps holds the tolerance
+  auto const dx = [](double t, lin::Vector2d const &x, void *) -> lin::Vector2d {
+    return {x(1), -x(0)};
+  };
+  gnc::Ode45<double, 2> ode(1e-10, 1e-10);
+  lin::Vector2d x = {1.0, 0.0};
+  for (unsigned int i = 0; i < 10; i++)
+    x = ode(static_cast<double>(i), 1.0, x, nullptr, dx);
+  TEST_ASSERT_EQUAL_INT(gnc::ODE_ERR_OK, ode.error());
+  TEST_ASSERT_DOUBLE_WITHIN(1e-8, std::cos(10.0), x(0));
+  TEST_ASSERT_DOUBLE_WITHIN(1e-8, -std::sin(10.0), x(1));
+}
+
 void ode_test() {
   RUN_TEST(test_ode_ode1_sho);
   RUN_TEST(test_ode_ode2_sho);
@@ -145,4 +206,7 @@ void ode_test() {
   RUN_TEST(test_ode_ode4_sho);
   RUN_TEST(test_ode_ode23_sho);
   RUN_TEST(test_ode_ode45_sho);
+  RUN_TEST(test_ode_ode23_dense);
+  RUN_TEST(test_ode_ode45_dense);
+  RUN_TEST(test_ode_ode45_large_step);
 }
@@ -0,0 +1,115 @@
+/** @file test/psim/core/async_telemetry_test.cpp
+ *  @author Kyle Krol
+ */
+
+#include "counter.hpp"
+
+#include <gtest/gtest.h>
+
+#include <psim/core/async_telemetry.hpp>
+#include <psim/core/configuration.hpp>
+#include <psim/core/simulation.hpp>
+#include <psim/core/state.hpp>
+#include <psim/core/state_field_valued.hpp>
+#include <psim/core/telemetry.hpp>
+#include <psim/core/types.hpp>
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Policy = psim::AsyncTelemetryWriter::Policy;
+
+/* Logs a counter and a vector for a number of samples through a small ring
+ * buffer and returns the pipeline's counters.
+ */
+psim::AsyncTelemetryWriter::Stats run(std::string const &file, Policy policy,
+    psim::Integer samples) {
+  psim::StateFieldValued<psim::Integer> field0("field0", 0);
+  psim::StateFieldValued<psim::Vector2> field1("field1", {0.0, 0.0});
+
+  psim::State state;
+  state.add(&field0);
+  state.add(&field1);
+
+  psim::AsyncTelemetryWriter writer(
+      state, file, {"field0", "field1"}, 1, 16, 8, policy);
+  for (psim::Integer i = 0; i < samples; i++) {
+    field0.get() = i;
+    field1.get() = {1.0 * i, -1.0 * i};
+    writer.step();
+  }
+  writer.close();
+  return writer.stats();
+}
+} // namespace
+
+TEST(AsyncTelemetry, TestBlock) {
+  std::string const file = "async_telemetry_test_block.bin";
+  auto const stats = run(file, Policy::Block, 1000);
+  ASSERT_EQ(stats.samples, 1000);
+  ASSERT_EQ(stats.written, 1000);
+  ASSERT_EQ(stats.dropped, 0);
+  ASSERT_EQ(stats.depth, 0);
+  ASSERT_LE(stats.max_depth, 8);
+
+  // Nothing is lost and samples are written in order
+  psim::TelemetryReader reader(file);
+  ASSERT_EQ(reader.size(), 1000);
+  std::vector<psim::Integer> n(reader.size());
+  std::vector<psim::Real> y(reader.size());
+  reader.read("field0", n.data());
+  reader.read("field1.y", y.data());
+  for (std::size_t i = 0; i < reader.size(); i++) {
+    ASSERT_EQ(n[i], i);
+    ASSERT_EQ(y[i], -1.0 * i);
+  }
+  std::remove(file.c_str());
+}
+
+TEST(AsyncTelemetry, TestDrop) {
+  for (auto const policy : {Policy::DropOldest, Policy::Decimate}) {
+    std::string const file = "async_telemetry_test_drop.bin";
+    auto const stats = run(file, policy, 5000);
+    ASSERT_EQ(stats.samples, 5000);
+    ASSERT_EQ(stats.written + stats.dropped, stats.samples);
+    ASSERT_EQ(stats.stalls, 0);
+
+    // Samples that were kept are still in order
+    psim::TelemetryReader reader(file);
+    ASSERT_EQ(reader.size(), stats.written);
+    std::vector<psim::Integer> n(reader.size());
+    std::vector<psim::Real> x(reader.size());
+    reader.read("field0", n.data());
+    reader.read("field1.x", x.data());
+    for (std::size_t i = 0; i < reader.size(); i++)
+      ASSERT_EQ(x[i], 1.0 * n[i]);
+    for (std::size_t i = 1; i < reader.size(); i++)
+      ASSERT_GT(n[i], n[i - 1]);
+    std::remove(file.c_str());
+  }
+}
+
+TEST(AsyncTelemetry, TestSimulation) {
+  auto const config =
+      psim::Configuration("test/psim/core/simulation_test_config.txt");
+  psim::Simulation<Counter> sim(config);
+
+  std::string const file = "async_telemetry_test_simulation.bin";
+  auto const log = sim.log_async(file, {"n"}, 2);
+  sim.step(7);
+  sim.detach(log);
+  log->close();
+  EXPECT_THROW(log->record(), std::runtime_error);
+
+  psim::TelemetryReader reader(file);
+  ASSERT_EQ(reader.size(), 3);
+  ASSERT_EQ(reader.integers("n", 0)[2], 6);
+  std::remove(file.c_str());
+
+  EXPECT_THROW(psim::AsyncTelemetryWriter::policy("fast"), std::runtime_error);
+  ASSERT_EQ(psim::AsyncTelemetryWriter::policy("decimate"), Policy::Decimate);
+}
@@ -0,0 +1,267 @@
+/** @file test/psim/core/checkpoint_test.cpp
+ *  @author Kyle Krol
+ */
+
+#include "counter.hpp"
+
+#include <gtest/gtest.h>
+
+#include <psim/core/checkpoint.hpp>
+#include <psim/core/configuration.hpp>
+#include <psim/core/random_stream.hpp>
+#include <psim/core/simulation.hpp>
+#include <psim/core/state.hpp>
+#include <psim/core/state_field_valued.hpp>
+#include <psim/core/types.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+/* Counter perturbed by a random walk with some private state that must be
+ * checkpointed by hand.
+ */
+class Drifter : public Counter {
+ private:
+  psim::RandomStream mutable _noise;
+  psim::StateFieldValued<psim::Real> _x;
+  psim::Real _sum = 0.0;
+
+ public:
+  Drifter(psim::RandomsGenerator &randoms, psim::Configuration const &config)
+    : Counter(randoms, config),
+      _noise(config["seed"].get<psim::Integer>(), "Drifter", "x.noise",
+          &this->_epoch),
+      _x("x", 0.0) {}
+
+  virtual void add_fields(psim::State &state) override {
+    Counter::add_fields(state);
+    state.add(&_x);
+  }
+
+  virtual void step() override {
+    Counter::step();
+    _x.get() += _noise.gaussian() + _noise.gaussian() + 0.001 * _sum;
+    _sum += _x.get();
+  }
+
+  virtual void checkpoint(psim::Checkpoint &checkpoint) const override {
+    Counter::checkpoint(checkpoint);
+    _noise.checkpoint(checkpoint, "Drifter.noise");
+    checkpoint.write("Drifter.x", _x.get());
+    checkpoint.write("Drifter.sum", _sum);
+  }
+
+  virtual void restore(psim::Checkpoint::Reader &reader) override {
+    Counter::restore(reader);
+    _noise.restore(reader, "Drifter.noise");
+    reader.read("Drifter.x", _x.get());
+    reader.read("Drifter.sum", _sum);
+  }
+
+  virtual void configure(psim::Configuration const &config) override {
+    Counter::configure(config);
+    _noise.reseed(config["seed"].get<psim::Integer>(), "Drifter", "x.noise");
+  }
+};
+
+psim::Configuration config() {
+  return psim::Configuration("test/psim/core/simulation_test_config.txt");
+}
+} // namespace
+
+TEST(Checkpoint, TestRecords) {
+  psim::Checkpoint checkpoint;
+  checkpoint.write("a", psim::Integer(1));
+  checkpoint.write("b", psim::Real(2.0));
+
+  // Only the values are stored
+  ASSERT_EQ(checkpoint.size(), sizeof(psim::Integer) + sizeof(psim::Real));
+
+  psim::Integer a = 0;
+  psim::Real b = 0.0;
+  psim::Boolean c = false;
+  psim::Checkpoint::Reader reader(checkpoint);
+  ASSERT_FALSE(reader.done());
+
+  reader.read("a", a);
+  reader.read("b", b);
+  ASSERT_EQ(a, 1);
+  ASSERT_EQ(b, 2.0);
+  ASSERT_TRUE(reader.done());
+
+  // Reads past the end are rejected and leave the value alone
+  ASSERT_THROW(reader.read("c", c), std::runtime_error);
+  ASSERT_FALSE(c);
+
+  // Reads with the wrong name or size don't match the layout
+  psim::Checkpoint::Reader renamed(checkpoint);
+  renamed.read("a", a);
+  renamed.read("c", b);
+  ASSERT_FALSE(renamed.done());
+
+  psim::Checkpoint::Reader resized(checkpoint);
+  resized.read("a", a);
+  resized.read("b", c);
+  ASSERT_FALSE(resized.done());
+
+  // Layouts only depend on the names and sizes of the records
+  psim::Checkpoint other;
+  other.write("a", psim::Integer(3));
+  ASSERT_NE(other.layout(), checkpoint.layout());
+  other.write("b", psim::Real(4.0));
+  ASSERT_EQ(other.layout(), checkpoint.layout());
+  other.clear();
+  ASSERT_EQ(other.layout(), psim::Checkpoint().layout());
+}
+
+TEST(Checkpoint, TestRestore) {
+  psim::Simulation<Drifter> sim(config());
+  sim.step(10);
+  auto const checkpoint = sim.checkpoint();
+
+  sim.step(10);
+  auto const n = sim["n"].get<psim::Integer>();
+  auto const x = sim["x"].get<psim::Real>();
+
+  // Restoring into the same simulation replays the exact same trajectory
+  sim.restore(checkpoint);
+  ASSERT_EQ(sim["n"].get<psim::Integer>(), 10);
+  sim.step(10);
+  ASSERT_EQ(sim["n"].get<psim::Integer>(), n);
+  ASSERT_EQ(sim["x"].get<psim::Real>(), x);
+
+  // As does restoring into a fresh simulation
+  psim::Simulation<Drifter> other(config());
+  other.restore(checkpoint);
+  other.step(10);
+  ASSERT_EQ(other["n"].get<psim::Integer>(), n);
+  ASSERT_EQ(other["x"].get<psim::Real>(), x);
+}
+
+TEST(Checkpoint, TestBranch) {
+  auto const base = config();
+  psim::Simulation<Drifter> sim(base);
+  sim.step(10);
+  auto const checkpoint = sim.checkpoint();
+  sim.step(10);
+
+  // A branch with a different seed shares the history but not the noise
+  auto branch_config = psim::Configuration::overlay(base);
+  branch_config.set<psim::Integer>("seed", 1);
+  psim::Simulation<Drifter> branch(branch_config);
+  branch.restore(checkpoint);
+  branch.step(10);
+  ASSERT_EQ(branch["n"].get<psim::Integer>(), sim["n"].get<psim::Integer>());
+  ASSERT_NE(branch["x"].get<psim::Real>(), sim["x"].get<psim::Real>());
+}
+
+TEST(Checkpoint, TestFile) {
+  std::string const file = "checkpoint_test.ckpt";
+
+  psim::Simulation<Drifter> sim(config());
+  sim.step(5);
+  auto const checkpoint = sim.checkpoint();
+  checkpoint.save(file);
+  sim.step(5);
+
+  psim::Checkpoint const loaded(file);
+  ASSERT_EQ(loaded.size(), checkpoint.size());
+
+  psim::Simulation<Drifter> other(config());
+  other.restore(loaded);
+  other.step(5);
+  ASSERT_EQ(other["x"].get<psim::Real>(), sim["x"].get<psim::Real>());
+
+  // Files that aren't checkpoints are rejected
+  std::ofstream(file) << "not a checkpoint";
+  ASSERT_THROW(psim::Checkpoint{file}, std::runtime_error);
+  std::remove(file.c_str());
+  ASSERT_THROW(psim::Checkpoint{file}, std::runtime_error);
+}
+
+TEST(Checkpoint, TestMismatch) {
+  psim::Simulation<Drifter> drifter(config());
+  psim::Simulation<Counter> counter(config());
+
+  // Models with different state can't restore each other's checkpoints and
+  // are left untouched
+  drifter.step(3);
+  ASSERT_THROW(counter.restore(drifter.checkpoint()), std::runtime_error);
+  ASSERT_THROW(drifter.restore(counter.checkpoint()), std::runtime_error);
+  ASSERT_EQ(counter["n"].get<psim::Integer>(), 0);
+  ASSERT_EQ(drifter["n"].get<psim::Integer>(), 3);
+}
+
+TEST(Checkpoint, TestFork) {
+  auto const base = config();
+  psim::Simulation<Drifter> sim(base);
+  sim.step(10);
+
+  // A fork with the same configuration is an exact copy
+  auto const fork = sim.fork(base);
+  sim.step(10);
+  fork->step(10);
+  ASSERT_EQ((*fork)["x"].get<psim::Real>(), sim["x"].get<psim::Real>());
+
+  // Parameters come from the fork's configuration
+  auto fork_config = psim::Configuration::overlay(base);
+  fork_config.set<psim::Integer>("seed", 1);
+  auto const branch = sim.fork(fork_config);
+  ASSERT_EQ((*branch)["n"].get<psim::Integer>(), 20);
+  ASSERT_EQ((*branch)["x"].get<psim::Real>(), sim["x"].get<psim::Real>());
+  branch->step();
+  sim.step();
+  ASSERT_NE((*branch)["x"].get<psim::Real>(), sim["x"].get<psim::Real>());
+
+  // Forking into a built simulation keeps its parameters and handles
+  auto const x = branch->resolve<psim::Real>("x");
+  sim.fork(*branch);
+  ASSERT_EQ((*branch)["n"].get<psim::Integer>(), 21);
+  ASSERT_EQ(x.get(), sim["x"].get<psim::Real>());
+  branch->step();
+  sim.step();
+  ASSERT_NE(x.get(), sim["x"].get<psim::Real>());
+}
+
+TEST(Checkpoint, TestReset) {
+  auto const base = config();
+  psim::Simulation<Drifter> sim(base);
+  auto const x = sim.resolve<psim::Real>("x");
+  auto const recorder = sim.record({"x"});
+  sim.step(10);
+  auto const first = x.get();
+
+  // Resetting with the same configuration replays the same run
+  sim.reset(base);
+  ASSERT_EQ(sim["n"].get<psim::Integer>(), 0);
+  ASSERT_EQ(x.get(), 0.0);
+  sim.step(10);
+  ASSERT_EQ(x.get(), first);
+  ASSERT_EQ(recorder->size(), 20);
+
+  // Overrides take effect and handles remain valid
+  psim::Configuration overrides;
+  overrides.set<psim::Integer>("seed", 1);
+  overrides.set<psim::Integer>("n", 5);
+  overrides.set<psim::Integer>("dn", 2);
+  sim.reset(overrides);
+  sim.step(10);
+  ASSERT_EQ(sim["n"].get<psim::Integer>(), 25);
+  ASSERT_NE(x.get(), first);
+
+  auto full = psim::Configuration::overlay(base);
+  full.merge(overrides);
+  psim::Simulation<Drifter> fresh(full);
+  fresh.step(10);
+  ASSERT_EQ(fresh["x"].get<psim::Real>(), x.get());
+
+  // Overrides don't carry over to the next reset
+  sim.reset(psim::Configuration());
+  sim.step(10);
+  ASSERT_EQ(sim["n"].get<psim::Integer>(), 10);
+  ASSERT_EQ(x.get(), first);
+}
@@ -0,0 +1,74 @@
+/** @file test/psim/core/condition_test.cpp
+ *  @author Kyle Krol
+ */
+
+#include <gtest/gtest.h>
+
+#include <psim/core/condition.hpp>
+#include <psim/core/state.hpp>
+#include <psim/core/state_field_valued.hpp>
+#include <psim/core/types.hpp>
+
+#include <stdexcept>
+
+class Condition : public testing::Test {
+ protected:
+  psim::StateFieldValued<psim::Boolean> flag;
+  psim::StateFieldValued<psim::Integer> count;
+  psim::StateFieldValued<psim::Real> value;
+  psim::StateFieldValued<psim::Vector3> vector;
+  psim::State state;
+
+ public:
+  Condition()
+    : flag("flag", false), count("count", 2), value("value", 0.5),
+      vector("vector") {}
+
+  void SetUp() override {
+    state.add_writable(&flag);
+    state.add_writable(&count);
+    state.add_writable(&value);
+    state.add_writable(&vector);
+  }
+};
+
+TEST_F(Condition, TestExpression) {
+  using Comparison = psim::Condition::Comparison;
+
+  ASSERT_TRUE(psim::Condition(state, "count == 2")());
+  ASSERT_TRUE(psim::Condition(state, "count >= 2")());
+  ASSERT_FALSE(psim::Condition(state, "count > 2")());
+  ASSERT_TRUE(psim::Condition(state, "value < 0.75")());
+  ASSERT_FALSE(psim::Condition(state, "value <= 0.25")());
+  ASSERT_TRUE(psim::Condition(state, "value != 1e-3")());
+  ASSERT_TRUE(psim::Condition(state, "flag == false")());
+  ASSERT_FALSE(psim::Condition(state, "flag != false")());
+  ASSERT_TRUE(psim::Condition(state, "count", Comparison::Less, 3l)());
+  ASSERT_TRUE(psim::Condition(state, "value", Comparison::Greater, 0.0)());
+
+  // Conditions track changes to the underlying field
+  psim::Condition const condition(state, "count > 2");
+  count.get() = 3;
+  ASSERT_TRUE(condition());
+}
+
+TEST_F(Condition, TestErrors) {
+  using Comparison = psim::Condition::Comparison;
+
+  ASSERT_THROW(psim::Condition(state, "count"), std::runtime_error);
+  ASSERT_THROW(psim::Condition(state, "count = 2"), std::runtime_error);
+  ASSERT_THROW(psim::Condition(state, "missing < 2"), std::runtime_error);
+  ASSERT_THROW(psim::Condition(state, "vector < 2"), std::runtime_error);
+  ASSERT_THROW(psim::Condition(state, "count < 2.5"), std::runtime_error);
+  ASSERT_THROW(psim::Condition(state, "value < abc"), std::runtime_error);
+  ASSERT_THROW(psim::Condition(state, "flag < true"), std::runtime_error);
+  ASSERT_THROW(psim::Condition(state, "flag == 1"), std::runtime_error);
+  ASSERT_THROW(psim::Condition(state, "count", Comparison::Less, 2.5),
+      std::runtime_error);
+}
+
+TEST_F(Condition, TestField) {
+  ASSERT_EQ(psim::Condition::field("truth.t.ns >= 1000"), "truth.t.ns");
+  ASSERT_EQ(psim::Condition::field("  count"), "count");
+  ASSERT_THROW(psim::Condition::field(" "), std::runtime_error);
+}
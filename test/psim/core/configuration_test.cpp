@@ -43,6 +43,49 @@ TEST(Configuration, TestGet) {
   ASSERT_EQ(config.get("test.dne"), nullptr);
 }
 
+TEST(Configuration, TestOverlay) {
+  std::string const file = "test/psim/core/configuration_test_config.txt";
+  auto const base = psim::Configuration(file);
+  auto config = psim::Configuration::overlay(base);
+
+  // Parameters are looked up in the base configuration
+  ASSERT_EQ(config["test.integer"].template get<psim::Integer>(), 1);
+  ASSERT_EQ(config.get("test.dne"), nullptr);
+
+  // Set parameters shadow the base configuration without modifying it
+  config.set<psim::Integer>("test.integer", 2);
+  config.set<psim::Real>("test.new", 3.0);
+  ASSERT_EQ(config["test.integer"].template get<psim::Integer>(), 2);
+  ASSERT_EQ(config["test.new"].template get<psim::Real>(), 3.0);
+  ASSERT_EQ(base["test.integer"].template get<psim::Integer>(), 1);
+  ASSERT_EQ(base.get("test.new"), nullptr);
+}
+
+TEST(Configuration, TestMerge) {
+  std::string const file = "test/psim/core/configuration_test_config.txt";
+  auto const base = psim::Configuration(file);
+  auto overrides = psim::Configuration::overlay(base);
+  overrides.set<psim::Integer>("test.integer", 2);
+
+  // Copies include the base configuration's parameters
+  auto const copy = psim::Configuration::copy(overrides);
+  ASSERT_EQ(copy["test.integer"].template get<psim::Integer>(), 2);
+  ASSERT_EQ(copy["test.real"].template get<psim::Real>(),
+      base["test.real"].template get<psim::Real>());
+
+  // Merged parameters replace those already set
+  psim::Configuration config;
+  config.set<psim::Integer>("test.integer", 3);
+  config.set<psim::Real>("test.new", 4.0);
+  config.merge(copy);
+  ASSERT_EQ(config["test.integer"].template get<psim::Integer>(), 2);
+  ASSERT_EQ(config["test.new"].template get<psim::Real>(), 4.0);
+
+  // Parameters without a tagged type can't be copied
+  config.set<double const *>("test.pointer", nullptr);
+  ASSERT_THROW(psim::Configuration::copy(config), std::runtime_error);
+}
+
 TEST(Configuration, TestMultiFileMake) {
   std::vector<std::string> const files = {
       "test/psim/core/configuration_test_config.txt",
@@ -21,3 +21,21 @@ void Counter::step() {
 
   _n.get() += _dn.get();
 }
+
+void Counter::checkpoint(psim::Checkpoint &checkpoint) const {
+  this->psim::Model::checkpoint(checkpoint);
+  checkpoint.write("Counter.dn", _dn.get());
+  checkpoint.write("Counter.n", _n.get());
+}
+
+void Counter::restore(psim::Checkpoint::Reader &reader) {
+  this->psim::Model::restore(reader);
+  reader.read("Counter.dn", _dn.get());
+  reader.read("Counter.n", _n.get());
+}
+
+void Counter::configure(psim::Configuration const &config) {
+  this->psim::Model::configure(config);
+  _dn.get() = config["dn"].template get<psim::Integer>();
+  _n.get() = config["n"].template get<psim::Integer>();
+}
@@ -25,6 +25,9 @@ class Counter : public psim::Model {
   Counter(psim::RandomsGenerator &randoms, psim::Configuration const &config);
   virtual void add_fields(psim::State &state) override;
   virtual void step() override;
+  virtual void checkpoint(psim::Checkpoint &checkpoint) const override;
+  virtual void restore(psim::Checkpoint::Reader &reader) override;
+  virtual void configure(psim::Configuration const &config) override;
 };
 
 #endif
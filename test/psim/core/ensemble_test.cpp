@@ -0,0 +1,103 @@
+/** @file test/psim/core/ensemble_test.cpp
+ *  @author Kyle Krol
+ */
+
+#include "counter.hpp"
+
+#include <gtest/gtest.h>
+
+#include <psim/core/configuration.hpp>
+#include <psim/core/ensemble.hpp>
+#include <psim/core/random_stream.hpp>
+#include <psim/core/state.hpp>
+#include <psim/core/state_field_valued.hpp>
+#include <psim/core/types.hpp>
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+/* Counter perturbed by a random walk.
+ */
+class Walker : public Counter {
+ private:
+  psim::RandomStream mutable _noise;
+  psim::StateFieldValued<psim::Real> _x;
+
+ public:
+  Walker(psim::RandomsGenerator &randoms, psim::Configuration const &config)
+    : Counter(randoms, config),
+      _noise(config["seed"].get<psim::Integer>(), "Walker", "x.noise",
+          &this->_epoch),
+      _x("x", 0.0) {}
+
+  virtual void add_fields(psim::State &state) override {
+    Counter::add_fields(state);
+    state.add(&_x);
+  }
+
+  virtual void step() override {
+    Counter::step();
+    _x.get() += _noise.gaussian();
+  }
+};
+
+static std::vector<psim::Configuration> configs(
+    psim::Configuration const &base, std::size_t n) {
+  std::vector<psim::Configuration> configs;
+  for (std::size_t i = 0; i < n; i++) {
+    configs.push_back(psim::Configuration::overlay(base));
+    configs.back().set<psim::Integer>("seed", i);
+    configs.back().set<psim::Integer>("dn", i + 1);
+  }
+  return configs;
+}
+
+TEST(Ensemble, TestOverrides) {
+  auto const base =
+      psim::Configuration("test/psim/core/simulation_test_config.txt");
+  psim::Ensemble<Walker> ensemble(configs(base, 3));
+  ASSERT_EQ(ensemble.size(), 3);
+
+  ensemble.step(4);
+  ASSERT_EQ(ensemble.at(0)["n"].get<psim::Integer>(), 4);
+  ASSERT_EQ(ensemble.at(2)["n"].get<psim::Integer>(), 12);
+  ASSERT_NE(ensemble.at(0)["x"].get<psim::Real>(),
+      ensemble.at(1)["x"].get<psim::Real>());
+  ASSERT_THROW(ensemble.at(3), std::runtime_error);
+
+  // Members stop independently
+  auto const indices = ensemble.step_until({"n >= 12", "n >= 100"});
+  ASSERT_EQ(indices, (std::vector<std::size_t>{0, 0, 0}));
+  ASSERT_EQ(ensemble.at(0)["n"].get<psim::Integer>(), 12);
+  ASSERT_EQ(ensemble.at(2)["n"].get<psim::Integer>(), 15);
+}
+
+TEST(Ensemble, TestDeterministic) {
+  auto const base =
+      psim::Configuration("test/psim/core/simulation_test_config.txt");
+  psim::Ensemble<Walker> serial(configs(base, 16));
+  psim::Ensemble<Walker> parallel(configs(base, 16), 4);
+
+  auto const histories = parallel.record({"x"}, 5);
+  serial.step(100);
+  parallel.step(100);
+  ASSERT_EQ(histories.size(), 16);
+  ASSERT_EQ(histories[7]->size(), 20);
+
+  auto const a = serial.gather({"n", "x"});
+  auto const b = parallel.gather({"n", "x"});
+  ASSERT_EQ(a->size(), 16);
+  for (std::size_t i = 0; i < 16; i++) {
+    ASSERT_EQ(a->integers("n")[i], 100 * (i + 1));
+    ASSERT_EQ(a->reals("x")[i], b->reals("x")[i]);
+    ASSERT_EQ(histories[i]->reals("x")[19], b->reals("x")[i]);
+  }
+
+  // Pruning members for the fields read doesn't change them
+  psim::Ensemble<Walker> pruned(configs(base, 16), {"x"}, 4);
+  pruned.step(100);
+  auto const c = pruned.gather({"x"});
+  for (std::size_t i = 0; i < 16; i++)
+    ASSERT_EQ(c->reals("x")[i], b->reals("x")[i]);
+}
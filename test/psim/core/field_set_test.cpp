@@ -0,0 +1,83 @@
+/** @file test/psim/core/field_set_test.cpp
+ *  @author Kyle Krol
+ */
+
+#include <gtest/gtest.h>
+
+#include <psim/core/field_set.hpp>
+#include <psim/core/state.hpp>
+#include <psim/core/state_field_valued.hpp>
+#include <psim/core/types.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+TEST(FieldSet, TestGet) {
+  psim::StateFieldValued<psim::Boolean> field0("field0", true);
+  psim::StateFieldValued<psim::Integer> field1("field1", 1);
+  psim::StateFieldValued<psim::Vector3> field2("field2", {1.0, 2.0, 3.0});
+  psim::StateFieldValued<psim::Real> field3("field3", 2.0);
+
+  psim::State state;
+  state.add_writable(&field0);
+  state.add_writable(&field1);
+  state.add_writable(&field2);
+  state.add(&field3);
+
+  psim::FieldSet set(state, {"field2", "field1", "field3", "field0"});
+  ASSERT_EQ(set.size(), 6);
+  ASSERT_EQ(set.fields().size(), 4);
+  ASSERT_EQ(set.offset(1), 3);
+  ASSERT_EQ(set.width(0), 3);
+  ASSERT_EQ(set.tag(3), psim::TypeTag::Boolean);
+  ASSERT_FALSE(set.writable());
+
+  std::vector<psim::Real> values(set.size());
+  set.get(values.data());
+  ASSERT_EQ(values, std::vector<psim::Real>({1.0, 2.0, 3.0, 1.0, 2.0, 1.0}));
+
+  // Field values are read again on every call
+  field1.get() = 2;
+  field0.get() = false;
+  set.get(values.data());
+  ASSERT_EQ(values, std::vector<psim::Real>({1.0, 2.0, 3.0, 2.0, 2.0, 0.0}));
+
+  EXPECT_THROW(set.offset(4), std::runtime_error);
+  EXPECT_THROW(psim::FieldSet(state, {"field0", "field0"}), std::runtime_error);
+  EXPECT_THROW(psim::FieldSet(state, {"field4"}), std::runtime_error);
+}
+
+TEST(FieldSet, TestSet) {
+  psim::StateFieldValued<psim::Boolean> field0("field0", true);
+  psim::StateFieldValued<psim::Integer> field1("field1", 1);
+  psim::StateFieldValued<psim::Vector2> field2("field2", {1.0, 2.0});
+  psim::StateFieldValued<psim::Real> field3("field3", 1.0);
+
+  psim::State state;
+  state.add_writable(&field0);
+  state.add_writable(&field1);
+  state.add_writable(&field2);
+  state.add(&field3);
+
+  psim::FieldSet set(state, {"field0", "field1", "field2"});
+  ASSERT_TRUE(set.writable());
+
+  std::vector<psim::Real> const values = {0.0, 5.0, 3.0, 4.0};
+  set.set(values.data());
+  ASSERT_FALSE(field0.get());
+  ASSERT_EQ(field1.get(), 5);
+  ASSERT_EQ(field2.get()(0), 3.0);
+  ASSERT_EQ(field2.get()(1), 4.0);
+
+  // Single fields are written from the start of the given array
+  set.set(2, values.data());
+  ASSERT_EQ(field2.get()(0), 0.0);
+  ASSERT_EQ(field2.get()(1), 5.0);
+
+  // Nothing is written if any field is read only
+  psim::FieldSet read_only(state, {"field1", "field3"});
+  EXPECT_THROW(read_only.set(values.data()), std::runtime_error);
+  ASSERT_EQ(field1.get(), 5);
+  EXPECT_THROW(read_only.set(1, values.data()), std::runtime_error);
+  read_only.set(0, values.data() + 1);
+}
@@ -0,0 +1,421 @@
+/** @file test/psim/core/model_list_test.cpp
+ *  @author Kyle Krol
+ */
+
+#include <gtest/gtest.h>
+
+#include <psim/core/configuration.hpp>
+#include <psim/core/model.hpp>
+#include <psim/core/model_list.hpp>
+#include <psim/core/simulation.hpp>
+#include <psim/core/state.hpp>
+#include <psim/core/state_field_lazy.hpp>
+#include <psim/core/state_field_lazy_base.hpp>
+#include <psim/core/state_field_valued.hpp>
+#include <psim/core/types.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/* Adds a counter and a lazy field with twice its value.
+ */
+class Source : public psim::Model {
+ private:
+  psim::StateFieldValued<psim::Integer> _x;
+  psim::StateFieldLazy<psim::Integer> _y;
+
+ public:
+  Source(psim::RandomsGenerator &randoms, psim::Configuration const &config,
+      std::string const &name)
+    : Model(randoms), _x(name + ".x", 0),
+      _y(name + ".y", [this]() { return 2 * _x.get(); }, &this->_epoch) {}
+
+  virtual void add_fields(psim::State &state) override {
+    state.add(&_x);
+    state.add(&_y);
+  }
+
+  virtual void step() override {
+    this->psim::Model::step();
+    _x.get() += 1;
+  }
+};
+
+/* Accumulates the lazy fields of two sources.
+ */
+class Sink : public psim::Model {
+ private:
+  psim::StateFieldValued<psim::Integer> _sum;
+  psim::StateField<psim::Integer> const *_a;
+  psim::StateField<psim::Integer> const *_b;
+
+ public:
+  Sink(psim::RandomsGenerator &randoms, psim::Configuration const &config,
+      std::string const &name)
+    : Model(randoms), _sum(name, 0) {}
+
+  virtual void add_fields(psim::State &state) override {
+    state.add(&_sum);
+  }
+
+  virtual void get_fields(psim::State &state) override {
+    _a = get_field<psim::Integer>(state, "a.y");
+    _b = get_field<psim::Integer>(state, "b.y");
+  }
+
+  virtual void step() override {
+    this->psim::Model::step();
+    _sum.get() += _a->get() + _b->get();
+  }
+};
+
+/* Source drawing random numbers.
+ */
+class Noisy : public Source {
+ public:
+  using Source::Source;
+
+  virtual bool draws_randoms() const override {
+    return true;
+  }
+};
+
+/* Advances a clock by the number of base ticks between its steps.
+ */
+class Clock : public psim::Model {
+ private:
+  psim::StateFieldValued<psim::Integer> _t;
+
+ public:
+  Clock(psim::RandomsGenerator &randoms, psim::Configuration const &config,
+      std::string const &name)
+    : Model(randoms), _t(name, 0) {}
+
+  virtual void add_fields(psim::State &state) override {
+    state.add(&_t);
+  }
+
+  virtual void step() override {
+    this->psim::Model::step();
+    _t.get() += psim::Integer(ticks());
+  }
+};
+
+/* Integrates a writable input which is zero until written.
+ */
+class Plant : public psim::Model {
+ private:
+  psim::StateFieldValued<psim::Integer> _x;
+  psim::StateFieldValued<psim::Integer> _j;
+
+ public:
+  Plant(psim::RandomsGenerator &randoms, psim::Configuration const &config)
+    : Model(randoms), _x("plant.x", 0), _j("plant.j", 0) {}
+
+  virtual void add_fields(psim::State &state) override {
+    state.add(&_x);
+    state.add_writable(&_j);
+  }
+
+  virtual void step() override {
+    this->psim::Model::step();
+    _x.get() += _j.get();
+  }
+};
+
+/* Writes to the plant's input without adding any fields.
+ */
+class Actuator : public psim::Model {
+ private:
+  psim::StateFieldWritable<psim::Integer> *_j;
+
+ public:
+  Actuator(psim::RandomsGenerator &randoms, psim::Configuration const &config)
+    : Model(randoms) {}
+
+  virtual void get_fields(psim::State &state) override {
+    _j = get_writable_field<psim::Integer>(state, "plant.j");
+  }
+
+  virtual void step() override {
+    this->psim::Model::step();
+    _j->get() = 1;
+  }
+};
+
+class Actuated : public psim::ModelList {
+ public:
+  Actuated(psim::RandomsGenerator &randoms, psim::Configuration const &config)
+    : ModelList(randoms) {
+    add<Plant>(randoms, config);
+    add<Actuator>(randoms, config);
+    add<Source>(randoms, config, "a");
+  }
+};
+
+class Sources : public psim::ModelList {
+ public:
+  Sources(psim::RandomsGenerator &randoms, psim::Configuration const &config)
+    : ModelList(randoms) {
+    add<Source>(randoms, config, "a");
+    add<Source>(randoms, config, "b");
+    add<Sink>(randoms, config, "sum");
+    add<Source>(randoms, config, "c");
+    add<Sink>(randoms, config, "total");
+  }
+};
+
+class NoisySources : public psim::ModelList {
+ public:
+  NoisySources(psim::RandomsGenerator &randoms,
+      psim::Configuration const &config)
+    : ModelList(randoms) {
+    add<Noisy>(randoms, config, "a");
+    add<Source>(randoms, config, "b");
+    add<Noisy>(randoms, config, "c");
+  }
+};
+
+class NestedSources : public psim::ModelList {
+ public:
+  NestedSources(psim::RandomsGenerator &randoms,
+      psim::Configuration const &config)
+    : ModelList(randoms) {
+    add<Sources>(randoms, config);
+    add<Source>(randoms, config, "d");
+  }
+};
+
+class ScheduledSources : public psim::ModelList {
+ public:
+  ScheduledSources(psim::RandomsGenerator &randoms,
+      psim::Configuration const &config)
+    : ModelList(randoms) {
+    add<Source>(randoms, config, "a");
+    add<Source>(randoms, config, "b");
+    add<Sink>(randoms, config, "sum");
+    add<Clock>(randoms, config, "clock");
+    models()[1]->schedule(4, 1);
+    models()[3]->schedule(10);
+  }
+};
+
+class NestedScheduledSources : public psim::ModelList {
+ public:
+  NestedScheduledSources(psim::RandomsGenerator &randoms,
+      psim::Configuration const &config)
+    : ModelList(randoms) {
+    add<ScheduledSources>(randoms, config);
+    add<Clock>(randoms, config, "base");
+    models()[0]->schedule(2);
+  }
+};
+
+TEST(ModelList, TestGraph) {
+  auto const config =
+      psim::Configuration("test/psim/core/model_list_test_config.txt");
+  psim::Simulation<Sources> sim(config);
+
+  // Independent sources don't depend on each other but the sink must step
+  // after the sources it reads from
+  auto const &graph = sim.model().graph();
+  ASSERT_EQ(graph.size(), 5);
+  ASSERT_FALSE(graph.precedes(0, 1));
+  ASSERT_TRUE(graph.precedes(0, 2));
+  ASSERT_TRUE(graph.precedes(1, 2));
+  ASSERT_FALSE(graph.precedes(0, 3));
+  ASSERT_FALSE(graph.precedes(2, 3));
+  ASSERT_FALSE(graph.precedes(2, 4));
+}
+
+TEST(ModelList, TestGraphRandoms) {
+  auto const config =
+      psim::Configuration("test/psim/core/model_list_test_config.txt");
+  psim::Simulation<NoisySources> sim(config);
+
+  // Models drawing random numbers are always ordered
+  auto const &graph = sim.model().graph();
+  ASSERT_TRUE(sim.model().draws_randoms());
+  ASSERT_FALSE(graph.precedes(0, 1));
+  ASSERT_TRUE(graph.precedes(0, 2));
+  ASSERT_FALSE(graph.precedes(1, 2));
+}
+
+TEST(ModelList, TestParallelStep) {
+  auto const serial_config =
+      psim::Configuration("test/psim/core/model_list_test_config.txt");
+  auto const parallel_config =
+      psim::Configuration(std::vector<std::string>{
+          "test/psim/core/model_list_test_config.txt",
+          "test/psim/core/model_list_test_threads_config.txt"});
+  psim::Simulation<Sources> serial(serial_config);
+  psim::Simulation<Sources> parallel(parallel_config);
+
+  // Stepping concurrently gives the same results as stepping in series
+  serial.step(100);
+  parallel.step(100);
+  for (auto const &name : {"a.x", "b.y", "sum", "c.x", "total"})
+    ASSERT_EQ(serial[name].template get<psim::Integer>(),
+        parallel[name].template get<psim::Integer>());
+  ASSERT_EQ(parallel["sum"].template get<psim::Integer>(), 4 * 5050);
+  ASSERT_EQ(parallel["total"].template get<psim::Integer>(), 4 * 5050);
+
+  // Lazy fields read by both sinks are shared
+  auto const &y =
+      dynamic_cast<psim::StateFieldLazyBase const &>(parallel["a.y"]);
+  ASSERT_TRUE(y.shared());
+  ASSERT_EQ(y.misses(), 100);
+}
+
+TEST(ModelList, TestPrune) {
+  auto const config =
+      psim::Configuration("test/psim/core/model_list_test_config.txt");
+  psim::Simulation<Sources> full(config);
+  psim::Simulation<Sources> sim(config, {"sum"});
+
+  // Only the sink and the sources it reads from remain
+  auto const &graph = sim.model().graph();
+  ASSERT_EQ(graph.size(), 3);
+  ASSERT_FALSE(graph.precedes(0, 1));
+  ASSERT_TRUE(graph.precedes(0, 2));
+  ASSERT_TRUE(graph.precedes(1, 2));
+  ASSERT_TRUE(sim.has("a.x"));
+  ASSERT_TRUE(sim.has("b.y"));
+  ASSERT_FALSE(sim.has("c.x"));
+  ASSERT_FALSE(sim.has("total"));
+  ASSERT_EQ(sim.size(), 5);
+  ASSERT_EQ(sim.index("sum"), 4);
+
+  full.step(100);
+  sim.step(100);
+  ASSERT_EQ(sim["sum"].get<psim::Integer>(),
+      full["sum"].get<psim::Integer>());
+
+  // Forks are pruned the same way so checkpoints remain compatible
+  auto const fork = sim.fork(config);
+  ASSERT_FALSE(fork->has("c.x"));
+  ASSERT_EQ(fork->model().graph().size(), 3);
+  ASSERT_THROW(full.restore(sim.checkpoint()), std::runtime_error);
+
+  ASSERT_THROW(psim::Simulation<Sources>(config, {"missing"}),
+      std::runtime_error);
+
+  // Models writing to a kept model's writable fields are kept
+  psim::Simulation<Actuated> actuated_full(config);
+  psim::Simulation<Actuated> actuated(config, {"plant.x"});
+  ASSERT_EQ(actuated.model().graph().size(), 2);
+  ASSERT_FALSE(actuated.has("a.x"));
+
+  actuated_full.step(10);
+  actuated.step(10);
+  ASSERT_EQ(actuated["plant.x"].get<psim::Integer>(), 9);
+  ASSERT_EQ(actuated["plant.x"].get<psim::Integer>(),
+      actuated_full["plant.x"].get<psim::Integer>());
+}
+
+TEST(ModelList, TestPruneNested) {
+  auto const config =
+      psim::Configuration("test/psim/core/model_list_test_config.txt");
+
+  // Nested model lists are pruned model by model
+  psim::Simulation<NestedSources> sim(config, {"total", "d.x"});
+  ASSERT_EQ(sim.model().graph().size(), 2);
+  ASSERT_TRUE(sim.has("a.x"));
+  ASSERT_FALSE(sim.has("sum"));
+  ASSERT_FALSE(sim.has("c.y"));
+  sim.step(100);
+  ASSERT_EQ(sim["total"].get<psim::Integer>(), 4 * 5050);
+  ASSERT_EQ(sim["d.x"].get<psim::Integer>(), 100);
+
+  // As are model lists without any needed models
+  psim::Simulation<NestedSources> other(config, {"d.y"});
+  ASSERT_EQ(other.model().graph().size(), 1);
+  ASSERT_EQ(other.size(), 2);
+}
+
+TEST(ModelList, TestPruneRandoms) {
+  auto const config =
+      psim::Configuration("test/psim/core/model_list_test_config.txt");
+
+  // Models drawing random numbers are never pruned
+  psim::Simulation<NoisySources> sim(config, {"b.x"});
+  ASSERT_EQ(sim.model().graph().size(), 3);
+
+  psim::Simulation<NoisySources> other(config, {"a.x"});
+  ASSERT_EQ(other.model().graph().size(), 2);
+  ASSERT_FALSE(other.has("b.x"));
+}
+
+TEST(ModelList, TestSchedule) {
+  auto const serial_config =
+      psim::Configuration("test/psim/core/model_list_test_config.txt");
+  auto const parallel_config =
+      psim::Configuration(std::vector<std::string>{
+          "test/psim/core/model_list_test_config.txt",
+          "test/psim/core/model_list_test_threads_config.txt"});
+  psim::Simulation<ScheduledSources> serial(serial_config);
+  psim::Simulation<ScheduledSources> parallel(parallel_config);
+
+  auto const &b = serial.model().models()[1];
+  ASSERT_EQ(b->period(), 4);
+  ASSERT_EQ(b->phase(), 1);
+  ASSERT_EQ(b->ticks(), 4);
+  ASSERT_FALSE(b->scheduled(0));
+  ASSERT_TRUE(b->scheduled(5));
+
+  // Models only step on their ticks and the sink reads the last value of the
+  // slower source's lazy field in between
+  psim::Integer sum = 0;
+  for (psim::Integer tick = 0; tick < 100; tick++)
+    sum += 2 * (tick + 1) + 2 * (tick < 1 ? 0 : (tick - 1) / 4 + 1);
+
+  serial.step(100);
+  parallel.step(100);
+  for (auto *sim : {&serial, &parallel}) {
+    ASSERT_EQ((*sim)["a.x"].get<psim::Integer>(), 100);
+    ASSERT_EQ((*sim)["b.x"].get<psim::Integer>(), 25);
+    ASSERT_EQ((*sim)["sum"].get<psim::Integer>(), sum);
+    ASSERT_EQ((*sim)["clock"].get<psim::Integer>(), 100);
+  }
+
+  // The lazy field is evaluated once before the slower source first steps and
+  // once after each of its steps
+  ASSERT_EQ(dynamic_cast<psim::StateFieldLazyBase const &>(serial["b.y"])
+                .misses(), 26);
+
+  // Forks resume on the same tick. The test models don't checkpoint their
+  // fields so only the slower source's step after forking is counted.
+  auto const fork = serial.fork(serial_config);
+  serial.step(3);
+  fork->step(3);
+  ASSERT_EQ(serial["b.x"].get<psim::Integer>(), 26);
+  ASSERT_EQ((*fork)["b.x"].get<psim::Integer>(), 1);
+}
+
+TEST(ModelList, TestScheduleNested) {
+  auto const config =
+      psim::Configuration("test/psim/core/model_list_test_config.txt");
+  psim::Simulation<NestedScheduledSources> sim(config);
+
+  // Periods of enclosing model lists multiply
+  auto const *list =
+      dynamic_cast<psim::ModelList const *>(sim.model().models()[0]);
+  ASSERT_EQ(list->models()[3]->ticks(), 20);
+
+  sim.step(100);
+  ASSERT_EQ(sim["a.x"].get<psim::Integer>(), 50);
+  ASSERT_EQ(sim["clock"].get<psim::Integer>(), 100);
+  ASSERT_EQ(sim["base"].get<psim::Integer>(), 100);
+}
+
+TEST(ModelList, TestScheduleInvalid) {
+  auto const config =
+      psim::Configuration("test/psim/core/model_list_test_config.txt");
+  psim::RandomsGenerator randoms;
+  Source source(randoms, config, "a");
+
+  ASSERT_THROW(source.schedule(0), std::runtime_error);
+  ASSERT_THROW(source.schedule(2, 2), std::runtime_error);
+  ASSERT_EQ(source.ticks(), 1);
+}
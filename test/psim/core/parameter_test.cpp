@@ -73,3 +73,24 @@ TEST(Parameter, TestGet) {
     EXPECT_THROW(ptr->template get<psim::Integer>(), std::runtime_error);
   }
 }
+
+TEST(Parameter, TestTag) {
+  psim::Parameter<psim::Integer> integer(1);
+  psim::Parameter<psim::Vector3> vector;
+  psim::Parameter<psim::Vector<5>> untagged;
+
+  ASSERT_EQ(integer.tag(), psim::TypeTag::Integer);
+  ASSERT_EQ(vector.tag(), psim::TypeTag::Vector3);
+  ASSERT_EQ(untagged.tag(), psim::TypeTag::Unknown);
+
+  // Untagged types still support dynamic access
+  psim::ParameterBase const *ptr = &untagged;
+  EXPECT_NO_THROW(ptr->template cast<psim::Vector<5>>());
+  EXPECT_THROW(ptr->template cast<psim::Vector<4>>(), std::runtime_error);
+
+  // Copies keep their tag and cast to themselves
+  psim::Parameter<psim::Integer> const copy(integer);
+  ptr = &copy;
+  ASSERT_EQ(ptr->tag(), psim::TypeTag::Integer);
+  ASSERT_EQ(&ptr->template cast<psim::Integer>(), &copy);
+}
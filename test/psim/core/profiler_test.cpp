@@ -0,0 +1,248 @@
+/** @file test/psim/core/profiler_test.cpp
+ *  @author Kyle Krol
+ */
+
+#include <gtest/gtest.h>
+
+#include <psim/core/configuration.hpp>
+#include <psim/core/model.hpp>
+#include <psim/core/model_list.hpp>
+#include <psim/core/profiler.hpp>
+#include <psim/core/simulation.hpp>
+#include <psim/core/state.hpp>
+#include <psim/core/state_field_lazy.hpp>
+#include <psim/core/state_field_valued.hpp>
+#include <psim/core/types.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+/* Adds a counter and a lazy field with twice its value.
+ */
+class Producer : public psim::Model {
+ private:
+  psim::StateFieldValued<psim::Integer> _x;
+  psim::StateFieldLazy<psim::Integer> _y;
+
+ public:
+  Producer(psim::RandomsGenerator &randoms, psim::Configuration const &config)
+    : Model(randoms), _x("x", 0),
+      _y("y", [this]() { return 2 * _x.get(); }, &this->_epoch) {}
+
+  virtual void add_fields(psim::State &state) override {
+    state.add(&_x);
+    state.add(&_y);
+  }
+
+  virtual void step() override {
+    this->psim::Model::step();
+    _x.get() += 1;
+  }
+};
+
+/* Reads the producer's lazy field while stepping.
+ */
+class Consumer : public psim::Model {
+ private:
+  psim::StateFieldValued<psim::Integer> _sum;
+  psim::StateField<psim::Integer> const *_y;
+
+ public:
+  Consumer(psim::RandomsGenerator &randoms, psim::Configuration const &config)
+    : Model(randoms), _sum("sum", 0) {}
+
+  virtual void add_fields(psim::State &state) override {
+    state.add(&_sum);
+  }
+
+  virtual void get_fields(psim::State &state) override {
+    _y = get_field<psim::Integer>(state, "y");
+  }
+
+  virtual void step() override {
+    this->psim::Model::step();
+    _sum.get() += _y->get();
+  }
+};
+
+class Pipeline : public psim::ModelList {
+ public:
+  Pipeline(psim::RandomsGenerator &randoms, psim::Configuration const &config)
+    : ModelList(randoms) {
+    add<Producer>(randoms, config);
+    add<Consumer>(randoms, config);
+  }
+};
+
+/* Adds a counter named after its label.
+ */
+class Stage : public psim::Model {
+ private:
+  std::string const _satellite;
+  psim::StateFieldValued<psim::Integer> _n;
+
+ public:
+  Stage(psim::RandomsGenerator &randoms, std::string const &satellite)
+    : Model(randoms), _satellite(satellite), _n(satellite + ".n", 0) {}
+
+  virtual void add_fields(psim::State &state) override {
+    state.add(&_n);
+  }
+
+  virtual std::string label() const override {
+    return _satellite;
+  }
+
+  virtual void step() override {
+    this->psim::Model::step();
+    _n.get() += 1;
+  }
+};
+
+class Stages : public psim::ModelList {
+ public:
+  Stages(psim::RandomsGenerator &randoms, psim::Configuration const &config)
+    : ModelList(randoms) {
+    add<Stage>(randoms, "leader");
+    add<Stage>(randoms, "follower");
+  }
+};
+
+psim::Profiler::Summary const *find(
+    std::vector<psim::Profiler::Summary> const &summary,
+    std::string const &name) {
+  // Models are named after their demangled type
+  for (auto const &entry : summary)
+    if (entry.name == name || entry.name == "(anonymous namespace)::" + name)
+      return &entry;
+
+  return nullptr;
+}
+} // namespace
+
+TEST(Profiler, TestDisabled) {
+  auto const config =
+      psim::Configuration("test/psim/core/model_list_test_config.txt");
+  psim::Simulation<Pipeline> sim(config);
+
+  psim::Profiler::clear();
+  ASSERT_FALSE(psim::Profiler::enabled());
+  sim.step(3);
+  ASSERT_TRUE(psim::Profiler::events().empty());
+}
+
+TEST(Profiler, TestEvents) {
+  auto const config =
+      psim::Configuration("test/psim/core/model_list_test_config.txt");
+  psim::Simulation<Pipeline> sim(config);
+
+  psim::Profiler::clear();
+  psim::Profiler::enable();
+  sim.step(3);
+  psim::Profiler::disable();
+  sim.step(3);
+
+  auto const summary = psim::Profiler::summary();
+  ASSERT_EQ(summary.size(), 4);
+
+  auto const *pipeline = find(summary, "Pipeline");
+  auto const *producer = find(summary, "Producer");
+  auto const *consumer = find(summary, "Consumer");
+  auto const *y = find(summary, "y");
+  ASSERT_TRUE(pipeline && producer && consumer && y);
+  ASSERT_EQ(pipeline->calls, 3);
+  ASSERT_EQ(producer->calls, 3);
+  ASSERT_EQ(consumer->calls, 3);
+  ASSERT_EQ(y->calls, 3);
+  ASSERT_STREQ(y->category, "field");
+  ASSERT_STREQ(consumer->category, "model");
+
+  // Nested time is excluded from self time
+  ASSERT_LE(consumer->self, consumer->total);
+  ASSERT_GE(pipeline->total, producer->total + consumer->total);
+
+  // The lazy field is evaluated within the consumer's step
+  for (auto const &event : psim::Profiler::events()) {
+    if (event.name == "y")
+      ASSERT_EQ(event.depth, 2);
+    else if (event.name.find("Pipeline") != std::string::npos)
+      ASSERT_EQ(event.depth, 0);
+    else
+      ASSERT_EQ(event.depth, 1);
+  }
+
+  auto const report = psim::Profiler::report();
+  ASSERT_NE(report.find("Consumer"), std::string::npos);
+
+  psim::Profiler::clear();
+  ASSERT_TRUE(psim::Profiler::events().empty());
+}
+
+TEST(Profiler, TestInstances) {
+  auto const config =
+      psim::Configuration("test/psim/core/model_list_test_config.txt");
+  psim::Simulation<Stages> sim(config);
+
+  psim::Profiler::clear();
+  psim::Profiler::enable();
+  sim.step(3);
+  psim::Profiler::disable();
+
+  // Instances of the same type are summarized separately by label
+  auto const summary = psim::Profiler::summary();
+  ASSERT_EQ(summary.size(), 3);
+
+  auto const *leader = find(summary, "Stage (leader)");
+  auto const *follower = find(summary, "Stage (follower)");
+  ASSERT_TRUE(leader && follower);
+  ASSERT_EQ(leader->calls, 3);
+  ASSERT_EQ(follower->calls, 3);
+  psim::Profiler::clear();
+}
+
+TEST(Profiler, TestThreads) {
+  auto const config = psim::Configuration(std::vector<std::string>{
+      "test/psim/core/model_list_test_config.txt",
+      "test/psim/core/model_list_test_threads_config.txt"});
+  psim::Simulation<Pipeline> sim(config);
+
+  psim::Profiler::clear();
+  psim::Profiler::enable();
+  sim.step(100);
+  psim::Profiler::disable();
+
+  auto const summary = psim::Profiler::summary();
+  ASSERT_EQ(find(summary, "Producer")->calls, 100);
+  ASSERT_EQ(find(summary, "Consumer")->calls, 100);
+  ASSERT_EQ(find(summary, "y")->calls, 100);
+  psim::Profiler::clear();
+}
+
+TEST(Profiler, TestSave) {
+  auto const config =
+      psim::Configuration("test/psim/core/model_list_test_config.txt");
+  psim::Simulation<Pipeline> sim(config);
+
+  psim::Profiler::clear();
+  psim::Profiler::enable();
+  sim.step();
+  psim::Profiler::disable();
+
+  std::string const file = "profiler_test.json";
+  psim::Profiler::save(file);
+
+  std::ifstream ifs(file);
+  std::string const trace{std::istreambuf_iterator<char>(ifs),
+      std::istreambuf_iterator<char>()};
+  std::remove(file.c_str());
+
+  ASSERT_EQ(trace.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["), 0);
+  ASSERT_NE(trace.find("\"name\":\"y\",\"cat\":\"field\",\"ph\":\"X\""),
+      std::string::npos);
+  psim::Profiler::clear();
+}
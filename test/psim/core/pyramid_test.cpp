@@ -0,0 +1,125 @@
+/** @file test/psim/core/pyramid_test.cpp
+ *  @author Kyle Krol
+ */
+
+#include "counter.hpp"
+
+#include <gtest/gtest.h>
+
+#include <psim/core/configuration.hpp>
+#include <psim/core/pyramid.hpp>
+#include <psim/core/simulation.hpp>
+#include <psim/core/state.hpp>
+#include <psim/core/state_field_valued.hpp>
+#include <psim/core/types.hpp>
+
+#include <stdexcept>
+
+TEST(Pyramid, TestLevels) {
+  psim::StateFieldValued<psim::Integer> field0("field0", 0);
+  psim::StateFieldValued<psim::Vector2> field1("field1", {0.0, 0.0});
+
+  psim::State state;
+  state.add(&field0);
+  state.add(&field1);
+
+  psim::Pyramid pyramid(state, {"field0", "field1"}, 2, 3, 3);
+  ASSERT_EQ(pyramid.columns().size(), 3);
+  ASSERT_EQ(pyramid.levels(), 3);
+  ASSERT_EQ(pyramid.bucket(0), 2);
+  ASSERT_EQ(pyramid.bucket(2), 18);
+
+  // A single spike on the twentieth sample
+  for (psim::Integer i = 0; i < 40; i++) {
+    field0.get() = i;
+    field1.get()(1) = (i == 20) ? 100.0 : 0.0;
+    pyramid.record();
+  }
+
+  ASSERT_EQ(pyramid.size(), 40);
+  ASSERT_EQ(pyramid.size(0), 20);
+  ASSERT_EQ(pyramid.size(1), 6);
+  ASSERT_EQ(pyramid.size(2), 2);
+
+  ASSERT_EQ(pyramid.min("field0", 0)[3], 6.0);
+  ASSERT_EQ(pyramid.max("field0", 0)[3], 7.0);
+  ASSERT_EQ(pyramid.mean("field0", 0)[3], 6.5);
+  ASSERT_EQ(pyramid.min("field0", 1)[1], 6.0);
+  ASSERT_EQ(pyramid.max("field0", 1)[1], 11.0);
+  ASSERT_EQ(pyramid.mean("field0", 2)[1], 26.5);
+
+  // The spike survives on every level
+  ASSERT_EQ(pyramid.max("field1.y", 0)[10], 100.0);
+  ASSERT_EQ(pyramid.max("field1.y", 1)[3], 100.0);
+  ASSERT_EQ(pyramid.max("field1.y", 2)[1], 100.0);
+  ASSERT_EQ(pyramid.min("field1.y", 2)[1], 0.0);
+  ASSERT_EQ(pyramid.max("field1.y", 2)[0], 0.0);
+
+  ASSERT_EQ(pyramid.select(40, 20), 0);
+  ASSERT_EQ(pyramid.select(40, 7), 1);
+  ASSERT_EQ(pyramid.select(40, 1), 2);
+
+  EXPECT_THROW(pyramid.min("field1", 0), std::runtime_error);
+  EXPECT_THROW(pyramid.min("field0", 3), std::runtime_error);
+  EXPECT_THROW(psim::Pyramid(state, {"field2"}), std::runtime_error);
+  EXPECT_THROW(psim::Pyramid(state, {"field0", "field0"}), std::runtime_error);
+  EXPECT_THROW(psim::Pyramid(state, {"field0"}, 0), std::runtime_error);
+  EXPECT_THROW(psim::Pyramid(state, {"field0"}, 2, 1), std::runtime_error);
+  EXPECT_THROW(psim::Pyramid(state, {"field0"}, 2, 2, 0), std::runtime_error);
+}
+
+TEST(Pyramid, TestClose) {
+  psim::StateFieldValued<psim::Integer> field("field", 0);
+
+  psim::State state;
+  state.add(&field);
+
+  psim::Pyramid pyramid(state, {"field"}, 2, 3, 3);
+  for (psim::Integer i = 0; i < 25; i++) {
+    field.get() = i;
+    pyramid.record();
+  }
+
+  // Only complete buckets are visible while recording
+  ASSERT_EQ(pyramid.size(0), 12);
+  ASSERT_EQ(pyramid.size(1), 4);
+  ASSERT_EQ(pyramid.size(2), 1);
+  ASSERT_EQ(pyramid.select(25, 12), 0);
+
+  // Closing flushes the trailing samples into every level
+  pyramid.close();
+  ASSERT_EQ(pyramid.size(0), 13);
+  ASSERT_EQ(pyramid.size(1), 5);
+  ASSERT_EQ(pyramid.size(2), 2);
+  ASSERT_EQ(pyramid.mean("field", 0)[12], 24.0);
+  ASSERT_EQ(pyramid.min("field", 1)[4], 24.0);
+  ASSERT_EQ(pyramid.mean("field", 1)[4], 24.0);
+  ASSERT_EQ(pyramid.min("field", 2)[1], 18.0);
+  ASSERT_EQ(pyramid.max("field", 2)[1], 24.0);
+  ASSERT_EQ(pyramid.mean("field", 2)[1], 21.0);
+  ASSERT_EQ(pyramid.select(25, 12), 1);
+  ASSERT_EQ(pyramid.select(25, 2), 2);
+
+  pyramid.close();
+  ASSERT_EQ(pyramid.size(0), 13);
+  EXPECT_THROW(pyramid.record(), std::runtime_error);
+}
+
+TEST(Pyramid, TestSimulation) {
+  auto const config =
+      psim::Configuration("test/psim/core/simulation_test_config.txt");
+  psim::Simulation<Counter> sim(config);
+
+  auto const pyramid = sim.pyramid({"n"}, 2, 2, 2, 2);
+  sim.step(9);
+
+  // Samples are taken on even steps
+  ASSERT_EQ(pyramid->size(), 4);
+  ASSERT_EQ(pyramid->size(1), 1);
+  ASSERT_EQ(pyramid->mean("n", 0)[1], 7.0);
+  ASSERT_EQ(pyramid->mean("n", 1)[0], 5.0);
+
+  sim.detach(pyramid);
+  sim.step(2);
+  ASSERT_EQ(pyramid->size(), 4);
+}
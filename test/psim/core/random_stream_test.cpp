@@ -0,0 +1,76 @@
+/** @file test/psim/core/random_stream_test.cpp
+ *  @author Kyle Krol
+ */
+
+#include <gtest/gtest.h>
+
+#include <psim/core/random_stream.hpp>
+#include <psim/core/types.hpp>
+
+#include <cmath>
+#include <cstddef>
+
+TEST(RandomStream, TestPhilox) {
+  using Key = psim::RandomStream::Key;
+  using Block = psim::RandomStream::Block;
+
+  // Known answer tests from the Random123 library
+  ASSERT_EQ(psim::RandomStream::philox(Key{{0, 0}}, Block{{0, 0, 0, 0}}),
+      (Block{{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}}));
+  ASSERT_EQ(psim::RandomStream::philox(Key{{0xffffffff, 0xffffffff}},
+                Block{{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}}),
+      (Block{{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}}));
+  ASSERT_EQ(psim::RandomStream::philox(Key{{0xa4093822, 0x299f31d0}},
+                Block{{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}}),
+      (Block{{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}}));
+}
+
+TEST(RandomStream, TestReproducible) {
+  std::size_t epoch = 0;
+  psim::RandomStream a(1, "model", "noise", &epoch);
+  psim::RandomStream b(1, "model", "noise", &epoch);
+  psim::RandomStream c(1, "model", "other", &epoch);
+  psim::RandomStream d(2, "model", "noise", &epoch);
+
+  // Identical keys draw identical numbers, anything else differs
+  auto const x = a.gaussian();
+  ASSERT_EQ(b.gaussian(), x);
+  ASSERT_NE(c.gaussian(), x);
+  ASSERT_NE(d.gaussian(), x);
+
+  // Draws within a step differ
+  ASSERT_NE(a.gaussian(), x);
+
+  // The counter restarts each step regardless of how many draws were made
+  epoch++;
+  psim::RandomStream e(1, "model", "noise", &epoch);
+  ASSERT_EQ(e.rand(), a.rand());
+}
+
+TEST(RandomStream, TestDistribution) {
+  psim::RandomStream stream(0, "model", "noise");
+
+  std::size_t const n = 100000;
+  psim::Real sum = 0.0, sum_squares = 0.0;
+  for (std::size_t i = 0; i < n; i++) {
+    auto const u = stream.rand();
+    ASSERT_GT(u, 0.0);
+    ASSERT_LT(u, 1.0);
+
+    auto const x = stream.gaussian();
+    sum += x;
+    sum_squares += x * x;
+  }
+
+  ASSERT_NEAR(sum / n, 0.0, 0.02);
+  ASSERT_NEAR(sum_squares / n, 1.0, 0.02);
+}
+
+TEST(RandomStream, TestGaussians) {
+  psim::RandomStream stream(0, "model", "noise");
+
+  auto const v = stream.gaussians<psim::Vector3>();
+  ASSERT_NE(v(0), v(1));
+  ASSERT_NE(v(1), v(2));
+  ASSERT_TRUE(std::isfinite(v(0)));
+}
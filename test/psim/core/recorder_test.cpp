@@ -0,0 +1,150 @@
+/** @file test/psim/core/recorder_test.cpp
+ *  @author Kyle Krol
+ */
+
+#include "counter.hpp"
+
+#include <gtest/gtest.h>
+
+#include <psim/core/configuration.hpp>
+#include <psim/core/recorder.hpp>
+#include <psim/core/simulation.hpp>
+#include <psim/core/state.hpp>
+#include <psim/core/state_field_valued.hpp>
+#include <psim/core/types.hpp>
+
+#include <stdexcept>
+
+TEST(Recorder, TestColumns) {
+  psim::StateFieldValued<psim::Boolean> field0("field0", true);
+  psim::StateFieldValued<psim::Integer> field1("field1", 1);
+  psim::StateFieldValued<psim::Vector3> field2("field2", {1.0, 2.0, 3.0});
+
+  psim::State state;
+  state.add(&field0);
+  state.add(&field1);
+  state.add(&field2);
+
+  psim::Recorder recorder(state, {"field0", "field1", "field2"});
+  ASSERT_EQ(recorder.columns().size(), 5);
+  ASSERT_TRUE(recorder.has("field2.z"));
+  ASSERT_FALSE(recorder.has("field2"));
+  ASSERT_TRUE(recorder.is_integer("field1"));
+  ASSERT_FALSE(recorder.is_integer("field0"));
+
+  recorder.record();
+  field1.get() = 2;
+  field2.get()(2) = 4.0;
+  recorder.record();
+
+  ASSERT_EQ(recorder.size(), 2);
+  ASSERT_EQ(recorder.reals("field0")[0], 1.0);
+  ASSERT_EQ(recorder.integers("field1")[0], 1);
+  ASSERT_EQ(recorder.integers("field1")[1], 2);
+  ASSERT_EQ(recorder.reals("field2.x")[1], 1.0);
+  ASSERT_EQ(recorder.reals("field2.z")[0], 3.0);
+  ASSERT_EQ(recorder.reals("field2.z")[1], 4.0);
+
+  EXPECT_THROW(recorder.reals("field1"), std::runtime_error);
+  EXPECT_THROW(recorder.integers("field0"), std::runtime_error);
+  EXPECT_THROW(
+      psim::Recorder(state, {"field0", "field0"}), std::runtime_error);
+  EXPECT_THROW(psim::Recorder(state, {"field3"}), std::runtime_error);
+  EXPECT_THROW(psim::Recorder(state, {"field0"}, 0), std::runtime_error);
+
+  recorder.clear();
+  ASSERT_EQ(recorder.size(), 0);
+}
+
+TEST(Recorder, TestBuffers) {
+  psim::StateFieldValued<psim::Integer> n("n", 0);
+  psim::StateFieldValued<psim::Real> x("x", 0.0);
+
+  psim::State state;
+  state.add(&n);
+  state.add(&x);
+
+  psim::Recorder recorder(state, {"n", "x"}, 1, 2);
+  recorder.record();
+  n.get() = 1;
+  recorder.record();
+
+  // Buffers are shared rather than copied
+  auto const buffer = recorder.integer_buffer("n");
+  ASSERT_EQ(buffer, recorder.integer_buffer("n"));
+  ASSERT_EQ(buffer->data(), recorder.integers("n"));
+  ASSERT_EQ(recorder.real_buffer("x")->data(), recorder.reals("x"));
+  EXPECT_THROW(recorder.real_buffer("n"), std::runtime_error);
+  EXPECT_THROW(recorder.integer_buffer("x"), std::runtime_error);
+
+  // Held buffers aren't reallocated when full
+  auto const *data = buffer->data();
+  n.get() = 2;
+  recorder.record();
+  ASSERT_EQ(buffer->data(), data);
+  ASSERT_EQ(buffer->size(), 2);
+  ASSERT_NE(recorder.integers("n"), data);
+  ASSERT_EQ(recorder.integers("n")[1], 1);
+  ASSERT_EQ(recorder.integers("n")[2], 2);
+
+  // Nor are they overwritten after clearing
+  auto const held = recorder.integer_buffer("n");
+  recorder.clear();
+  n.get() = 3;
+  recorder.record();
+  ASSERT_EQ((*held)[0], 0);
+  ASSERT_EQ(recorder.integers("n")[0], 3);
+
+  // Unshared buffers are reused in place
+  auto const *reused = recorder.reals("x");
+  recorder.clear();
+  recorder.record();
+  ASSERT_EQ(recorder.reals("x"), reused);
+}
+
+TEST(Recorder, TestSimulation) {
+  auto const config =
+      psim::Configuration("test/psim/core/simulation_test_config.txt");
+  psim::Simulation<Counter> sim(config);
+
+  auto const recorder = sim.record({"n"}, 2, 8);
+  for (auto i = 0; i < 7; i++)
+    sim.step();
+
+  // Samples are taken on the second, fourth, and sixth steps
+  ASSERT_EQ(recorder->size(), 3);
+  ASSERT_EQ(recorder->integers("n")[0], 2);
+  ASSERT_EQ(recorder->integers("n")[2], 6);
+
+  sim.detach(recorder);
+  sim.step();
+  ASSERT_EQ(recorder->size(), 3);
+}
+
+TEST(Recorder, TestGather) {
+  psim::StateFieldValued<psim::Integer> a0("a", 1), a1("a", 2);
+  psim::StateFieldValued<psim::Real> b0("b", 1.0), b1("b", 2.0);
+  psim::StateFieldValued<psim::Boolean> c("a", true);
+
+  psim::State state0, state1, state2, state3;
+  state0.add(&a0);
+  state0.add(&b0);
+  state1.add(&a1);
+  state1.add(&b1);
+  state2.add(&a1);
+  state3.add(&c);
+  state3.add(&b1);
+
+  // Fields are looked up by name in the other states
+  psim::Recorder recorder(state0, {"a", "b"});
+  recorder.record(state1);
+  recorder.record(state0);
+  ASSERT_EQ(recorder.size(), 2);
+  ASSERT_EQ(recorder.integers("a")[0], 2);
+  ASSERT_EQ(recorder.reals("b")[1], 1.0);
+
+  // Missing or mistyped fields don't record partial samples
+  EXPECT_THROW(recorder.record(state2), std::runtime_error);
+  EXPECT_THROW(recorder.record(state3), std::runtime_error);
+  ASSERT_EQ(recorder.size(), 2);
+}
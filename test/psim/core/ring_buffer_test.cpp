@@ -0,0 +1,96 @@
+/** @file test/psim/core/ring_buffer_test.cpp
+ *  @author Kyle Krol
+ */
+
+#include <gtest/gtest.h>
+
+#include <psim/core/ring_buffer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST(RingBuffer, TestPushPop) {
+  psim::RingBuffer<int> ring(3, 2);
+  ASSERT_EQ(ring.capacity(), 4);
+  ASSERT_EQ(ring.width(), 2);
+  ASSERT_EQ(ring.size(), 0);
+
+  int rows[8];
+  ASSERT_EQ(ring.pop(rows), 0);
+
+  for (int i = 0; i < 4; i++) {
+    int const row[2] = {i, -i};
+    ASSERT_TRUE(ring.push(row));
+  }
+  int const row[2] = {4, -4};
+  ASSERT_FALSE(ring.push(row));
+  ASSERT_EQ(ring.size(), 4);
+
+  ASSERT_EQ(ring.pop(rows, 3), 3);
+  ASSERT_EQ(rows[0], 0);
+  ASSERT_EQ(rows[5], -2);
+
+  // The oldest row is dropped once full
+  ASSERT_FALSE(ring.push_overwrite(row));
+  ASSERT_FALSE(ring.push_overwrite(row));
+  ASSERT_FALSE(ring.push_overwrite(row));
+  ASSERT_TRUE(ring.push_overwrite(row));
+  ASSERT_EQ(ring.pop(rows, 8), 4);
+  ASSERT_EQ(rows[0], 4);
+
+  EXPECT_THROW(psim::RingBuffer<int>(0), std::runtime_error);
+  EXPECT_THROW(psim::RingBuffer<int>(1, 0), std::runtime_error);
+}
+
+/* Every row holds a sequence number in each element so torn or reordered rows
+ * are detected by the consumer.
+ */
+static void test_concurrent(bool overwrite) {
+  constexpr std::size_t width = 4;
+  constexpr std::uint64_t n = 200000;
+  psim::RingBuffer<std::uint64_t> ring(64, width);
+
+  std::thread producer([&]() {
+    for (std::uint64_t i = 1; i <= n; i++) {
+      std::uint64_t const row[width] = {i, i, i, i};
+      if (overwrite)
+        ring.push_overwrite(row);
+      else
+        while (!ring.push(row))
+          std::this_thread::yield();
+    }
+  });
+
+  std::uint64_t last = 0, count = 0;
+  std::vector<std::uint64_t> rows(16 * width);
+  while (last != n) {
+    auto const popped = ring.pop(rows.data(), 16);
+    if (popped == 0)
+      std::this_thread::yield();
+
+    for (std::size_t i = 0; i < popped; i++) {
+      for (std::size_t j = 0; j < width; j++)
+        ASSERT_EQ(rows[i * width + j], rows[i * width]);
+      ASSERT_GT(rows[i * width], last);
+      last = rows[i * width];
+      count++;
+    }
+  }
+  producer.join();
+
+  if (overwrite)
+    ASSERT_LE(count, n);
+  else
+    ASSERT_EQ(count, n);
+}
+
+TEST(RingBuffer, TestConcurrent) {
+  test_concurrent(false);
+}
+
+TEST(RingBuffer, TestConcurrentOverwrite) {
+  test_concurrent(true);
+}
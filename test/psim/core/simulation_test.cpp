@@ -10,6 +10,10 @@
 #include <psim/core/simulation.hpp>
 #include <psim/core/types.hpp>
 
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 TEST(Simulation, TestStep) {
   auto const config =
       psim::Configuration("test/psim/core/simulation_test_config.txt");
@@ -23,3 +27,42 @@ TEST(Simulation, TestStep) {
   sim.step();
   ASSERT_EQ(sim["n"].template get<psim::Integer>(), 1);
 }
+
+TEST(Simulation, TestResolve) {
+  auto const config =
+      psim::Configuration("test/psim/core/simulation_test_config.txt");
+  psim::Simulation<Counter> sim(config);
+
+  // The state is frozen once the simulation is constructed
+  ASSERT_TRUE(sim.is_frozen());
+
+  auto const n = sim.resolve<psim::Integer>("n");
+  auto const dn = sim.resolve_writable<psim::Integer>("dn");
+
+  dn.get() = 2;
+  sim.step();
+  ASSERT_EQ(n.get(), 2);
+  ASSERT_EQ(sim.at(n.index()).template get<psim::Integer>(), 2);
+}
+
+TEST(Simulation, TestStepUntil) {
+  auto const config =
+      psim::Configuration("test/psim/core/simulation_test_config.txt");
+  psim::Simulation<Counter> sim(config);
+
+  using Expressions = std::vector<std::string>;
+
+  sim.step(3);
+  ASSERT_EQ(sim["n"].template get<psim::Integer>(), 3);
+
+  // The first satisfied condition is reported
+  ASSERT_EQ(sim.step_until(Expressions{"n >= 10", "n >= 7"}), 1);
+  ASSERT_EQ(sim["n"].template get<psim::Integer>(), 7);
+
+  // The simulation is always stepped at least once
+  ASSERT_EQ(sim.step_until(Expressions{"n >= 0"}), 0);
+  ASSERT_EQ(sim["n"].template get<psim::Integer>(), 8);
+
+  ASSERT_THROW(sim.step_until(Expressions{}), std::runtime_error);
+  ASSERT_THROW(sim.step_until(Expressions{"m >= 0"}), std::runtime_error);
+}
@@ -0,0 +1,72 @@
+/** @file test/psim/core/state_field_lazy_member_test.cpp
+ *  @author Kyle Krol
+ */
+
+#include <gtest/gtest.h>
+
+#include <psim/core/state_field.hpp>
+#include <psim/core/state_field_lazy_member.hpp>
+#include <psim/core/types.hpp>
+
+#include <cstddef>
+
+namespace {
+
+struct Doubler {
+  psim::Real value = 1.0;
+  std::size_t mutable calls = 0;
+
+  psim::Real doubled() const {
+    calls++;
+    return 2.0 * value;
+  }
+};
+
+struct DoublerEvaluator {
+  psim::Real operator()(Doubler const &model) const {
+    return model.doubled();
+  }
+};
+
+using Field = psim::StateFieldLazyMember<psim::Real, Doubler, DoublerEvaluator>;
+
+} // namespace
+
+TEST(StateFieldLazyMember, TestConstructorAndGet) {
+  std::size_t epoch = 0;
+  Doubler model;
+  Field field("default", model, epoch);
+
+  ASSERT_STREQ(field.name().c_str(), "default");
+  ASSERT_STREQ(field.type().c_str(), "state_field_lazy");
+  ASSERT_EQ(field.get(), 2.0);
+  ASSERT_EQ(field.tag(), psim::TypeTag::Real);
+
+  // Reads through the generic interface share the cached value
+  psim::StateField<psim::Real> const &base = field;
+  ASSERT_EQ(base.get(), 2.0);
+  ASSERT_EQ(model.calls, 1);
+}
+
+TEST(StateFieldLazyMember, TestEpoch) {
+  std::size_t epoch = 0;
+  Doubler model;
+  Field field("default", model, epoch);
+
+  // Ensure the first evaluation returns the expected value
+  ASSERT_EQ(field.get(), 2.0 * 1.0);
+
+  // Change underlying value but ensure the field evaluation is cached
+  model.value = 2.0;
+  ASSERT_EQ(field.get(), 2.0 * 1.0);
+
+  // Ensure the underlying value is updated once the epoch advances
+  epoch++;
+  ASSERT_EQ(field.get(), 2.0 * 2.0);
+
+  // Manual resets are still respected
+  model.value = 3.0;
+  field.reset();
+  ASSERT_EQ(field.get(), 2.0 * 3.0);
+  ASSERT_EQ(model.calls, 3);
+}
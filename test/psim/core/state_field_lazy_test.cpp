@@ -4,9 +4,13 @@
 
 #include <gtest/gtest.h>
 
+#include <psim/core/dependencies.hpp>
 #include <psim/core/state_field_lazy.hpp>
+#include <psim/core/state_field_valued.hpp>
 #include <psim/core/types.hpp>
 
+#include <cstddef>
+
 TEST(StateFieldLazy, TestConstructorAndGet) {
   psim::StateFieldLazy<psim::Real> field("default", []() { return 1.0; });
 
@@ -31,3 +35,106 @@ TEST(StateFieldLazy, TestReset) {
   field.reset();
   ASSERT_EQ(field.get(), 2.0 * 2.0);
 }
+
+TEST(StateFieldLazy, TestEpoch) {
+  std::size_t epoch = 0;
+  auto value = 1.0;
+  psim::StateFieldLazy<psim::Real> field(
+      "default", [&]() { return 2.0 * value; }, &epoch);
+
+  // Ensure the first evaluation returns the expected value
+  ASSERT_EQ(field.get(), 2.0 * 1.0);
+
+  // Change underlying value but ensure the field evaluation is cached
+  value = 2.0;
+  ASSERT_EQ(field.get(), 2.0 * 1.0);
+
+  // Ensure the underlying value is updated once the epoch advances
+  epoch++;
+  ASSERT_EQ(field.get(), 2.0 * 2.0);
+
+  // Manual resets are still respected
+  value = 3.0;
+  field.reset();
+  ASSERT_EQ(field.get(), 2.0 * 3.0);
+}
+
+TEST(StateFieldLazy, TestMemoized) {
+  psim::StateFieldValued<psim::Real> x("x", 1.0);
+
+  // Memoized field depending on a valued field
+  psim::StateFieldLazy<psim::Real> y(
+      "y", [&]() { return 2.0 * x.get(); }, nullptr, true);
+
+  // Memoized field depending on another lazy field
+  psim::StateFieldLazy<psim::Real> z(
+      "z", [&]() { return y.get() + 1.0; }, nullptr, true);
+
+  ASSERT_EQ(z.get(), 3.0);
+  ASSERT_EQ(y.get(), 2.0);
+  ASSERT_EQ(y.hits(), 1);
+  ASSERT_EQ(y.misses(), 1);
+
+  // Values are reused as long as the dependencies don't change
+  ASSERT_EQ(z.get(), 3.0);
+  ASSERT_EQ(z.hits(), 1);
+  ASSERT_EQ(z.misses(), 1);
+
+  // Non-constant reads and writes of the same value aren't changes
+  ASSERT_EQ(x.get(), 1.0);
+  x.get() = 1.0;
+  ASSERT_EQ(z.get(), 3.0);
+  ASSERT_EQ(y.misses(), 1);
+  ASSERT_EQ(z.misses(), 1);
+
+  // Writes propagate through the chain of dependencies
+  x.get() = 2.0;
+  ASSERT_EQ(z.get(), 5.0);
+  ASSERT_EQ(y.misses(), 2);
+  ASSERT_EQ(z.misses(), 2);
+}
+
+TEST(StateFieldLazy, TestRecording) {
+  psim::StateFieldValued<psim::Real> const x("x", 1.0);
+  psim::Dependencies dependencies;
+
+  // Reads outside of a recording scope aren't recorded
+  ASSERT_FALSE(psim::Dependencies::recording());
+  x.get();
+  ASSERT_EQ(dependencies.size(), 0);
+
+  {
+    psim::Dependencies::Scope const scope(&dependencies);
+    ASSERT_TRUE(psim::Dependencies::recording());
+    x.get();
+
+    // Suspended scopes don't record either
+    psim::Dependencies::Scope const suspended(nullptr);
+    ASSERT_FALSE(psim::Dependencies::recording());
+    x.get();
+  }
+
+  ASSERT_FALSE(psim::Dependencies::recording());
+  ASSERT_EQ(dependencies.size(), 1);
+}
+
+TEST(StateFieldLazy, TestMemoizedEpoch) {
+  std::size_t epoch = 0;
+  auto value = 1.0;
+
+  // Memoized field depending on an epoch based lazy field
+  psim::StateFieldLazy<psim::Real> x("x", [&]() { return value; }, &epoch);
+  psim::StateFieldLazy<psim::Real> y(
+      "y", [&]() { return 2.0 * x.get(); }, nullptr, true);
+
+  ASSERT_EQ(y.get(), 2.0);
+
+  value = 2.0;
+  ASSERT_EQ(y.get(), 2.0);
+  ASSERT_EQ(y.hits(), 1);
+
+  // Advancing the epoch invalidates the dependency
+  epoch++;
+  ASSERT_EQ(y.get(), 4.0);
+  ASSERT_EQ(y.misses(), 2);
+}
@@ -214,3 +214,32 @@ TEST(StateField, TestGetWritable) {
     }
   }
 }
+
+TEST(StateField, TestTag) {
+  psim::StateFieldValued<psim::Boolean> boolean("boolean");
+  psim::StateFieldLazy<psim::Real> real("real", []() { return 1.0; });
+  psim::StateFieldValued<psim::Vector<5>> untagged("untagged");
+
+  // Tags are filled in by the underlying type
+  {
+    psim::StateFieldBase const *ptr = &boolean;
+    ASSERT_EQ(ptr->tag(), psim::TypeTag::Boolean);
+    ASSERT_EQ(static_cast<psim::StateFieldWritableBase &>(boolean).tag(),
+        psim::TypeTag::Boolean);
+
+    ptr = &real;
+    ASSERT_EQ(ptr->tag(), psim::TypeTag::Real);
+    EXPECT_THROW(ptr->template cast_writable<psim::Real>(), std::runtime_error);
+
+    ptr = &untagged;
+    ASSERT_EQ(ptr->tag(), psim::TypeTag::Unknown);
+  }
+
+  // Untagged types still support dynamic access
+  {
+    psim::StateFieldBase *ptr = &untagged;
+    EXPECT_NO_THROW(ptr->template cast<psim::Vector<5>>());
+    EXPECT_NO_THROW(ptr->template cast_writable<psim::Vector<5>>());
+    EXPECT_THROW(ptr->template cast<psim::Vector<4>>(), std::runtime_error);
+  }
+}
@@ -62,3 +62,93 @@ TEST_F(State, TestBracketsOperator) {
   ASSERT_EQ(&state["field4"], &field4);
   EXPECT_THROW(state["field5"], std::runtime_error);
 }
+
+TEST_F(State, TestFreeze) {
+  psim::StateFieldValued<psim::Real> field5("field5");
+
+  ASSERT_FALSE(state.is_frozen());
+  EXPECT_THROW(state.index("field0"), std::runtime_error);
+
+  state.freeze();
+  ASSERT_TRUE(state.is_frozen());
+  ASSERT_EQ(state.size(), 5);
+  EXPECT_THROW(state.add(&field5), std::runtime_error);
+  EXPECT_THROW(state.add_writable(&field5), std::runtime_error);
+}
+
+TEST_F(State, TestIndex) {
+  state.freeze();
+
+  ASSERT_EQ(state.index("field0"), 0);
+  ASSERT_EQ(state.index("field4"), 4);
+  EXPECT_THROW(state.index("field5"), std::runtime_error);
+
+  ASSERT_EQ(&state.at(0), &field0);
+  ASSERT_EQ(&state.at(4), &field4);
+  EXPECT_THROW(state.at(5), std::runtime_error);
+
+  ASSERT_EQ(state.at_writable(0), nullptr);
+  ASSERT_EQ(state.at_writable(4), &field4);
+  EXPECT_THROW(state.at_writable(5), std::runtime_error);
+}
+
+TEST_F(State, TestRemove) {
+  psim::StateFieldValued<psim::Real> field5("field1");
+
+  state.remove(&field1);
+  state.remove(&field3);
+  ASSERT_FALSE(state.has("field1"));
+  ASSERT_FALSE(state.has_writable("field3"));
+  ASSERT_EQ(state.size(), 3);
+
+  // Only the registered field can be removed
+  EXPECT_THROW(state.remove(&field1), std::runtime_error);
+  state.add(&field5);
+  EXPECT_THROW(state.remove(&field1), std::runtime_error);
+
+  state.freeze();
+  ASSERT_EQ(state.index("field2"), 1);
+  ASSERT_EQ(state.index("field4"), 2);
+  ASSERT_EQ(state.at_writable(2), &field4);
+  ASSERT_EQ(state.index("field1"), 3);
+  EXPECT_THROW(state.remove(&field0), std::runtime_error);
+}
+
+TEST_F(State, TestResolve) {
+  state.freeze();
+
+  // Readable handles
+  {
+    auto const handle = state.resolve<psim::Real>("field1");
+    ASSERT_TRUE(handle);
+    ASSERT_EQ(handle.index(), 1);
+
+    field1.get() = 2.0;
+    ASSERT_EQ(handle.get(), 2.0);
+
+    EXPECT_THROW(state.resolve<psim::Integer>("field1"), std::runtime_error);
+    EXPECT_THROW(state.resolve<psim::Real>("field5"), std::runtime_error);
+  }
+
+  // Writable handles
+  {
+    auto const handle = state.resolve_writable<psim::Real>("field3");
+    ASSERT_TRUE(handle);
+    ASSERT_EQ(handle.index(), 3);
+
+    handle.get() = 3.0;
+    ASSERT_EQ(field3.get(), 3.0);
+
+    EXPECT_THROW(
+        state.resolve_writable<psim::Real>("field1"), std::runtime_error);
+    EXPECT_THROW(
+        state.resolve_writable<psim::Integer>("field3"), std::runtime_error);
+  }
+
+  // Default constructed handles are invalid
+  {
+    psim::FieldHandle<psim::Real> handle;
+    ASSERT_FALSE(handle);
+    EXPECT_THROW(handle.field(), std::runtime_error);
+  }
+}
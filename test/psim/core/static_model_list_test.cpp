@@ -0,0 +1,200 @@
+/** @file test/psim/core/static_model_list_test.cpp
+ *  @author Kyle Krol
+ */
+
+#include <gtest/gtest.h>
+
+#include <psim/core/configuration.hpp>
+#include <psim/core/model.hpp>
+#include <psim/core/model_list.hpp>
+#include <psim/core/simulation.hpp>
+#include <psim/core/state.hpp>
+#include <psim/core/state_field_lazy.hpp>
+#include <psim/core/state_field_valued.hpp>
+#include <psim/core/static_model_list.hpp>
+#include <psim/core/types.hpp>
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+/* Adds a counter and a lazy field with the counter's value plus an offset.
+ */
+class Ticker : public psim::Model {
+ private:
+  psim::StateFieldValued<psim::Integer> _x;
+  psim::StateFieldLazy<psim::Integer> _y;
+  psim::Integer const _offset;
+
+ public:
+  Ticker(psim::RandomsGenerator &randoms, psim::Configuration const &config,
+      std::string const &name, psim::Integer offset)
+    : Model(randoms), _x(name + ".x", 0),
+      _y(name + ".y", [this]() { return _x.get() + _offset; }, &this->_epoch),
+      _offset(offset) {}
+
+  virtual void add_fields(psim::State &state) override {
+    state.add(&_x);
+    state.add(&_y);
+  }
+
+  virtual void step() override {
+    this->psim::Model::step();
+    _x.get() += 1;
+  }
+};
+
+/* Accumulates the lazy fields of two counters.
+ */
+class Adder : public psim::Model {
+ private:
+  psim::StateFieldValued<psim::Integer> _sum;
+  psim::StateField<psim::Integer> const *_a;
+  psim::StateField<psim::Integer> const *_b;
+
+ public:
+  Adder(psim::RandomsGenerator &randoms, psim::Configuration const &config)
+    : Model(randoms), _sum("sum", 0) {}
+
+  virtual void add_fields(psim::State &state) override {
+    state.add(&_sum);
+  }
+
+  virtual void get_fields(psim::State &state) override {
+    _a = get_field<psim::Integer>(state, "a.y");
+    _b = get_field<psim::Integer>(state, "b.y");
+  }
+
+  virtual void step() override {
+    this->psim::Model::step();
+    _sum.get() += _a->get() + _b->get();
+  }
+};
+
+class Counters : public psim::ModelList {
+ public:
+  Counters(psim::RandomsGenerator &randoms, psim::Configuration const &config)
+    : ModelList(randoms) {
+    add<Ticker>(randoms, config, "a", 1);
+    add<Ticker>(randoms, config, "b", 2);
+    add<Adder>(randoms, config);
+    add<Ticker>(randoms, config, "c", 3);
+  }
+};
+
+class StaticCounters
+  : public psim::StaticModelList<Ticker, Ticker, Adder, Ticker> {
+ public:
+  StaticCounters(
+      psim::RandomsGenerator &randoms, psim::Configuration const &config)
+    : StaticModelList(randoms,
+          std::forward_as_tuple(randoms, config, "a", 1),
+          std::forward_as_tuple(randoms, config, "b", 2),
+          std::forward_as_tuple(randoms, config),
+          std::forward_as_tuple(randoms, config, "c", 3)) {}
+};
+
+class ScheduledCounters : public Counters {
+ public:
+  ScheduledCounters(
+      psim::RandomsGenerator &randoms, psim::Configuration const &config)
+    : Counters(randoms, config) {
+    models()[1]->schedule(3, 2);
+  }
+};
+
+class StaticScheduledCounters : public StaticCounters {
+ public:
+  StaticScheduledCounters(
+      psim::RandomsGenerator &randoms, psim::Configuration const &config)
+    : StaticCounters(randoms, config) {
+    get<1>().schedule(3, 2);
+  }
+};
+
+class Nested : public psim::StaticModelList<Counters> {
+ public:
+  Nested(psim::RandomsGenerator &randoms, psim::Configuration const &config)
+    : StaticModelList(randoms, std::forward_as_tuple(randoms, config)) {}
+};
+
+psim::Configuration config() {
+  return psim::Configuration("test/psim/core/model_list_test_config.txt");
+}
+
+void expect_same(psim::State const &a, psim::State const &b) {
+  for (auto const &name : {"a.x", "b.y", "sum", "c.y"})
+    ASSERT_EQ(a[name].get<psim::Integer>(), b[name].get<psim::Integer>());
+}
+} // namespace
+
+TEST(StaticModelList, TestStep) {
+  auto const base = config();
+  psim::Simulation<Counters> dynamic(base);
+  psim::Simulation<StaticCounters> sim(base);
+
+  // Models are held by value and stepped in order
+  auto const &model = sim.model();
+  ASSERT_EQ(model.models().size(), 4);
+  ASSERT_EQ(model.models()[1], &model.get<1>());
+  ASSERT_EQ(model.graph().size(), 4);
+  ASSERT_TRUE(model.graph().precedes(1, 2));
+
+  dynamic.step(100);
+  sim.step(100);
+  expect_same(dynamic, sim);
+  ASSERT_EQ(sim["sum"].get<psim::Integer>(), 2 * 5050 + 300);
+
+  // Checkpoints are interchangeable with the equivalent model list
+  ASSERT_NO_THROW(sim.restore(dynamic.checkpoint()));
+  ASSERT_NO_THROW(dynamic.restore(sim.checkpoint()));
+}
+
+TEST(StaticModelList, TestParallelStep) {
+  auto const parallel_config = psim::Configuration(std::vector<std::string>{
+      "test/psim/core/model_list_test_config.txt",
+      "test/psim/core/model_list_test_threads_config.txt"});
+  psim::Simulation<StaticCounters> serial(config());
+  psim::Simulation<StaticCounters> parallel(parallel_config);
+
+  serial.step(100);
+  parallel.step(100);
+  expect_same(serial, parallel);
+}
+
+TEST(StaticModelList, TestPrune) {
+  auto const base = config();
+  psim::Simulation<StaticCounters> full(base);
+  psim::Simulation<StaticCounters> sim(base, {"sum"});
+
+  // Pruned models are never stepped
+  ASSERT_EQ(sim.model().models().size(), 3);
+  ASSERT_FALSE(sim.has("c.x"));
+  full.step(100);
+  sim.step(100);
+  ASSERT_EQ(sim["sum"].get<psim::Integer>(), full["sum"].get<psim::Integer>());
+}
+
+TEST(StaticModelList, TestNested) {
+  auto const base = config();
+  psim::Simulation<Counters> dynamic(base);
+  psim::Simulation<Nested> sim(base);
+
+  dynamic.step(100);
+  sim.step(100);
+  expect_same(dynamic, sim);
+}
+
+TEST(StaticModelList, TestSchedule) {
+  auto const base = config();
+  psim::Simulation<ScheduledCounters> dynamic(base);
+  psim::Simulation<StaticScheduledCounters> sim(base);
+
+  dynamic.step(100);
+  sim.step(100);
+  expect_same(dynamic, sim);
+  ASSERT_EQ(sim["a.x"].get<psim::Integer>(), 100);
+  ASSERT_EQ(sim["b.x"].get<psim::Integer>(), 33);
+}
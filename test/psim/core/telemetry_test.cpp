@@ -0,0 +1,149 @@
+/** @file test/psim/core/telemetry_test.cpp
+ *  @author Kyle Krol
+ */
+
+#include "counter.hpp"
+
+#include <gtest/gtest.h>
+
+#include <psim/core/configuration.hpp>
+#include <psim/core/simulation.hpp>
+#include <psim/core/state.hpp>
+#include <psim/core/state_field_valued.hpp>
+#include <psim/core/telemetry.hpp>
+#include <psim/core/types.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST(Telemetry, TestColumns) {
+  psim::StateFieldValued<psim::Boolean> field0("field0", true);
+  psim::StateFieldValued<psim::Integer> field1("field1", 0);
+  psim::StateFieldValued<psim::Vector3> field2("field2", {1.0, 2.0, 3.0});
+
+  psim::State state;
+  state.add(&field0);
+  state.add(&field1);
+  state.add(&field2);
+
+  std::string const file = "telemetry_test_columns.bin";
+  {
+    psim::TelemetryWriter writer(
+        state, file, {"field0", "field1", "field2"}, 1, 3);
+    ASSERT_EQ(writer.columns().size(), 5);
+
+    for (psim::Integer i = 0; i < 7; i++) {
+      field1.get() = i;
+      field2.get()(2) = 3.0 + i;
+      writer.record();
+    }
+    ASSERT_EQ(writer.size(), 7);
+  }
+
+  {
+    psim::TelemetryReader reader(file);
+    ASSERT_EQ(reader.size(), 7);
+    ASSERT_EQ(reader.columns().size(), 5);
+    ASSERT_TRUE(reader.has("field2.z"));
+    ASSERT_FALSE(reader.has("field2"));
+    ASSERT_TRUE(reader.is_integer("field1"));
+    ASSERT_FALSE(reader.is_integer("field0"));
+
+    // Seven samples in chunks of three
+    ASSERT_EQ(reader.chunks(), 3);
+    ASSERT_EQ(reader.chunk_size(0), 3);
+    ASSERT_EQ(reader.chunk_size(2), 1);
+    ASSERT_EQ(reader.integers("field1", 1)[2], 5);
+    ASSERT_EQ(reader.reals("field2.z", 2)[0], 9.0);
+    ASSERT_EQ(reader.reals("field0", 0)[1], 1.0);
+
+    std::vector<psim::Integer> n(reader.size());
+    std::vector<psim::Real> z(reader.size());
+    reader.read("field1", n.data());
+    reader.read("field2.z", z.data());
+    for (std::size_t i = 0; i < reader.size(); i++) {
+      ASSERT_EQ(n[i], i);
+      ASSERT_EQ(z[i], 3.0 + i);
+    }
+
+    EXPECT_THROW(reader.reals("field1", 0), std::runtime_error);
+    EXPECT_THROW(reader.integers("field0", 0), std::runtime_error);
+    EXPECT_THROW(reader.reals("field0", 3), std::runtime_error);
+    EXPECT_THROW(reader.reals("field3", 0), std::runtime_error);
+  }
+  std::remove(file.c_str());
+
+  EXPECT_THROW(psim::TelemetryWriter(state, file, {"field0", "field0"}),
+      std::runtime_error);
+  EXPECT_THROW(psim::TelemetryWriter(state, file, {"field3"}),
+      std::runtime_error);
+  EXPECT_THROW(psim::TelemetryWriter(state, file, {"field0"}, 0),
+      std::runtime_error);
+  EXPECT_THROW(psim::TelemetryWriter(state, file, {"field0"}, 1, 0),
+      std::runtime_error);
+  EXPECT_THROW(psim::TelemetryReader("telemetry_test_missing.bin"),
+      std::runtime_error);
+  std::remove(file.c_str());
+}
+
+TEST(Telemetry, TestUnclosed) {
+  psim::StateFieldValued<psim::Real> field0("field0", 0.0);
+
+  psim::State state;
+  state.add(&field0);
+
+  std::string const file = "telemetry_test_unclosed.bin";
+  psim::TelemetryWriter writer(state, file, {"field0"}, 1, 2);
+  for (auto i = 0; i < 5; i++) {
+    field0.get() = i;
+    writer.record();
+  }
+
+  // Only complete chunks have been written so far
+  {
+    psim::TelemetryReader reader(file);
+    ASSERT_EQ(reader.size(), 4);
+    ASSERT_EQ(reader.chunks(), 2);
+    ASSERT_EQ(reader.reals("field0", 1)[1], 3.0);
+  }
+
+  // A truncated chunk is ignored
+  {
+    std::ofstream ofs(file, std::ios::binary | std::ios::app);
+    ofs.write("\x02\0\0\0\0\0\0\0", 8);
+  }
+  {
+    psim::TelemetryReader reader(file);
+    ASSERT_EQ(reader.size(), 4);
+  }
+
+  std::remove(file.c_str());
+}
+
+TEST(Telemetry, TestSimulation) {
+  auto const config =
+      psim::Configuration("test/psim/core/simulation_test_config.txt");
+  psim::Simulation<Counter> sim(config);
+
+  std::string const file = "telemetry_test_simulation.bin";
+  auto const log = sim.log(file, {"n"}, 2, 2);
+  for (auto i = 0; i < 7; i++)
+    sim.step();
+
+  // Samples are taken on the second, fourth, and sixth steps
+  sim.detach(log);
+  sim.step();
+  log->close();
+  ASSERT_EQ(log->size(), 3);
+  EXPECT_THROW(log->record(), std::runtime_error);
+
+  psim::TelemetryReader reader(file);
+  ASSERT_EQ(reader.size(), 3);
+  ASSERT_EQ(reader.chunks(), 2);
+  ASSERT_EQ(reader.integers("n", 0)[0], 2);
+  ASSERT_EQ(reader.integers("n", 1)[0], 6);
+  std::remove(file.c_str());
+}
@@ -0,0 +1,105 @@
+/** @file test/psim/core/thread_pool_test.cpp
+ *  @author Kyle Krol
+ */
+
+#include <gtest/gtest.h>
+
+#include <psim/core/thread_pool.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+struct Tally {
+  psim::ThreadPool *pool;
+  std::atomic<std::size_t> count;
+  std::atomic<std::size_t> spawn;
+};
+
+static void count(void *data) {
+  static_cast<Tally *>(data)->count++;
+}
+
+static void spawn(void *data) {
+  auto *tally = static_cast<Tally *>(data);
+  if (tally->spawn-- > 0)
+    tally->pool->submit({&spawn, data});
+  tally->count++;
+}
+
+TEST(ThreadPool, TestSubmit) {
+  psim::ThreadPool pool(3);
+  ASSERT_EQ(pool.size(), 3);
+
+  Tally tally;
+  tally.pool = &pool;
+  tally.count = 0;
+  tally.spawn = 0;
+
+  for (std::size_t i = 0; i < 1000; i++)
+    pool.submit({&count, &tally});
+
+  // The submitting thread helps until all tasks have run
+  while (tally.count < 1000)
+    if (!pool.help())
+      std::this_thread::yield();
+  ASSERT_EQ(tally.count, 1000);
+}
+
+TEST(ThreadPool, TestNestedSubmit) {
+  psim::ThreadPool pool(2);
+
+  Tally tally;
+  tally.pool = &pool;
+  tally.count = 0;
+  tally.spawn = 100;
+
+  // Tasks submitted from workers are also executed
+  pool.submit({&spawn, &tally});
+  while (tally.count < 101)
+    if (!pool.help())
+      std::this_thread::yield();
+  ASSERT_EQ(tally.count, 101);
+}
+
+TEST(ThreadPool, TestNoWorkers) {
+  psim::ThreadPool pool(0);
+
+  Tally tally;
+  tally.pool = &pool;
+  tally.count = 0;
+  tally.spawn = 0;
+
+  // Without workers, tasks only run when helped
+  pool.submit({&count, &tally});
+  ASSERT_EQ(tally.count, 0);
+  ASSERT_TRUE(pool.help());
+  ASSERT_FALSE(pool.help());
+  ASSERT_EQ(tally.count, 1);
+}
+
+TEST(ThreadPool, TestForEach) {
+  psim::ThreadPool pool(3);
+
+  // Every index is processed exactly once
+  std::vector<std::size_t> counts(1000, 0);
+  pool.for_each(counts.size(), [&](std::size_t i) { counts[i]++; });
+  for (auto const count : counts)
+    ASSERT_EQ(count, 1);
+
+  // The first exception is rethrown on the calling thread
+  ASSERT_THROW(pool.for_each(100,
+                   [](std::size_t i) {
+                     if (i == 50)
+                       throw std::runtime_error("");
+                   }),
+      std::runtime_error);
+
+  // Works without any workers
+  psim::ThreadPool serial(0);
+  std::size_t sum = 0;
+  serial.for_each(10, [&](std::size_t i) { sum += i; });
+  ASSERT_EQ(sum, 45);
+}
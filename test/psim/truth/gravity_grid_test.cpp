@@ -0,0 +1,148 @@
+/** @file test/psim/truth/gravity_grid_test.cpp
+ *  @author Kyle Krol
+ */
+
+#include <gtest/gtest.h>
+
+#include <psim/core/configuration.hpp>
+#include <psim/core/model.hpp>
+#include <psim/core/model_list.hpp>
+#include <psim/core/simulation.hpp>
+#include <psim/core/state.hpp>
+#include <psim/core/state_field_valued.hpp>
+#include <psim/core/types.hpp>
+#include <psim/truth/gravity_grid.hpp>
+#include <psim/truth/orbit.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+namespace {
+
+/* Provides the Earth and timestep fields read by the orbit propagator.
+ */
+class EarthFields : public psim::Model {
+ private:
+  psim::StateFieldValued<psim::Vector3> _w, _w_dot;
+  psim::StateFieldValued<psim::Real> _dt;
+
+ public:
+  EarthFields(psim::RandomsGenerator &randoms,
+      psim::Configuration const &config)
+    : Model(randoms),
+      _w("truth.earth.w", config["truth.earth.w"].get<psim::Vector3>()),
+      _w_dot("truth.earth.w_dot",
+          config["truth.earth.w_dot"].get<psim::Vector3>()),
+      _dt("truth.dt.s", config["truth.dt.s"].get<psim::Real>()) {}
+
+  virtual void add_fields(psim::State &state) override {
+    state.add(&_w);
+    state.add(&_w_dot);
+    state.add(&_dt);
+  }
+};
+
+class DirectGravity : public psim::ModelList {
+ public:
+  DirectGravity(psim::RandomsGenerator &randoms,
+      psim::Configuration const &config)
+    : ModelList(randoms) {
+    add<EarthFields>(randoms, config);
+    add<psim::OrbitEcef>(randoms, config, "leader");
+  }
+};
+
+/* Evaluates the spherical harmonic model directly through the orbit model's
+ * lazy fields.
+ */
+psim::Vector3 direct(psim::Vector3 const &r_ecef, psim::Real &U) {
+  auto config =
+      psim::Configuration("test/psim/truth/orbit_batch_test_config.txt");
+  config.set("truth.leader.orbit.r", r_ecef);
+  config.set("truth.leader.m", psim::Real(1.0));
+
+  psim::Simulation<DirectGravity> sim(config);
+  U = sim["truth.leader.orbit.U"].get<psim::Real>();
+  return sim["truth.leader.orbit.a_gravity"].get<psim::Vector3>();
+}
+
+psim::Vector3 position(psim::Real r, psim::Real t, psim::Real l) {
+  return {r * std::sin(t) * std::cos(l), r * std::sin(t) * std::sin(l),
+      r * std::cos(t)};
+}
+} // namespace
+
+TEST(GravityGrid, TestAccuracy) {
+  std::string const file = "gravity_grid_test.bin";
+  std::remove(file.c_str());
+
+  psim::GravityGrid const grid(file);
+  ASSERT_TRUE(grid.mapped());
+
+  // Sample the band including points over the poles
+  for (std::size_t i = 0; i < 50; i++) {
+    auto const r = 6.38e6 + 19.7e3 * i;
+    auto const t = 0.0637 * i;
+    auto const l = -3.1 + 0.1247 * i;
+    auto const r_ecef = position(r, t, l);
+    ASSERT_TRUE(grid.covers(r_ecef));
+
+    psim::Real U, U_direct;
+    auto const g = grid.gravity(r_ecef, U);
+    auto const g_direct = direct(r_ecef, U_direct);
+    for (lin::size_t j = 0; j < 3; j++)
+      EXPECT_NEAR(g(j), g_direct(j), 1.0e-6);
+    EXPECT_NEAR(U, U_direct, 0.5);
+  }
+
+  // Positions outside of the band are evaluated directly
+  auto const r_ecef = position(8.0e6, 1.0, 2.0);
+  ASSERT_FALSE(grid.covers(r_ecef));
+
+  psim::Real U, U_direct;
+  auto const g = grid.gravity(r_ecef, U);
+  auto const g_direct = direct(r_ecef, U_direct);
+  for (lin::size_t j = 0; j < 3; j++) ASSERT_EQ(g(j), g_direct(j));
+  ASSERT_EQ(U, U_direct);
+
+  std::remove(file.c_str());
+}
+
+TEST(GravityGrid, TestCache) {
+  std::string const file = "gravity_grid_test_cache.bin";
+  std::remove(file.c_str());
+
+  auto const r_ecef = position(6.9e6, 0.3, 0.4);
+  psim::Real U, U_cached;
+  psim::Vector3 g;
+  {
+    psim::GravityGrid const grid(file);
+    g = grid.gravity(r_ecef, U);
+  }
+
+  // The second grid maps the cache file written by the first
+  {
+    psim::GravityGrid const grid(file);
+    ASSERT_TRUE(grid.mapped());
+    auto const g_cached = grid.gravity(r_ecef, U_cached);
+    for (lin::size_t j = 0; j < 3; j++) ASSERT_EQ(g(j), g_cached(j));
+    ASSERT_EQ(U, U_cached);
+  }
+
+  // Files that don't hold a matching grid are rebuilt
+  {
+    std::ofstream ofs(file, std::ios::binary | std::ios::trunc);
+    ofs << "not a gravity grid";
+  }
+  {
+    psim::GravityGrid const grid(file);
+    ASSERT_TRUE(grid.mapped());
+    auto const g_rebuilt = grid.gravity(r_ecef, U_cached);
+    for (lin::size_t j = 0; j < 3; j++) ASSERT_EQ(g(j), g_rebuilt(j));
+    ASSERT_EQ(U, U_cached);
+  }
+
+  std::remove(file.c_str());
+}
@@ -0,0 +1,123 @@
+/** @file test/psim/truth/orbit_batch_test.cpp
+ *  @author Kyle Krol
+ */
+
+#include <gtest/gtest.h>
+
+#include <psim/core/configuration.hpp>
+#include <psim/core/model.hpp>
+#include <psim/core/model_list.hpp>
+#include <psim/core/simulation.hpp>
+#include <psim/core/state.hpp>
+#include <psim/core/state_field_valued.hpp>
+#include <psim/core/thread_pool.hpp>
+#include <psim/core/types.hpp>
+#include <psim/truth/orbit.hpp>
+#include <psim/truth/orbit_batch.hpp>
+
+#include <cstddef>
+
+/* Provides the Earth and timestep fields read by the orbit propagator.
+ */
+class Environment : public psim::Model {
+ private:
+  psim::StateFieldValued<psim::Vector3> _w, _w_dot;
+  psim::StateFieldValued<psim::Real> _dt;
+
+ public:
+  Environment(psim::RandomsGenerator &randoms,
+      psim::Configuration const &config)
+    : Model(randoms),
+      _w("truth.earth.w", config["truth.earth.w"].get<psim::Vector3>()),
+      _w_dot("truth.earth.w_dot",
+          config["truth.earth.w_dot"].get<psim::Vector3>()),
+      _dt("truth.dt.s", config["truth.dt.s"].get<psim::Real>()) {}
+
+  virtual void add_fields(psim::State &state) override {
+    state.add(&_w);
+    state.add(&_w_dot);
+    state.add(&_dt);
+  }
+};
+
+class Propagator : public psim::ModelList {
+ public:
+  Propagator(psim::RandomsGenerator &randoms,
+      psim::Configuration const &config)
+    : ModelList(randoms) {
+    add<Environment>(randoms, config);
+    add<psim::OrbitEcef>(randoms, config, "leader");
+  }
+};
+
+static psim::OrbitEcefBatch batch(
+    psim::Configuration const &config, std::size_t n) {
+  psim::OrbitEcefBatch orbits(n);
+  for (std::size_t i = 0; i < n; i++)
+    orbits.set(i, config["truth.leader.orbit.r"].get<psim::Vector3>(),
+        config["truth.leader.orbit.v"].get<psim::Vector3>(),
+        config["truth.leader.m"].get<psim::Real>(),
+        config["truth.leader.S"].get<psim::Real>());
+  return orbits;
+}
+
+TEST(OrbitEcefBatch, TestOrbitEcef) {
+  auto const config =
+      psim::Configuration("test/psim/truth/orbit_batch_test_config.txt");
+  auto const &w = config["truth.earth.w"].get<psim::Vector3>();
+  auto const &w_dot = config["truth.earth.w_dot"].get<psim::Vector3>();
+  auto const &dt = config["truth.dt.s"].get<psim::Real>();
+
+  psim::Simulation<Propagator> sim(config);
+  auto orbits = batch(config, 100);
+
+  psim::Vector3 const J = {0.0, 0.01, 0.0};
+  sim.get_writable("truth.leader.orbit.J.ecef")->get<psim::Vector3>() = J;
+  orbits.impulse(99, J);
+
+  for (std::size_t i = 0; i < 1000; i++) {
+    sim.step();
+    orbits.step(dt, w, w_dot);
+  }
+
+  // The batch follows the scalar propagator to within rounding
+  auto const &r = sim["truth.leader.orbit.r"].get<psim::Vector3>();
+  auto const &v = sim["truth.leader.orbit.v"].get<psim::Vector3>();
+  for (lin::size_t j = 0; j < 3; j++) {
+    EXPECT_NEAR(orbits.r(99)(j), r(j), 1.0e-3);
+    EXPECT_NEAR(orbits.v(99)(j), v(j), 1.0e-6);
+  }
+
+  // Satellites don't interact regardless of which chunk they land in
+  for (lin::size_t j = 0; j < 3; j++) {
+    ASSERT_EQ(orbits.r(0)(j), orbits.r(70)(j));
+    ASSERT_NE(orbits.r(0)(j), orbits.r(99)(j));
+  }
+}
+
+TEST(OrbitEcefBatch, TestParallel) {
+  auto const config =
+      psim::Configuration("test/psim/truth/orbit_batch_test_config.txt");
+  auto const &w = config["truth.earth.w"].get<psim::Vector3>();
+  auto const &w_dot = config["truth.earth.w_dot"].get<psim::Vector3>();
+  auto const &dt = config["truth.dt.s"].get<psim::Real>();
+
+  auto serial = batch(config, 300);
+  auto parallel = batch(config, 300);
+  for (std::size_t i = 0; i < 300; i++) {
+    serial.impulse(i, {0.0, 0.0, 0.001 * i});
+    parallel.impulse(i, {0.0, 0.0, 0.001 * i});
+  }
+
+  psim::ThreadPool pool(3);
+  parallel.parallelize(pool);
+
+  for (std::size_t i = 0; i < 100; i++) {
+    serial.step(dt, w, w_dot);
+    parallel.step(dt, w, w_dot);
+  }
+
+  for (std::size_t j = 0; j < 6; j++)
+    for (std::size_t i = 0; i < 300; i++)
+      ASSERT_EQ(serial.column(j)[i], parallel.column(j)[i]);
+}
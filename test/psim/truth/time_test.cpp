@@ -5,9 +5,33 @@
 #include <gtest/gtest.h>
 
 #include <psim/core/configuration.hpp>
+#include <psim/core/model_list.hpp>
 #include <psim/core/simulation.hpp>
 #include <psim/truth/time.hpp>
 
+namespace {
+
+class Clock : public psim::ModelList {
+ public:
+  Clock(psim::RandomsGenerator &randoms, psim::Configuration const &config)
+    : ModelList(randoms) {
+    add<psim::Time>(randoms, config);
+  }
+};
+
+/* Only steps the clock, and therefore time, on every third tick.
+ */
+class ScheduledClock : public psim::ModelList {
+ public:
+  ScheduledClock(psim::RandomsGenerator &randoms,
+      psim::Configuration const &config)
+    : ModelList(randoms) {
+    add<Clock>(randoms, config);
+    models()[0]->schedule(3);
+  }
+};
+} // namespace
+
 TEST(Time, TestStep) {
   auto const config = psim::Configuration("test/psim/truth/time_test_config.txt");
   psim::Simulation<psim::Time> sim(config);
@@ -30,3 +54,24 @@ TEST(Time, TestStep) {
   sim.step();
   ASSERT_EQ(sim["truth.t.ns"].get<psim::Integer>(), 14);
 }
+
+TEST(Time, TestScheduled) {
+  auto const config = psim::Configuration("test/psim/truth/time_test_config.txt");
+  psim::Simulation<ScheduledClock> sim(config);
+
+  // Time advances by three timesteps on the first of every three ticks
+  sim.step();
+  ASSERT_EQ(sim["truth.t.ns"].get<psim::Integer>(), 15);
+  sim.step(2);
+  ASSERT_EQ(sim["truth.t.ns"].get<psim::Integer>(), 15);
+  sim.step();
+  ASSERT_EQ(sim["truth.t.ns"].get<psim::Integer>(), 30);
+  ASSERT_DOUBLE_EQ(sim["truth.t.s"].get<psim::Real>(), 3e-8);
+
+  // Time agrees with an unscheduled clock on the ticks it steps on
+  psim::Simulation<psim::Time> reference(config);
+  sim.step(5);
+  reference.step(9);
+  ASSERT_EQ(sim["truth.t.ns"].get<psim::Integer>(),
+      reference["truth.t.ns"].get<psim::Integer>());
+}
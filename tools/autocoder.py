@@ -66,36 +66,21 @@ class Commented(object):
         return bool(self._comment)
 
 
-class Variable(Commented):
-    """Represents a class member variable in a model. Primarily, this gives
-    information about the underlying type of a parameter or state field.
+class Named(Commented):
+    """Represents a named class member in a model whose name may depend on the
+    model's arguments.
     """
-    def __init__(self, name=None, type=None, **kwargs):
-        super(Variable, self).__init__(**kwargs)
+    def __init__(self, name=None, **kwargs):
+        super(Named, self).__init__(**kwargs)
 
         self._name = name
         if not self._name or not _re_variable.match(self._name):
             raise RuntimeError('Name not provide or has invalid format: ' + str(self._name))
 
-        self._type = type
-        if not self._type and not _re_type.match(self._type):
-            raise RuntimeError('Type not provided or has invalid format: ' + str(self._type))
-
         # Private member for properties
         self.__member_name = None
         self.__string_name = None
 
-        # Underlying type
-        underlying_type_matches = 0
-        self.__underlying_type = None
-        for underlying_type in ['Boolean', 'Integer', 'Real', 'Vector2', 'Vector3', 'Vector4']:
-            if underlying_type in self._type:
-                underlying_type_matches = underlying_type_matches + 1
-                self.__underlying_type = underlying_type
-
-        if underlying_type_matches != 1:
-            raise RuntimeError('Multiple or no underlying types specified: ' + str(self._type))
-
     @property
     def member_name(self):
         if not self.__member_name:
@@ -117,6 +102,29 @@ class Variable(Commented):
 
         return self.__string_name
 
+
+class Variable(Named):
+    """Represents a class member variable in a model. Primarily, this gives
+    information about the underlying type of a parameter or state field.
+    """
+    def __init__(self, type=None, **kwargs):
+        super(Variable, self).__init__(**kwargs)
+
+        self._type = type
+        if not self._type and not _re_type.match(self._type):
+            raise RuntimeError('Type not provided or has invalid format: ' + str(self._type))
+
+        # Underlying type
+        underlying_type_matches = 0
+        self.__underlying_type = None
+        for underlying_type in ['Boolean', 'Integer', 'Real', 'Vector2', 'Vector3', 'Vector4']:
+            if underlying_type in self._type:
+                underlying_type_matches = underlying_type_matches + 1
+                self.__underlying_type = underlying_type
+
+        if underlying_type_matches != 1:
+            raise RuntimeError('Multiple or no underlying types specified: ' + str(self._type))
+
     @property
     def underlying_type(self):
         return self.__underlying_type
@@ -142,10 +150,53 @@ class Parameter(Variable):
     @property
     def declaration(self):
         if not self.__declaration:
-            self.__declaration = 'Parameter<' + self.underlying_type + '> const ' + self.member_name + ';'
+            self.__declaration = 'Parameter<' + self.underlying_type + '> ' + self.member_name + ';'
+
+        return self.__declaration
+
+    @property
+    def configure_expression(self):
+        return self.member_name + '.get() = config[' + self.string_name + '].template get<' + self.underlying_type + '>();'
+
+
+class RandomStream(Named):
+    """Represents a stream of random numbers owned by a model.
+    """
+    def __init__(self, model, **kwargs):
+        super(RandomStream, self).__init__(**kwargs)
+
+        self._model = model
+
+        # Private member for properties
+        self.__constructor = None
+        self.__declaration = None
+
+    @property
+    def constructor(self):
+        if not self.__constructor:
+            self.__constructor = self.member_name + '(config["seed"].template get<Integer>(), "' + self._model + '", ' + self.string_name + ', &this->_epoch)'
+
+        return self.__constructor
+
+    @property
+    def declaration(self):
+        if not self.__declaration:
+            self.__declaration = 'RandomStream mutable ' + self.member_name + ';'
 
         return self.__declaration
 
+    @property
+    def checkpoint_expression(self):
+        return self.member_name + '.checkpoint(checkpoint, ' + self.string_name + ');'
+
+    @property
+    def restore_expression(self):
+        return self.member_name + '.restore(reader, ' + self.string_name + ');'
+
+    @property
+    def configure_expression(self):
+        return self.member_name + '.reseed(config["seed"].template get<Integer>(), "' + self._model + '", ' + self.string_name + ');'
+
 
 class StateField(Variable):
     """Represents a state field.
@@ -173,8 +224,10 @@ class AddsStateField(StateField):
         self.__adds_expression = None
         self.__constructor = None
         self.__declaration = None
+        self.__evaluator = None
         self.__is_initialized = 'Initialized' in self._type_modifiers
         self.__is_lazy = 'Lazy' in self._type_modifiers
+        self.__is_memoized = 'Memoized' in self._type_modifiers
         self.__is_writable = 'Writable' in self._type_modifiers
 
         _type_modifiers = set(self._type_modifiers)
@@ -184,6 +237,8 @@ class AddsStateField(StateField):
             _type_modifiers.remove('Initialized')
         if self.is_lazy:
             _type_modifiers.remove('Lazy')
+        if self.is_memoized:
+            _type_modifiers.remove('Memoized')
         if self.is_writable:
             _type_modifiers.remove('Writable')
 
@@ -193,6 +248,9 @@ class AddsStateField(StateField):
         if self.is_lazy and (self.is_initialized or self.is_writable):
             raise RuntimeError('A lazy field cannot be initialized or writable: ' + str(self._type))
 
+        if self.is_memoized and not self.is_lazy:
+            raise RuntimeError('Only lazy fields can be memoized: ' + str(self._type))
+
     @property
     def adds_expression(self):
         if not self.__adds_expression:
@@ -207,7 +265,7 @@ class AddsStateField(StateField):
     def constructor(self):
         if not self.__constructor:
             if self.is_lazy:
-                self.__constructor = self.member_name + '(' + self.string_name + ', std::bind(&D::' + self.member_name + ', &derived()))'
+                self.__constructor = self.member_name + '(' + self.string_name + ', derived(), this->_epoch' + (', true)' if self.is_memoized else ')')
             else:
                 if self.is_initialized:
                     self.__constructor = self.member_name + '(' + self.string_name + ', config[' + self.string_name + '].template get<' + self.underlying_type + '>())'
@@ -220,12 +278,49 @@ class AddsStateField(StateField):
     def declaration(self):
         if not self.__declaration:
             if self.__is_lazy:
-                self.__declaration = 'StateFieldLazy<' + self.underlying_type + '> ' + self.member_name + ';'
+                self.__declaration = 'StateFieldLazyMember<' + self.underlying_type + ', D, ' + self.evaluator_name + '> ' + self.member_name + ';'
             else:
                 self.__declaration = 'StateFieldValued<' + self.underlying_type + '> ' + self.member_name + ';'
 
         return self.__declaration
 
+    @property
+    def evaluator(self):
+        if not self.__evaluator:
+            self.__evaluator = \
+            'struct ' + self.evaluator_name + ' {\n' + \
+            '  ' + self.underlying_type + ' operator()(D const &model) const {\n' + \
+            '    return model.' + self.member_name + '();\n' + \
+            '  }\n' + \
+            '};\n'
+
+        return self.__evaluator
+
+    @property
+    def checkpoint_expression(self):
+        if self.is_lazy:
+            return None
+
+        return 'checkpoint.write(' + self.member_name + '.name(), ' + self.member_name + '.get());'
+
+    @property
+    def restore_expression(self):
+        if self.is_lazy:
+            return self.member_name + '.reset();'
+
+        return 'reader.read(' + self.member_name + '.name(), ' + self.member_name + '.get());'
+
+    @property
+    def configure_expression(self):
+        if not self.is_initialized:
+            return None
+
+        return self.member_name + '.get() = config[' + self.string_name + '].template get<' + self.underlying_type + '>();'
+
+    @property
+    def evaluator_name(self):
+        return self.member_name + '_evaluator'
+
     @property
     def is_initialized(self):
         return self.__is_initialized
@@ -234,6 +329,10 @@ class AddsStateField(StateField):
     def is_lazy(self):
         return self.__is_lazy
 
+    @property
+    def is_memoized(self):
+        return self.__is_memoized
+
 
 class GetsStateField(StateField):
     """Represents a state field retrieved from the simulation by the model.
@@ -286,7 +385,7 @@ class GetsStateField(StateField):
 class Model(Commented):
     """Represents a model.
     """
-    def __init__(self, name=None, type=None, args=[], params=[], adds=[], gets=[], **kwargs):
+    def __init__(self, name=None, type=None, args=[], params=[], randoms=[], adds=[], gets=[], **kwargs):
         super(Model, self).__init__(**kwargs)
 
         self._name = name
@@ -299,6 +398,7 @@ class Model(Commented):
 
         self._args = [Argument(arg) for arg in args]
         self._params = [Parameter(**param) for param in params]
+        self._randoms = [RandomStream(self._name, **random) for random in randoms]
         self._adds = [AddsStateField(**add) for add in adds]
         self._gets = [GetsStateField(**get) for get in gets]
 
@@ -316,16 +416,16 @@ class Model(Commented):
             '#ifndef PSIM_AUTOCODED_{}_HPP_\n'.format(self._name.upper()) + \
             '#define PSIM_AUTOCODED_{}_HPP_\n'.format(self._name.upper()) + \
             '\n' + \
+            '#include <psim/core/checkpoint.hpp>\n' + \
             '#include <psim/core/configuration.hpp>\n' + \
             '#include <psim/core/model.hpp>\n' + \
             '#include <psim/core/parameter.hpp>\n' + \
+            '#include <psim/core/random_stream.hpp>\n' + \
             '#include <psim/core/state.hpp>\n' + \
-            '#include <psim/core/state_field_lazy.hpp>\n' + \
+            '#include <psim/core/state_field_lazy_member.hpp>\n' + \
             '#include <psim/core/state_field_valued.hpp>\n' + \
             '#include <psim/core/types.hpp>\n' + \
             '\n' + \
-            '#include <functional>\n' + \
-            '\n' + \
             'namespace psim {\n' + \
             '\n' +\
             'template <class D>\n' + \
@@ -345,7 +445,16 @@ class Model(Commented):
             '  D &derived() {\n' + \
             '    return static_cast<D &>(*this);\n' + \
             '  }\n' + \
-            '\n' + \
+            '\n'
+
+            # Evaluators for all lazy fields
+            for add in self._adds:
+                if add.is_lazy:
+                    for line in add.evaluator.splitlines():
+                        self.__code += '  ' + line + '\n'
+                    self.__code += '\n'
+
+            self.__code += \
             ' protected:\n'
 
             # Member variables for all parameters
@@ -354,6 +463,12 @@ class Model(Commented):
                     self.__code += '  ' + param.declaration + '\n'
                 self.__code += '\n'
 
+            # Member variables for random streams
+            if len(self._randoms) > 0:
+                for random in self._randoms:
+                    self.__code += '  ' + random.declaration + '\n'
+                self.__code += '\n'
+
             # Member variables for adds fields
             if len(self._adds) > 0:
                 for add in self._adds:
@@ -382,7 +497,7 @@ class Model(Commented):
             '  : {}(randoms)'.format(self._type)
 
             # Construct member varaibles
-            for member in itertools.chain(self._args, self._params, self._adds, self._gets):
+            for member in itertools.chain(self._args, self._params, self._randoms, self._adds, self._gets):
                 self.__code += ',\n    ' + member.constructor
 
             self.__code += '\n' + \
@@ -409,15 +524,55 @@ class Model(Commented):
 
             self.__code += \
             '  }\n' + \
-            '\n' + \
+            '\n'
+
+            # Label instances by their arguments, for example the satellite
+            if len(self._args) > 0:
+                self.__code += \
+                '  virtual std::string label() const override {\n' + \
+                '    return ' + ' + ", " + '.join(arg.member_name for arg in self._args) + ';\n' + \
+                '  }\n' + \
+                '\n'
+
+            # Lazy fields are tied to the model's step epoch and are therefore
+            # invalidated by the base class's step implementation.
+            self.__code += \
             '  virtual void step() override {\n' + \
             '    this->{}::step();\n'.format(self._type) + \
+            '  }\n' + \
+            '\n' + \
+            '  virtual void checkpoint(Checkpoint &checkpoint) const override {\n' + \
+            '    this->{}::checkpoint(checkpoint);\n'.format(self._type) + \
             '\n'
 
-            # Reset all lazy fields
-            for add in self._adds:
-                if add.is_lazy:
-                    self.__code += '    ' + add.member_name + '.reset();\n'
+            # Write random stream positions and field values
+            for member in itertools.chain(self._randoms, self._adds):
+                if member.checkpoint_expression:
+                    self.__code += '    ' + member.checkpoint_expression + '\n'
+
+            # Lazy fields are reset as the restored epoch may coincide with the
+            # epoch their currently held value was evaluated in.
+            self.__code += \
+            '  }\n' + \
+            '\n' + \
+            '  virtual void restore(Checkpoint::Reader &reader) override {\n' + \
+            '    this->{}::restore(reader);\n'.format(self._type) + \
+            '\n'
+
+            for member in itertools.chain(self._randoms, self._adds):
+                self.__code += '    ' + member.restore_expression + '\n'
+
+            # Reread parameters, random stream seeds, and initial conditions
+            self.__code += \
+            '  }\n' + \
+            '\n' + \
+            '  virtual void configure(Configuration const &config) override {\n' + \
+            '    this->{}::configure(config);\n'.format(self._type) + \
+            '\n'
+
+            for member in itertools.chain(self._params, self._randoms, self._adds):
+                if member.configure_expression:
+                    self.__code += '    ' + member.configure_expression + '\n'
 
             self.__code += \
             '  }\n' + \